@@ -9,6 +9,24 @@
 #import <XCTest/XCTest.h>
 #include "TestUtils.hpp"
 #include "Approximation/ChebyshevApproximator.hpp"
+#include "Functions/TypedFunction.hpp"
+
+//sin(2*x-y/2)+y, for any type the functions are defined for, with it's own grid evaluation.
+struct TypedTestFunction {
+    template<typename T>
+    T operator()(const T& x, const T& y) const {
+        return sin(2*x-y/2)+y;
+    }
+
+    void evaluateGrid(const std::vector<std::vector<double> >& _grid, std::vector<double>& _results) const {
+        const size_t gridSize = _grid[0].size();
+        for(size_t j = 0; j < gridSize; j++) {
+            for(size_t i = 0; i < gridSize; i++) {
+                _results[j * gridSize + i] = sin(2*_grid[0][i]-_grid[1][j]/2)+_grid[1][j];
+            }
+        }
+    }
+};
 
 @interface TestChebyshevApproximator : XCTestCase
 
@@ -102,7 +120,103 @@
     double* approximation = chebApproximation.getArray();
     XCTAssert(withinEpslion(approximation[0], -1.5934465031264855));
 }
+
+- (void)testChebyshevModel {
+    std::vector<std::string> variablesNames;
+    variablesNames.push_back("x");
+    variablesNames.push_back("y");
+    std::vector<std::string> functionStrings;
+    functionStrings.push_back("sin(2*x-y/2)+y");
+    functionStrings.push_back("exp(x*y)/(2+cos(y))-x^3*y");
+    functionStrings.push_back("log(3+x)*sqrt(2+y)-tan(x/2)");
+    functionStrings.push_back("(1+x^2)^(y/3)+T3(x)*T2(y)");
+    size_t approximationDegree = 10;
+
+    Interval currentInterval;
+    currentInterval.lowerBounds.push_back(-1.0); currentInterval.lowerBounds.push_back(-1.0);
+    currentInterval.upperBounds.push_back(-.5); currentInterval.upperBounds.push_back(-.5);
+
+    //The model is within its remainder of the function everywhere on the interval, and the remainder is small.
+    ChebyshevModelBuilder modelBuilder(2);
+    ChebyshevModel model;
+    std::vector<double> unitPoint(2);
+    std::vector<double> point(2);
+    for(const std::string& functionString : functionStrings) {
+        Function::SharedFunctionPtr function = std::make_shared<Function>("", functionString, variablesNames);
+        XCTAssert(modelBuilder.build(function, currentInterval, approximationDegree, model));
+        XCTAssert(model.getRemainder() < 1e-6);
+        for(size_t i = 0; i <= 10; i++) {
+            for(size_t j = 0; j <= 10; j++) {
+                unitPoint[0] = i / 5.0 - 1;
+                unitPoint[1] = j / 5.0 - 1;
+                for(size_t dim = 0; dim < 2; dim++) {
+                    point[dim] = ((currentInterval.upperBounds[dim] - currentInterval.lowerBounds[dim]) * unitPoint[dim] + currentInterval.upperBounds[dim] + currentInterval.lowerBounds[dim]) / 2;
+                }
+                XCTAssert(std::abs(model.evaluate(unitPoint) - function->evaluate<double>(point)) <= model.getRemainder() + 1e-14);
+            }
+        }
+    }
+
+    //The log of something that reaches 0 can't be modeled
+    Function::SharedFunctionPtr badFunction = std::make_shared<Function>("", "log(x+1)", variablesNames);
+    XCTAssertFalse(modelBuilder.build(badFunction, currentInterval, approximationDegree, model));
+
+    //The approximation from the model matches the sampled one
+    Function::SharedFunctionPtr function = std::make_shared<Function>("", functionStrings[0], variablesNames);
+    ChebyshevApproximation<2> chebApproximation(2);
+    ChebyshevApproximator<2> chebyshevApproximator(2, approximationDegree, chebApproximation, 0, true);
+    chebyshevApproximator.approximate(function, currentInterval, approximationDegree);
+    XCTAssert(withinEpslion(chebApproximation.getArray()[0], -1.5934465031264855));
+    XCTAssertTrue(chebApproximation.isGoodApproximation(1e-10, 1e-10));
+}
     
+- (void)testTypedFunction {
+    std::vector<std::string> variablesNames;
+    variablesNames.push_back("x");
+    variablesNames.push_back("y");
+    size_t approximationDegree = 10;
+    Interval currentInterval;
+    currentInterval.lowerBounds.push_back(-1.0); currentInterval.lowerBounds.push_back(-1.0);
+    currentInterval.upperBounds.push_back(-.5); currentInterval.upperBounds.push_back(-.5);
+
+    Function::SharedFunctionPtr function = std::make_shared<Function>("", "sin(2*x-y/2)+y", variablesNames);
+    ChebyshevApproximation<2> chebApproximation(2);
+    ChebyshevApproximator<2> chebyshevApproximator(2, approximationDegree, chebApproximation, 0, false, true);
+    chebyshevApproximator.approximate(function, currentInterval, approximationDegree);
+    const double absApproxTol = chebyshevApproximator.getAbsApproxTol(function, currentInterval);
+    const size_t arrayLength = power(2*approximationDegree, 2);
+    std::vector<double> correct(chebApproximation.getArray(), chebApproximation.getArray() + arrayLength);
+
+    //A lambda and a functor with it's own grid evaluation give the same approximation as the parsed function
+    auto lambdaFunction = makeTypedFunction<2>([](double x, double y) {return sin(2*x-y/2)+y;});
+    auto functorFunction = makeTypedFunction<2>(TypedTestFunction());
+    ChebyshevApproximation<2> typedApproximation(2);
+    ChebyshevApproximator<2> typedApproximator(2, approximationDegree, typedApproximation, 0, false, true);
+
+    typedApproximator.approximate(lambdaFunction, currentInterval, approximationDegree);
+    for(size_t i = 0; i < arrayLength; i++) {
+        XCTAssert(std::abs(typedApproximation.getArray()[i] - correct[i]) < 1e-14);
+    }
+    XCTAssert(typedApproximation.isGoodApproximation(1e-10, 1e-10));
+    //The lambda only takes doubles, so only the rounding of the result is counted.
+    XCTAssert(typedApproximator.getAbsApproxTol(lambdaFunction, currentInterval) > 0);
+
+    typedApproximator.approximate(functorFunction, currentInterval, approximationDegree);
+    for(size_t i = 0; i < arrayLength; i++) {
+        XCTAssert(std::abs(typedApproximation.getArray()[i] - correct[i]) < 1e-14);
+    }
+    //The functor is evaluated with ErrorTrackers, so it's error is close to the parsed function's.
+    const double typedAbsApproxTol = typedApproximator.getAbsApproxTol(functorFunction, currentInterval);
+    XCTAssert(typedAbsApproxTol > absApproxTol / 10 && typedAbsApproxTol < absApproxTol * 10);
+
+    //Evaluating at a point
+    std::vector<double> point(2, -0.7);
+    XCTAssert(withinEpslion(functorFunction->evaluate<double>(point), function->evaluate<double>(point)));
+    ErrorTracker errorResult = functorFunction->evaluate<ErrorTracker>(point);
+    XCTAssert(withinEpslion(errorResult.value, function->evaluate<double>(point)));
+    XCTAssert(errorResult.error == function->evaluate<ErrorTracker>(point).error);
+}
+
 - (void)testTimingTemp {
     size_t rank = 2;
     size_t approximationDegree = 5;    
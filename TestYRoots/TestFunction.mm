@@ -10,6 +10,8 @@
 #include "TestUtils.hpp"
 #include "Functions/Function.hpp"
 #include "Utilities/ErrorTracker.hpp"
+#include "Utilities/RoundedInterval.hpp"
+#include "Utilities/DualNumber.hpp"
 
 @interface TestFunction : XCTestCase
 
@@ -128,6 +130,121 @@
     XCTAssert(withinEpslion(result, 73411));
 }
 
+- (void)testChebyshevBasis {
+    std::vector<std::string> variableNames;
+    variableNames.push_back("x");
+    variableNames.push_back("y");
+    std::vector<double> inputPoints;
+    inputPoints.push_back(0.3);
+    inputPoints.push_back(-0.7);
+
+    //Products and sums of T's of variables become Chebyshev basis types
+    Function tempFunction1("", "T3(x)*T2(y)", variableNames);
+    XCTAssert(tempFunction1.getFunctionType() == FunctionType::CHEBYSHEV_BASIS_MONOMIAL);
+    XCTAssert(withinEpslion(tempFunction1.evaluate<double>(inputPoints), chebPower(0.3, 3)*chebPower(-0.7, 2)));
+
+    Function tempFunction2("", "5-2*T4(x)*T1(y)+T2(x)*T2(x)+y", variableNames);
+    XCTAssert(tempFunction2.getFunctionType() == FunctionType::CHEBYSHEV_BASIS_POLYNOMIAL);
+    double correct = 5 - 2*chebPower(0.3, 4)*(-0.7) + chebPower(0.3, 2)*chebPower(0.3, 2) - 0.7;
+    XCTAssert(withinEpslion(tempFunction2.evaluate<double>(inputPoints), correct));
+    ErrorTracker errorResult = tempFunction2.evaluate<ErrorTracker>(inputPoints);
+    XCTAssert(withinEpslion(errorResult.value, correct));
+    XCTAssert(errorResult.error < 1e-14);
+
+    //A T of a constant is a constant
+    Function tempFunction3("", "2*T3(0.5)", variableNames);
+    XCTAssert(tempFunction3.getFunctionType() == FunctionType::CONSTANT);
+    XCTAssert(withinEpslion(tempFunction3.evaluate<double>(inputPoints), -2.0));
+}
+
+- (void)testPolynomialParsing {
+    std::vector<std::string> variableNames;
+    variableNames.push_back("x");
+    variableNames.push_back("y");
+    std::vector<double> inputPoints;
+    inputPoints.push_back(0.3);
+    inputPoints.push_back(-0.7);
+    const double x = 0.3;
+    const double y = -0.7;
+
+    auto polyChecker = [&](const std::string& functionString, FunctionType type, size_t numMonomials, double correct) {
+        Function tempFunction("", functionString, variableNames);
+        XCTAssert(tempFunction.getFunctionType() == type);
+        if(type == FunctionType::POWER_BASIS_POLYNOMIAL) {
+            XCTAssert(tempFunction.getPolynomial().getMonomials().size() == numMonomials);
+        }
+        double result = tempFunction.evaluate<double>(inputPoints);
+        if(!withinEpslion(result, correct)) {
+            std::cout<<"Fail: " << functionString << "\t" <<result << "\t" << correct << "\n";
+        }
+        XCTAssert(withinEpslion(result, correct));
+    };
+
+    //Polynomials in the variables are parsed straight into monomials
+    polyChecker("5+2*x-3*x^2*y", FunctionType::POWER_BASIS_POLYNOMIAL, 3, 5+2*x-3*x*x*y);
+    polyChecker("-x", FunctionType::POWER_BASIS_POLYNOMIAL, 1, -x);
+    polyChecker("x**2*y/4", FunctionType::POWER_BASIS_MONOMIAL, 1, x*x*y/4);
+    polyChecker("2*(x-1)*y+x*y", FunctionType::POWER_BASIS_POLYNOMIAL, 2, 2*(x-1)*y+x*y);
+    polyChecker("(((2*x+1)*x-3)*y+1)", FunctionType::POWER_BASIS_POLYNOMIAL, 4, ((2*x+1)*x-3)*y+1);
+    polyChecker("1.5e-3*x^0+pi*y-e", FunctionType::POWER_BASIS_POLYNOMIAL, 2, 1.5e-3+M_PI*y-M_E);
+    polyChecker("x-x+y", FunctionType::POWER_BASIS_POLYNOMIAL, 2, y);
+    //Anything else still goes through the full parser
+    polyChecker("x^2+sin(y)", FunctionType::SUM, 0, x*x+sin(y));
+    polyChecker("(x+1)^2.5*y", FunctionType::PRODUCT, 0, pow(x+1, 2.5)*y);
+    polyChecker("x/y+1", FunctionType::SUM, 0, x/y+1);
+
+    //A large polynomial matches evaluating it term by term
+    std::string functionString = "1";
+    double correct = 1;
+    for(size_t i = 1; i <= 200; i++) {
+        const size_t xPower = i % 7;
+        const size_t yPower = (3*i) % 5;
+        const double coeff = cos(i);
+        functionString += (coeff < 0 ? "-" : "+") + std::to_string(std::abs(coeff)) + "*x^" + std::to_string(xPower) + "*y^" + std::to_string(yPower);
+        correct += std::stod(std::to_string(coeff)) * power(x, xPower) * power(y, yPower);
+    }
+    Function bigFunction("", functionString, variableNames);
+    XCTAssert(bigFunction.getFunctionType() == FunctionType::POWER_BASIS_POLYNOMIAL);
+    XCTAssert(bigFunction.getPolynomial().getMonomials().size() == 35);
+    XCTAssert(withinEpslion(bigFunction.evaluate<double>(inputPoints), correct));
+}
+
+- (void)testPolynomialExpansion {
+    std::vector<std::string> variableNames;
+    variableNames.push_back("x");
+    variableNames.push_back("y");
+    std::vector<double> inputPoints;
+    inputPoints.push_back(0.3);
+    inputPoints.push_back(-0.7);
+    const double x = 0.3;
+    const double y = -0.7;
+
+    //Products and powers of polynomials are expanded
+    Function tempFunction1("", "(x+y)^3*(x-2*y)+x*y", variableNames);
+    XCTAssert(tempFunction1.getFunctionType() == FunctionType::POWER_BASIS_POLYNOMIAL);
+    XCTAssert(tempFunction1.getPolynomial().getMonomials().size() == 6);
+    XCTAssert(withinEpslion(tempFunction1.evaluate<double>(inputPoints), power(x+y, 3)*(x-2*y)+x*y));
+
+    Function tempFunction2("", "(2*x*y^2)^3", variableNames);
+    XCTAssert(tempFunction2.getFunctionType() == FunctionType::POWER_BASIS_MONOMIAL);
+    XCTAssert(withinEpslion(tempFunction2.evaluate<double>(inputPoints), 8*power(x, 3)*power(y, 6)));
+
+    //Too big to expand
+    Function tempFunction3("", "(x+y+1)^50", variableNames);
+    XCTAssert(tempFunction3.getFunctionType() == FunctionType::POWER);
+
+    //The polynomial parts of a sum or product are grouped together
+    Function tempFunction4("", "x^2-y+sin(x)-x*y", variableNames);
+    XCTAssert(tempFunction4.getFunctionType() == FunctionType::SUM);
+    XCTAssert(tempFunction4.getSubfunctions().size() == 2);
+    XCTAssert(withinEpslion(tempFunction4.evaluate<double>(inputPoints), x*x-y+sin(x)-x*y));
+
+    Function tempFunction5("", "(x+1)*cos(y)/x*(y-1)", variableNames);
+    XCTAssert(tempFunction5.getFunctionType() == FunctionType::PRODUCT);
+    XCTAssert(tempFunction5.getSubfunctions().size() == 3);
+    XCTAssert(withinEpslion(tempFunction5.evaluate<double>(inputPoints), (x+1)*cos(y)/x*(y-1)));
+}
+
 - (void)testEvalGrid2D{
     std::vector<std::string> variableNames;
     variableNames.push_back("x");
@@ -145,6 +262,9 @@
     functionStrings.push_back("x^1.3*cos(y^0.8)");
     functionStrings.push_back("cos(x*y)/sin(x-14.8*y+e)-log(14)+(1+x+2*y)^tan(2)");
     functionStrings.push_back("1+x^40+y^40");
+    functionStrings.push_back("T3(x)*T2(y)-2*T4(x)+T1(y)+0.5");
+    functionStrings.push_back("T5(x/30)*T7(y/30)");
+    functionStrings.push_back("T4(sin(x))+T3(x-y)");
 
     for(size_t functionNumber = 0; functionNumber < functionStrings.size(); functionNumber++) {
         const std::string functionString = functionStrings[functionNumber];
@@ -183,6 +303,248 @@
     }
 }
 
+- (void)testEvalGrid3D{
+    std::vector<std::string> variableNames;
+    variableNames.push_back("x");
+    variableNames.push_back("y");
+    variableNames.push_back("z");
+    
+    //Big grids are evaluated in tiles, so check functions that mix subfunctions using and not using the last dimension.
+    std::vector<std::string> functionStrings;
+    functionStrings.push_back("z");
+    functionStrings.push_back("x*y");
+    functionStrings.push_back("sin(x+y)*cos(z)-x");
+    functionStrings.push_back("exp(x/30)*(y-z)^2+sin(z/20)");
+    functionStrings.push_back("cos(x*y*z/1000)/(2+sin(y))-T3(z/70)");
+
+    std::vector<size_t> gridSizes = {1, 5, 17, 40, 65};
+
+    for(size_t functionNumber = 0; functionNumber < functionStrings.size(); functionNumber++) {
+        const std::string functionString = functionStrings[functionNumber];
+        std::cout<<"Testing Grid Eval on " << functionString << "\n";
+
+        Function tempFunction("", functionString, variableNames);
+        
+        size_t dimension = variableNames.size();
+        for(size_t numPoints : gridSizes) {
+            std::vector<std::vector<double> > grid;
+            grid.resize(dimension);
+            for(size_t i = 0; i < dimension; i++) {
+                for(size_t j = 0; j < numPoints; j++) {
+                    grid[i].push_back(j);
+                }
+            }
+            std::vector<double> results;
+            results.resize(power(numPoints, dimension));
+
+            tempFunction.evaluateGrid(grid, results);
+            
+            std::vector<double> evalPoints;
+            evalPoints.resize(3);
+            size_t resultSpot = 0;
+            for(size_t k = 0; k < numPoints; k++) {
+                for(size_t j = 0; j < numPoints; j++) {
+                    for(size_t i = 0; i < numPoints; i++) {
+                        evalPoints[0] = grid[0][i];
+                        evalPoints[1] = grid[1][j];
+                        evalPoints[2] = grid[2][k];
+                        double eval = tempFunction.evaluate<double>(evalPoints);
+                        XCTAssert(withinEpslion(eval, results[resultSpot++]));
+                    }
+                }
+            }
+        }
+    }
+}
+
+- (void)testEvaluateBatch{
+    std::vector<std::string> variableNames;
+    variableNames.push_back("x");
+    variableNames.push_back("y");
+    
+    std::vector<std::string> functionStrings;
+    functionStrings.push_back("y");
+    functionStrings.push_back("5");
+    functionStrings.push_back("x^2*y-3*x*y^4+1");
+    functionStrings.push_back("T2(x)*T3(y)-T1(y)");
+    functionStrings.push_back("sin(x+y)*cos(y)-x/(2+exp(y))");
+    functionStrings.push_back("cos(x*y)^sqrt(2+x)-log(3+y)*tanh(x)");
+    functionStrings.push_back("T4(sinh(x/2))-cosh(y)+log10(4+x)+log2(5-y)");
+
+    const size_t numPoints = 50;
+    std::vector<std::vector<double> > points(variableNames.size());
+    for(size_t i = 0; i < variableNames.size(); i++) {
+        for(size_t j = 0; j < numPoints; j++) {
+            points[i].push_back(cos(3.0*j + i)); //Scattered in [-1,1]
+        }
+    }
+    
+    for(size_t functionNumber = 0; functionNumber < functionStrings.size(); functionNumber++) {
+        Function tempFunction("", functionStrings[functionNumber], variableNames);
+        std::vector<double> results;
+        std::vector<ErrorTracker> errorResults;
+        tempFunction.evaluateBatch<double>(points, results);
+        tempFunction.evaluateBatch<ErrorTracker>(points, errorResults);
+        XCTAssert(results.size() == numPoints && errorResults.size() == numPoints);
+
+        //The batch does the same operations as evaluating each point.
+        std::vector<double> evalPoint(variableNames.size());
+        for(size_t j = 0; j < numPoints; j++) {
+            for(size_t i = 0; i < variableNames.size(); i++) {
+                evalPoint[i] = points[i][j];
+            }
+            XCTAssert(results[j] == tempFunction.evaluate<double>(evalPoint));
+            ErrorTracker errorResult = tempFunction.evaluate<ErrorTracker>(evalPoint);
+            XCTAssert(errorResults[j].value == errorResult.value);
+            XCTAssert(errorResults[j].error == errorResult.error);
+        }
+    }
+}
+
+- (void)testEvaluateGridWithErrors{
+    std::vector<std::string> variableNames;
+    variableNames.push_back("x");
+    variableNames.push_back("y");
+
+    std::vector<std::string> functionStrings;
+    functionStrings.push_back("y");
+    functionStrings.push_back("5");
+    functionStrings.push_back("x^2*y-3*x*y^4+1");
+    functionStrings.push_back("T2(x)*T3(y)-T1(y)");
+    functionStrings.push_back("sin(x+y)*cos(y)-x/(2+exp(y))");
+    functionStrings.push_back("cos(x*y)^sqrt(2+x)-log(3+y)*tanh(x)");
+    functionStrings.push_back("T4(sinh(x/2))-cosh(y)+log10(4+x)+log2(5-y)");
+
+    const size_t gridSize = 9;
+    std::vector<std::vector<double> > grid(variableNames.size());
+    for(size_t i = 0; i < variableNames.size(); i++) {
+        for(size_t j = 0; j < gridSize; j++) {
+            grid[i].push_back(cos(3.0*j + i)); //Scattered in [-1,1]
+        }
+    }
+
+    std::vector<double> evalPoint(variableNames.size());
+    for(size_t functionNumber = 0; functionNumber < functionStrings.size(); functionNumber++) {
+        Function tempFunction("", functionStrings[functionNumber], variableNames);
+        std::vector<double> results(gridSize * gridSize);
+        std::vector<double> gridResults(gridSize * gridSize);
+        std::vector<double> errors;
+        tempFunction.evaluateGrid(grid, results);
+        tempFunction.evaluateGridWithErrors(grid, gridResults, errors);
+        XCTAssert(errors.size() == gridSize * gridSize);
+
+        //The values match evaluate grid, and the errors are at least as big as evaluating each point with an ErrorTracker.
+        for(size_t j = 0; j < gridSize; j++) {
+            for(size_t i = 0; i < gridSize; i++) {
+                const size_t spot = j * gridSize + i;
+                evalPoint[0] = grid[0][i];
+                evalPoint[1] = grid[1][j];
+                const ErrorTracker errorResult = tempFunction.evaluate<ErrorTracker>(evalPoint);
+                XCTAssert(std::abs(gridResults[spot] - results[spot]) <= 1e-14 * std::max(1.0, std::abs(results[spot])));
+                XCTAssert(std::isfinite(errors[spot]));
+                XCTAssert(errors[spot] >= errorResult.error);
+                XCTAssert(errors[spot] < 1e-12);
+            }
+        }
+    }
+
+    //Dividing by something that might be 0 can't be bounded
+    grid[0][3] = 0;
+    Function divideFunction("", "1/x", variableNames);
+    std::vector<double> results(gridSize * gridSize);
+    std::vector<double> errors;
+    divideFunction.evaluateGridWithErrors(grid, results, errors);
+    XCTAssert(std::isinf(errors[3]));
+    XCTAssert(std::isfinite(errors[4]));
+}
+
+- (void)testRoundedInterval{
+    std::vector<std::string> variableNames;
+    variableNames.push_back("x");
+    variableNames.push_back("y");
+    
+    std::vector<std::string> functionStrings;
+    functionStrings.push_back("x^2*y-3*x*y^4+1");
+    functionStrings.push_back("T2(x)*T3(y)-T1(y)");
+    functionStrings.push_back("sin(5*x+y)*cos(y)-x/(2+exp(y))");
+    functionStrings.push_back("cos(x*y)^sqrt(2+x)-log(3+y)*tanh(x)");
+    functionStrings.push_back("T4(sinh(x/2))-cosh(y)+log10(4+x)+log2(5-y)");
+    functionStrings.push_back("tan(x)+x^8*y^7-2*x^3*y^2+5*x*y^6+y^9-x");
+
+    //Every value sampled in the box is in the enclosure.
+    std::vector<RoundedInterval> box;
+    box.push_back(RoundedInterval(-.7, .4));
+    box.push_back(RoundedInterval(-1, -.2));
+    std::vector<double> evalPoint(variableNames.size());
+    for(size_t functionNumber = 0; functionNumber < functionStrings.size(); functionNumber++) {
+        Function tempFunction("", functionStrings[functionNumber], variableNames);
+        const RoundedInterval enclosure = tempFunction.evaluate<RoundedInterval>(box);
+        XCTAssert(enclosure.width() < 100);
+        for(size_t i = 0; i <= 20; i++) {
+            for(size_t j = 0; j <= 20; j++) {
+                evalPoint[0] = box[0].lower + box[0].width() * i / 20;
+                evalPoint[1] = box[1].lower + box[1].width() * j / 20;
+                XCTAssert(enclosure.contains(tempFunction.evaluate<double>(evalPoint)));
+            }
+        }
+    }
+    
+    //The enclosures are tight for the elementary functions.
+    XCTAssert(sin(RoundedInterval(0, 3)).upper == 1);
+    XCTAssert(sin(RoundedInterval(0, 3)).lower < 0 && sin(RoundedInterval(0, 3)).lower > -1e-15);
+    XCTAssert(cos(RoundedInterval(-1, 1)).lower < cos(1.0) && cos(RoundedInterval(-1, 1)).lower > cos(1.0) - 1e-15);
+    XCTAssert(power(RoundedInterval(-2, 1), size_t(2)).lower == 0);
+    XCTAssert(chebPower(RoundedInterval(-1, 1), size_t(5)).lower >= -1 - 1e-14);
+    XCTAssert(chebPower(RoundedInterval(-1, 1), size_t(5)).upper <= 1 + 1e-14);
+    XCTAssert(std::isinf(tan(RoundedInterval(1, 2)).upper));
+    XCTAssert(std::isinf((RoundedInterval(1) / RoundedInterval(-1, 1)).upper));
+    
+    //A box the function can't be zero on is excluded
+    Function circle("", "x^2+y^2-1", variableNames);
+    box[0] = RoundedInterval(-.3, .4);
+    box[1] = RoundedInterval(-.5, -.2);
+    XCTAssertFalse(circle.evaluate<RoundedInterval>(box).containsZero());
+    box[0] = RoundedInterval(.5, 1);
+    XCTAssert(circle.evaluate<RoundedInterval>(box).containsZero());
+}
+
+- (void)testDualNumber{
+    std::vector<std::string> variableNames;
+    variableNames.push_back("x");
+    variableNames.push_back("y");
+    
+    std::vector<std::string> functionStrings;
+    functionStrings.push_back("x^2*y-3*x*y^4+1");
+    functionStrings.push_back("T2(x)*T3(y)-T1(y)");
+    functionStrings.push_back("sin(5*x+y)*cos(y)-x/(2+exp(y))");
+    functionStrings.push_back("cos(x*y)^sqrt(2+x)-log(3+y)*tanh(x)");
+    functionStrings.push_back("T4(sinh(x/2))-cosh(y)+log10(4+x)+log2(5-y)");
+    functionStrings.push_back("tan(x)+x^8*y^7-2*x^3*y^2+5*x*y^6+y^9-x");
+
+    //The derivatives match central differences
+    const double h = 1e-6;
+    std::vector<double> evalPoint;
+    evalPoint.push_back(.3);
+    evalPoint.push_back(-.6);
+    std::vector<DualNumber> dualPoint(2);
+    for(size_t functionNumber = 0; functionNumber < functionStrings.size(); functionNumber++) {
+        Function tempFunction("", functionStrings[functionNumber], variableNames);
+        for(size_t dim = 0; dim < 2; dim++) {
+            for(size_t i = 0; i < 2; i++) {
+                dualPoint[i] = DualNumber(evalPoint[i], i == dim ? 1 : 0);
+            }
+            const DualNumber result = tempFunction.evaluate<DualNumber>(dualPoint);
+            XCTAssert(withinEpslion(result.value, tempFunction.evaluate<double>(evalPoint), 1e-14));
+            std::vector<double> upper = evalPoint;
+            std::vector<double> lower = evalPoint;
+            upper[dim] += h;
+            lower[dim] -= h;
+            const double difference = (tempFunction.evaluate<double>(upper) - tempFunction.evaluate<double>(lower)) / (2*h);
+            XCTAssert(std::abs(result.derivative - difference) < 1e-6 * std::max(1.0, std::abs(difference)));
+        }
+    }
+}
+
 - (void)testFunctionTiming {
     for(size_t numFives = 1; numFives < 10; numFives++) {
         std::vector<double> inputPoints;
@@ -7,6 +7,10 @@
 //
 
 #import <XCTest/XCTest.h>
+#include "Solvers/KrawczykSolver.hpp"
+#include "Solvers/SpectralSolver.hpp"
+#include "IntervalChecking/IntervalChecker.hpp"
+#include "IntervalChecking/ClusterChecker.hpp"
 
 @interface TestIntervalChecker : XCTestCase
 
@@ -28,4 +32,290 @@
     // Use XCTAssert and related functions to verify your tests produce the correct results.
 }
 
+- (void)testKrawczyk {
+    size_t rank = 2;
+    GeneralParameters params;
+    IntervalTracker intervalTracker(rank, params, 4.0);
+    std::vector<std::vector<Function::SharedFunctionPtr> > functions;
+    RootTracker rootTracker(1, functions, params);
+    ConcurrentStack<SolveParameters> intervalsToRun(1);
+    SolveParameters defualtParams;
+    ObjectPool<SolveParameters> solveParametersPool(defualtParams, 32);
+    std::vector<Function::SharedFunctionPtr> threadFunctions;
+    NewtonSolver<2> newtonSolver(0, rank, threadFunctions, intervalTracker, rootTracker);
+    KrawczykSolver<2> krawczykSolver(0, rank, intervalTracker, rootTracker, intervalsToRun, solveParametersPool, newtonSolver);
+
+    //x - 0.3 + 0.05T2(y) and y + 0.2 + 0.05T3(x)
+    size_t degree = 3;
+    size_t sideLength = 2*(degree+1);
+    std::vector<double> coeffs1(sideLength*sideLength, 0.0);
+    std::vector<double> coeffs2(sideLength*sideLength, 0.0);
+    coeffs1[0] = -0.3;
+    coeffs1[1] = 1.0;
+    coeffs1[2*sideLength] = 0.05;
+    coeffs2[0] = 0.2;
+    coeffs2[sideLength] = 1.0;
+    coeffs2[3] = 0.05;
+    std::vector<ChebyshevApproximation<2> > approximations;
+    approximations.emplace_back(rank);
+    approximations.emplace_back(rank);
+    approximations[0].setApproximation(degree, sideLength, coeffs1.data(), 1, true, 1e-12);
+    approximations[1].setApproximation(degree, sideLength, coeffs2.data(), 1, true, 1e-12);
+
+    //The box shrinks down to the root
+    XCTAssert(krawczykSolver.contract(approximations) == KrawczykResult::UniqueRoot);
+    const Interval& box = krawczykSolver.getBox();
+    const double x = (box.lowerBounds[0] + box.upperBounds[0]) / 2;
+    const double y = (box.lowerBounds[1] + box.upperBounds[1]) / 2;
+    XCTAssert(box.upperBounds[0] - box.lowerBounds[0] < 1e-10);
+    XCTAssert(box.upperBounds[1] - box.lowerBounds[1] < 1e-10);
+    XCTAssert(std::abs(x - 0.3 + 0.05*(2*y*y - 1)) < 1e-10);
+    XCTAssert(std::abs(y + 0.2 + 0.05*(4*x*x*x - 3*x)) < 1e-10);
+    
+    //y + 1.1 isn't zero anywhere
+    coeffs2[0] = 1.1;
+    approximations[1].setApproximation(degree, sideLength, coeffs2.data(), 1, true, 1e-12);
+    XCTAssert(krawczykSolver.contract(approximations) == KrawczykResult::NoRoot);
+}
+
+- (void)testNewtonPolish {
+    size_t rank = 2;
+    GeneralParameters params;
+    IntervalTracker intervalTracker(rank, params, 4.0);
+    std::vector<std::string> variableNames;
+    variableNames.push_back("x");
+    variableNames.push_back("y");
+    std::vector<std::vector<Function::SharedFunctionPtr> > functions(1);
+    functions[0].push_back(std::make_shared<Function>("f1", "x^2+y^2-1", variableNames));
+    functions[0].push_back(std::make_shared<Function>("f2", "y-exp(x)+1.5", variableNames));
+    RootTracker rootTracker(1, functions, params);
+    NewtonSolver<2> newtonSolver(0, rank, functions[0], intervalTracker, rootTracker);
+
+    //Converges to the root in the box
+    Interval interval;
+    interval.lowerBounds.push_back(0);
+    interval.lowerBounds.push_back(0);
+    interval.upperBounds.push_back(1);
+    interval.upperBounds.push_back(1);
+    Interval box;
+    box.lowerBounds.push_back(0.7);
+    box.lowerBounds.push_back(0.6);
+    box.upperBounds.push_back(0.8);
+    box.upperBounds.push_back(0.7);
+    XCTAssert(newtonSolver.polish(box, interval));
+    const std::vector<double>& root = newtonSolver.getRoot();
+    XCTAssert(std::abs(root[0]*root[0] + root[1]*root[1] - 1) < 1e-14);
+    XCTAssert(std::abs(root[1] - std::exp(root[0]) + 1.5) < 1e-14);
+    XCTAssert(std::abs(newtonSolver.getResiduals()[0]) < 1e-14);
+    std::vector<FoundRoot> foundRoots = rootTracker.getRoots();
+    XCTAssert(foundRoots.size() == 1 && foundRoots[0].solveMethod == SolveMethod::NewtonPolish);
+
+    //Fails if Newton leaves the box
+    box.lowerBounds[0] = 0.1;
+    box.upperBounds[0] = 0.2;
+    XCTAssertFalse(newtonSolver.polish(box, interval));
+    XCTAssert(rootTracker.getRoots().size() == 1);
+}
+
+- (void)testSpectralSolve {
+    size_t rank = 2;
+    GeneralParameters params;
+    IntervalTracker intervalTracker(rank, params, 4.0);
+    std::vector<std::vector<Function::SharedFunctionPtr> > functions;
+    RootTracker rootTracker(1, functions, params);
+    SpectralSolver<2> spectralSolver(0, rank, intervalTracker, rootTracker);
+    Interval interval;
+    interval.lowerBounds.push_back(-1);
+    interval.lowerBounds.push_back(-1);
+    interval.upperBounds.push_back(1);
+    interval.upperBounds.push_back(1);
+
+    //x^2 + y^2 - 0.5 = 0.5T2(x) + 0.5T2(y) + 0.5 and xy - 0.1
+    size_t degree = 2;
+    size_t sideLength = 2*(degree+1);
+    std::vector<double> coeffs1(sideLength*sideLength, 0.0);
+    std::vector<double> coeffs2(sideLength*sideLength, 0.0);
+    coeffs1[0] = 0.5;
+    coeffs1[2] = 0.5;
+    coeffs1[2*sideLength] = 0.5;
+    coeffs2[0] = -0.1;
+    coeffs2[1+sideLength] = 1.0;
+    std::vector<ChebyshevApproximation<2> > approximations;
+    approximations.emplace_back(rank);
+    approximations.emplace_back(rank);
+    approximations[0].setApproximation(degree, sideLength, coeffs1.data(), 1, true, 1e-12);
+    approximations[1].setApproximation(degree, sideLength, coeffs2.data(), 1, true, 1e-12);
+    XCTAssert(approximations[0].trimCoefficients(1e-10, 1e-10, 2));
+    XCTAssert(approximations[1].trimCoefficients(1e-10, 1e-10, 2));
+
+    //All 4 roots are in the box
+    XCTAssert(spectralSolver.solve(approximations, interval, 1e-5));
+    std::vector<FoundRoot> foundRoots = rootTracker.getRoots();
+    XCTAssert(foundRoots.size() == 4);
+    for(size_t i = 0; i < foundRoots.size(); i++) {
+        const double x = foundRoots[i].root[0];
+        const double y = foundRoots[i].root[1];
+        XCTAssert(std::abs(x*x + y*y - 0.5) < 1e-14);
+        XCTAssert(std::abs(x*y - 0.1) < 1e-14);
+        XCTAssert(foundRoots[i].solveMethod == SolveMethod::SpectralSolve);
+    }
+
+    //xy - 0.3 has only complex roots with the circle
+    coeffs2[0] = -0.3;
+    approximations[1].setApproximation(degree, sideLength, coeffs2.data(), 1, true, 1e-12);
+    XCTAssert(approximations[1].trimCoefficients(1e-10, 1e-10, 2));
+    XCTAssert(spectralSolver.solve(approximations, interval, 1e-5));
+    XCTAssert(rootTracker.getRoots().size() == 4);
+}
+
+- (void)testColleagueMatrix {
+    size_t rank = 1;
+    GeneralParameters params;
+    IntervalTracker intervalTracker(rank, params, 2.0);
+    std::vector<std::vector<Function::SharedFunctionPtr> > functions;
+    RootTracker rootTracker(1, functions, params);
+    SpectralSolver<1> spectralSolver(0, rank, intervalTracker, rootTracker);
+    Interval interval;
+    interval.lowerBounds.push_back(-1);
+    interval.upperBounds.push_back(3);
+
+    //T_7(x) has 7 roots at cos((2k+1)pi/14)
+    size_t degree = 7;
+    std::vector<double> coeffs(2*degree, 0.0);
+    coeffs[degree] = 1.0;
+    std::vector<ChebyshevApproximation<1> > approximations;
+    approximations.emplace_back(rank);
+    approximations[0].setApproximation(degree, 2*degree, coeffs.data(), 1, true, 1e-12);
+    XCTAssert(spectralSolver.solve(approximations, interval, 1e-5));
+    std::vector<FoundRoot> foundRoots = rootTracker.getRoots();
+    XCTAssert(foundRoots.size() == 7);
+    for(size_t i = 0; i < foundRoots.size(); i++) {
+        //Transform back to [-1,1]
+        const double x = (foundRoots[i].root[0] - 1) / 2;
+        XCTAssert(std::abs(std::cos(7*std::acos(x))) < 1e-14);
+        XCTAssert(foundRoots[i].solveMethod == SolveMethod::SpectralSolve);
+    }
+
+    //x^2 + 0.25 = 0.5T2(x) + 0.75 has no real roots
+    std::fill(coeffs.begin(), coeffs.end(), 0.0);
+    coeffs[0] = 0.75;
+    coeffs[2] = 0.5;
+    approximations[0].setApproximation(2, 2*degree, coeffs.data(), 1, true, 1e-12);
+    XCTAssert(spectralSolver.solve(approximations, interval, 1e-5));
+    XCTAssert(rootTracker.getRoots().size() == 7);
+}
+
+- (void)testMonotonicityCheck {
+    size_t rank = 2;
+    GeneralParameters params;
+    IntervalTracker intervalTracker(rank, params, 4.0);
+    ConcurrentStack<SolveParameters> intervalsToRun(1);
+    SolveParameters defualtParams;
+    ObjectPool<SolveParameters> solveParametersPool(defualtParams, 32);
+    IntervalChecker<2> intervalChecker(rank, intervalTracker, 0, intervalsToRun, solveParametersPool);
+
+    //x - 0.3 + 0.05T2(y) is monotone in x and y + 0.2 + 0.05T3(x) is monotone in y
+    size_t degree = 3;
+    size_t sideLength = 2*(degree+1);
+    std::vector<double> coeffs1(sideLength*sideLength, 0.0);
+    std::vector<double> coeffs2(sideLength*sideLength, 0.0);
+    coeffs1[0] = -0.3;
+    coeffs1[1] = 1.0;
+    coeffs1[2*sideLength] = 0.05;
+    coeffs2[0] = 0.2;
+    coeffs2[sideLength] = 1.0;
+    coeffs2[3] = 0.05;
+    std::vector<ChebyshevApproximation<2> > approximations;
+    approximations.emplace_back(rank);
+    approximations.emplace_back(rank);
+    approximations[0].setApproximation(degree, sideLength, coeffs1.data(), 1, true, 1e-12);
+    approximations[1].setApproximation(degree, sideLength, coeffs2.data(), 1, true, 1e-12);
+    XCTAssert(intervalChecker.runMonotonicityCheck(approximations));
+
+    //0.5y + 0.2 + 0.2T3(x) isn't dominated by y anymore
+    coeffs2[sideLength] = 0.5;
+    coeffs2[3] = 0.2;
+    approximations[1].setApproximation(degree, sideLength, coeffs2.data(), 1, true, 1e-12);
+    XCTAssertFalse(intervalChecker.runMonotonicityCheck(approximations));
+
+    //x + 0.2 + 0.05T2(y) is monotone in x again, so both functions are monotone in the same variable
+    std::fill(coeffs2.begin(), coeffs2.end(), 0.0);
+    coeffs2[0] = 0.2;
+    coeffs2[1] = 1.0;
+    coeffs2[2*sideLength] = 0.05;
+    approximations[1].setApproximation(degree, sideLength, coeffs2.data(), 1, true, 1e-12);
+    XCTAssertFalse(intervalChecker.runMonotonicityCheck(approximations));
+}
+
+- (void)testClusterCheck {
+    size_t rank = 2;
+    GeneralParameters params;
+    IntervalTracker intervalTracker(rank, params, 4.0);
+    std::vector<std::vector<Function::SharedFunctionPtr> > functions;
+    RootTracker rootTracker(1, functions, params);
+    ClusterChecker<2> clusterChecker(0, rank, intervalTracker, rootTracker);
+    SolveParameters parameters;
+    parameters.interval.lowerBounds.push_back(0.3);
+    parameters.interval.lowerBounds.push_back(0.2);
+    parameters.interval.upperBounds.push_back(0.3 + 1e-7);
+    parameters.interval.upperBounds.push_back(0.2 + 1e-7);
+
+    //x^2 = 0.5T2(x) + 0.5 and y have a double root
+    size_t degree = 2;
+    size_t sideLength = 2*(degree+1);
+    std::vector<double> coeffs1(sideLength*sideLength, 0.0);
+    std::vector<double> coeffs2(sideLength*sideLength, 0.0);
+    coeffs1[0] = 0.5;
+    coeffs1[2] = 0.5;
+    coeffs2[sideLength] = 1.0;
+    std::vector<ChebyshevApproximation<2> > approximations;
+    approximations.emplace_back(rank);
+    approximations.emplace_back(rank);
+    approximations[0].setApproximation(degree, sideLength, coeffs1.data(), 1, true, 1e-12);
+    approximations[1].setApproximation(degree, sideLength, coeffs2.data(), 1, true, 1e-12);
+
+    //It has to look like a cluster for 8 levels in a row
+    for(size_t level = 1; level < 8; level++) {
+        XCTAssertFalse(clusterChecker.runClusterCheck(approximations, &parameters, rank));
+        XCTAssert(parameters.clusterLevels == level);
+    }
+    XCTAssert(clusterChecker.runClusterCheck(approximations, &parameters, rank));
+    XCTAssert(clusterChecker.getMultiplicity() == 2);
+    std::vector<FoundRoot> foundRoots = rootTracker.getRoots();
+    XCTAssert(foundRoots.size() == 1);
+    XCTAssert(foundRoots[0].solveMethod == SolveMethod::ClusterCheck && foundRoots[0].multiplicity == 2);
+    XCTAssert(std::abs(foundRoots[0].root[0] - 0.3) < 1e-7 && std::abs(foundRoots[0].root[1] - 0.2) < 1e-7);
+
+    //Not if the interval is too big
+    parameters.interval.upperBounds[0] = 0.4;
+    XCTAssertFalse(clusterChecker.runClusterCheck(approximations, &parameters, rank));
+
+    //x has a simple root
+    coeffs1[0] = 0.0;
+    coeffs1[1] = 1.0;
+    coeffs1[2] = 0.0;
+    approximations[0].setApproximation(degree, sideLength, coeffs1.data(), 1, true, 1e-12);
+    parameters.interval.upperBounds[0] = 0.3 + 1e-7;
+    XCTAssertFalse(clusterChecker.runClusterCheck(approximations, &parameters, rank));
+    XCTAssert(parameters.clusterLevels == 0);
+
+    //In 1D x^3 = 0.75T1(x) + 0.25T3(x) has a triple root
+    rank = 1;
+    IntervalTracker intervalTracker1D(rank, params, 2.0);
+    ClusterChecker<1> clusterChecker1D(0, rank, intervalTracker1D, rootTracker);
+    SolveParameters parameters1D;
+    parameters1D.interval.lowerBounds.push_back(0.3);
+    parameters1D.interval.upperBounds.push_back(0.3 + 1e-7);
+    parameters1D.clusterLevels = 7;
+    degree = 3;
+    std::vector<double> coeffs(2*(degree+1), 0.0);
+    coeffs[1] = 0.75;
+    coeffs[3] = 0.25;
+    std::vector<ChebyshevApproximation<1> > approximations1D;
+    approximations1D.emplace_back(rank);
+    approximations1D[0].setApproximation(degree, 2*(degree+1), coeffs.data(), 1, true, 1e-12);
+    XCTAssert(clusterChecker1D.runClusterCheck(approximations1D, &parameters1D, rank));
+    XCTAssert(clusterChecker1D.getMultiplicity() == 3);
+}
+
 @end
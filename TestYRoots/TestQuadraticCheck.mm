@@ -23,6 +23,14 @@ public:
         IntervalChecker<Rank>::runQuadraticCheck(_approximation);
     }
     
+    void runCubicCheck(ChebyshevApproximation<Rank>& _approximation) {
+        IntervalChecker<Rank>::runCubicCheck(_approximation);
+    }
+    
+    void runRestrictedSeriesCheck(ChebyshevApproximation<Rank>& _approximation) {
+        IntervalChecker<Rank>::runRestrictedSeriesCheck(_approximation);
+    }
+    
     std::vector<bool>& get_m_intervalMask() {
         return IntervalChecker<Rank>::m_intervalMask;
     }
@@ -96,6 +104,185 @@ void allocateMemoryTestQuadraticCheck()
     XCTAssert(intervalMask[1]);
 }
 
+//Sets the approximation to the sphere sum((x_i-0.8)^2) = 0.05 plus some small cubic terms. x^2 = (T2(x)+1)/2.
+//The sphere is only in the subinterval where every dimension is positive.
+void setSphereApproximationTestQuadraticCheck()
+{
+    for(size_t i = 0; i < m_arrayLength; i++) {
+        m_approximation[i] = 0.0;
+    }
+    m_approximation[0] = m_rank * (0.5 + 0.64) - 0.05;
+    size_t spot = 1;
+    for(size_t dim = 0; dim < m_rank; dim++) {
+        m_approximation[spot] = -1.6;
+        m_approximation[2*spot] = 0.5;
+        m_approximation[3*spot] = 1e-3;
+        spot *= m_sideLength;
+    }
+}
+
+- (void)test3DBasic {
+    //Set up the Mock Class
+    size_t rank = 3;
+    GeneralParameters params;
+    IntervalTracker intervalTracker(rank, params, 4.0);
+    size_t threadNum = 0;
+    ConcurrentStack<SolveParameters> intervalsToRun(1);
+    SolveParameters defualtParams;
+    ObjectPool<SolveParameters> solveParametersPool(defualtParams, 32);
+    IntervalCheckerMock<3> intervalChecker(rank, intervalTracker, threadNum, intervalsToRun, solveParametersPool);
+
+    //Set up the Chebyshev approximation
+    m_rank = 3;
+    m_approximationDegree = 5;
+    allocateMemoryTestQuadraticCheck();
+    ChebyshevApproximation<3> chebApproximation(m_rank);
+    chebApproximation.setApproximation(m_approximationDegree, m_sideLength, m_approximation, 1, false, 0);
+    setSphereApproximationTestQuadraticCheck();
+
+    //The corners of the positive subinterval are all positive, so the minimum inside it has to be found.
+    intervalChecker.runQuadraticCheck(chebApproximation);
+    std::vector<bool>& intervalMask = intervalChecker.get_m_intervalMask();
+    for(size_t i = 0; i < 7; i++) {
+        XCTAssert(intervalMask[i]);
+    }
+    XCTAssert(!intervalMask[7]);
+    
+    //With a big enough error nothing can be thrown out
+    std::fill(intervalMask.begin(), intervalMask.end(), false);
+    m_approximation[3] = 10.0;
+    chebApproximation.setApproximation(m_approximationDegree, m_sideLength, m_approximation, 1, false, 0);
+    intervalChecker.runQuadraticCheck(chebApproximation);
+    for(size_t i = 0; i < 8; i++) {
+        XCTAssert(!intervalMask[i]);
+    }
+}
+
+- (void)testNDBasic {
+    //Set up the Mock Class
+    size_t rank = 4;
+    GeneralParameters params;
+    IntervalTracker intervalTracker(rank, params, 4.0);
+    size_t threadNum = 0;
+    ConcurrentStack<SolveParameters> intervalsToRun(1);
+    SolveParameters defualtParams;
+    ObjectPool<SolveParameters> solveParametersPool(defualtParams, 32);
+    IntervalCheckerMock<-1> intervalChecker(rank, intervalTracker, threadNum, intervalsToRun, solveParametersPool);
+
+    //Set up the Chebyshev approximation
+    m_rank = 4;
+    m_approximationDegree = 4;
+    allocateMemoryTestQuadraticCheck();
+    ChebyshevApproximation<-1> chebApproximation(m_rank);
+    chebApproximation.setApproximation(m_approximationDegree, m_sideLength, m_approximation, 1, false, 0);
+    setSphereApproximationTestQuadraticCheck();
+
+    intervalChecker.runQuadraticCheck(chebApproximation);
+    std::vector<bool>& intervalMask = intervalChecker.get_m_intervalMask();
+    for(size_t i = 0; i < 15; i++) {
+        XCTAssert(intervalMask[i]);
+    }
+    XCTAssert(!intervalMask[15]);
+    
+    //Subintervals that are already thrown out stay thrown out
+    std::fill(intervalMask.begin(), intervalMask.end(), true);
+    intervalMask[15] = false;
+    intervalChecker.runQuadraticCheck(chebApproximation);
+    for(size_t i = 0; i < 15; i++) {
+        XCTAssert(intervalMask[i]);
+    }
+    XCTAssert(!intervalMask[15]);
+}
+
+- (void)test3DCubic {
+    //Set up the Mock Class
+    size_t rank = 3;
+    GeneralParameters params;
+    IntervalTracker intervalTracker(rank, params, 4.0);
+    size_t threadNum = 0;
+    ConcurrentStack<SolveParameters> intervalsToRun(1);
+    SolveParameters defualtParams;
+    ObjectPool<SolveParameters> solveParametersPool(defualtParams, 32);
+    IntervalCheckerMock<3> intervalChecker(rank, intervalTracker, threadNum, intervalsToRun, solveParametersPool);
+
+    //Set up the Chebyshev approximation
+    m_rank = 3;
+    m_approximationDegree = 5;
+    allocateMemoryTestQuadraticCheck();
+    ChebyshevApproximation<3> chebApproximation(m_rank);
+    
+    //0.3 + 4x^3 + 0.01yz + 0.001T4(z), which is positive when x is positive.
+    for(size_t i = 0; i < m_arrayLength; i++) {
+        m_approximation[i] = 0.0;
+    }
+    m_approximation[0] = 0.3;
+    m_approximation[1] = 3.0;
+    m_approximation[3] = 1.0;
+    m_approximation[m_sideLength + m_sideLength*m_sideLength] = 0.01;
+    m_approximation[4*m_sideLength*m_sideLength] = 0.001;
+    chebApproximation.setApproximation(m_approximationDegree, m_sideLength, m_approximation, 1, false, 0);
+
+    //The T3 term is too big for the quadratic check
+    intervalChecker.runQuadraticCheck(chebApproximation);
+    std::vector<bool>& intervalMask = intervalChecker.get_m_intervalMask();
+    for(size_t i = 0; i < 8; i++) {
+        XCTAssert(!intervalMask[i]);
+    }
+    
+    //Positive x is the last 4 subintervals
+    intervalChecker.runCubicCheck(chebApproximation);
+    for(size_t i = 0; i < 4; i++) {
+        XCTAssert(!intervalMask[i]);
+    }
+    for(size_t i = 4; i < 8; i++) {
+        XCTAssert(intervalMask[i]);
+    }
+}
+
+- (void)testRestrictedSeries {
+    //Set up the Mock Class
+    size_t rank = 2;
+    GeneralParameters params;
+    IntervalTracker intervalTracker(rank, params, 4.0);
+    size_t threadNum = 0;
+    ConcurrentStack<SolveParameters> intervalsToRun(1);
+    SolveParameters defualtParams;
+    ObjectPool<SolveParameters> solveParametersPool(defualtParams, 32);
+    IntervalCheckerMock<2> intervalChecker(rank, intervalTracker, threadNum, intervalsToRun, solveParametersPool);
+
+    //Set up the Chebyshev approximation
+    m_rank = 2;
+    m_approximationDegree = 5;
+    allocateMemoryTestQuadraticCheck();
+    ChebyshevApproximation<2> chebApproximation(m_rank);
+    
+    //0.9 + x + 0.05T2(y) + 0.01T4(x)T3(y), which is only zero when x is negative.
+    for(size_t i = 0; i < m_arrayLength; i++) {
+        m_approximation[i] = 0.0;
+    }
+    m_approximation[0] = 0.9;
+    m_approximation[1] = 1.0;
+    m_approximation[2*m_sideLength] = 0.05;
+    m_approximation[4 + 3*m_sideLength] = 0.01;
+    chebApproximation.setApproximation(m_approximationDegree, m_sideLength, m_approximation, 1, false, 1e-10);
+
+    //Positive x is the last 2 subintervals
+    intervalChecker.runRestrictedSeriesCheck(chebApproximation);
+    std::vector<bool>& intervalMask = intervalChecker.get_m_intervalMask();
+    XCTAssert(!intervalMask[0]);
+    XCTAssert(!intervalMask[1]);
+    XCTAssert(intervalMask[2]);
+    XCTAssert(intervalMask[3]);
+    
+    //Nothing can be thrown out with a big approximation error
+    std::fill(intervalMask.begin(), intervalMask.end(), false);
+    chebApproximation.setApproximation(m_approximationDegree, m_sideLength, m_approximation, 1, false, 1.0);
+    intervalChecker.runRestrictedSeriesCheck(chebApproximation);
+    for(size_t i = 0; i < 4; i++) {
+        XCTAssert(!intervalMask[i]);
+    }
+}
+
 - (void)testQuadCheckTiming {
     //Set up the Mock Class
     size_t rank = 1;
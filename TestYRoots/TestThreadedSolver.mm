@@ -405,6 +405,45 @@ bool compareTestFiles(const std::string& _yrootsFile, const std::string& _chebRo
     return true;
 }
 
+- (void)testSingularities {
+    //Functions with poles and logs that leave their domain inside the interval
+    std::vector<std::string> variablesNames;
+    variablesNames.push_back("x");
+    variablesNames.push_back("y");
+    std::vector<std::vector<std::string> > allFunctionStrings;
+    std::vector<std::vector<std::vector<double> > > allExpectedRoots;
+    allFunctionStrings.push_back({"1/(y-0.1)-x*3", "x-y"});
+    //3y^2-0.3y-1 = 0
+    allExpectedRoots.push_back({{0.05 + std::sqrt(0.0025 + 1.0/3), 0.05 + std::sqrt(0.0025 + 1.0/3)}, {0.05 - std::sqrt(0.0025 + 1.0/3), 0.05 - std::sqrt(0.0025 + 1.0/3)}});
+    allFunctionStrings.push_back({"y-log(x+0.3)", "y+x-0.1/(x-0.6)"});
+    allExpectedRoots.push_back({{0.2670261014655387, -0.5673499419831741}, {0.7312349657383989, 0.03075707988256745}});
+
+    Interval startInterval;
+    startInterval.lowerBounds.push_back(-1.0); startInterval.lowerBounds.push_back(-1.0);
+    startInterval.upperBounds.push_back(1.0); startInterval.upperBounds.push_back(1.0);
+    SubdivisionParameters subdivisionParameters;
+    GeneralParameters generalParameters;
+    for(size_t testNum = 0; testNum < allFunctionStrings.size(); testNum++) {
+        for(size_t numThreads = 1; numThreads <= 2; numThreads++) {
+            generalParameters.numThreads = numThreads;
+            std::vector<std::vector<Function::SharedFunctionPtr> > functions = createAllFunctions(allFunctionStrings[testNum], variablesNames, numThreads);
+            ThreadedSolver<2> solver(functions, generalParameters, startInterval, subdivisionParameters);
+            solver.solve();
+
+            //Every root is found, without going too deep around the singularities
+            std::vector<FoundRoot> foundRoots =  solver.getRoots();
+            XCTAssert(foundRoots.size() == allExpectedRoots[testNum].size());
+            for(const std::vector<double>& expectedRoot : allExpectedRoots[testNum]) {
+                bool found = false;
+                for(FoundRoot& root : foundRoots) {
+                    found |= withinEpslion(root.root[0], expectedRoot[0], 1e-8) && withinEpslion(root.root[1], expectedRoot[1], 1e-8);
+                }
+                XCTAssert(found);
+            }
+        }
+    }
+}
+
 - (void)testChebSuite {
     Timer::enable();
     //Read through all the ChebSuite files, run the test, and then check the results against what ChebFun gets.
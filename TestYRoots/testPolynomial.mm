@@ -227,7 +227,209 @@ double randomUniform2() { //Random uniform [-1,1].
     }
 }
 
-//TODO: Add a 3D Test
+- (void)testChebyshevPoly3D {
+    srand(8712391); //Seed the randomness
+
+    const size_t rank = 3;
+    const size_t polyDegree = 6;
+    const double density = 0.5;
+    const double epsilon = 1e-10;
+
+    for(size_t gridSize = 1; gridSize < 8; gridSize++) {
+        //Create a random polynomial
+        ChebyshevPolynomial myPoly(rank);
+        Monomial myMonomial;
+        myMonomial.spot.resize(rank);
+        for(size_t i = 0; i < polyDegree; i++) {
+            for(size_t j = 0; j < polyDegree; j++) {
+                for(size_t k = 0; k < polyDegree; k++) {
+                    myMonomial.spot[0] = i;
+                    myMonomial.spot[1] = j;
+                    myMonomial.spot[2] = k;
+                    myMonomial.coeff = randomUniform2();
+                    if(randomUniform1() <= density) {
+                        myPoly.addMonomial(myMonomial);
+                    }
+                }
+            }
+        }
+        myPoly.prepEvaluation();
+
+        //Create a random grid
+        std::vector<std::vector<double>> myGrid(rank);
+        for(size_t i = 0; i < rank; i++) {
+            for(size_t j = 0; j < gridSize; j++) {
+                myGrid[i].push_back(randomUniform2());
+            }
+        }
+
+        //Evaluate the grid and compare to evaluating every point seperately
+        std::vector<double> gridResults(power(gridSize, rank), 0);
+        myPoly.evaluateGrid(myGrid, gridResults);
+        std::vector<double> evalPoint(rank, 0);
+        size_t gridPoint = 0;
+        for(size_t k = 0; k < gridSize; k++) {
+            evalPoint[2] = myGrid[2][k];
+            for(size_t j = 0; j < gridSize; j++) {
+                evalPoint[1] = myGrid[1][j];
+                for(size_t i = 0; i < gridSize; i++) {
+                    evalPoint[0] = myGrid[0][i];
+                    double result = myPoly.evaluate<double>(evalPoint); //Clenshaw Eval
+                    double result2 = myPoly.evaluateSlow(evalPoint); //Slow Eval to compare
+                    double result3 = gridResults[gridPoint++]; //Grid Eval
+                    XCTAssert(withinEpslion(result, result2, epsilon));
+                    XCTAssert(withinEpslion(result, result3, epsilon));
+                }
+            }
+        }
+    }
+}
+
+- (void)testPoly3DGrid {
+    srand(5519203); //Seed the randomness
+
+    const size_t rank = 3;
+    const size_t gridSize = 6;
+    const double epsilon = 1e-10;
+
+    //Dense polynomials use the tensor evaluation, very sparse high degree ones keep using Horner.
+    std::vector<size_t> polyDegreesToTest = {4, 8, 40};
+    std::vector<double> densitiesToTest = {1.0, 0.5, 0.0002};
+    std::vector<bool> expectTensor = {true, true, false};
+
+    for(size_t testNum = 0; testNum < polyDegreesToTest.size(); testNum++) {
+        const size_t polyDegree = polyDegreesToTest[testNum];
+        Polynomial myPoly(rank);
+        Monomial myMonomial;
+        myMonomial.spot.resize(rank);
+        for(size_t i = 0; i < polyDegree; i++) {
+            for(size_t j = 0; j < polyDegree; j++) {
+                for(size_t k = 0; k < polyDegree; k++) {
+                    myMonomial.spot[0] = i;
+                    myMonomial.spot[1] = j;
+                    myMonomial.spot[2] = k;
+                    myMonomial.coeff = randomUniform2();
+                    if(randomUniform1() <= densitiesToTest[testNum]) {
+                        myPoly.addMonomial(myMonomial);
+                    }
+                }
+            }
+        }
+        //Make sure every dimension is used
+        myMonomial.spot = {polyDegree, polyDegree, polyDegree};
+        myPoly.addMonomial(myMonomial);
+        myPoly.prepEvaluation();
+        XCTAssert(myPoly.useTensorEvaluation(gridSize) == expectTensor[testNum]);
+
+        //Create a random grid
+        std::vector<std::vector<double>> myGrid(rank);
+        for(size_t i = 0; i < rank; i++) {
+            for(size_t j = 0; j < gridSize; j++) {
+                myGrid[i].push_back(randomUniform2());
+            }
+        }
+
+        //Evaluate the grid both ways and compare to evaluating every point seperately
+        std::vector<double> gridResults(power(gridSize, rank), 0);
+        std::vector<double> tensorResults(power(gridSize, rank), 0);
+        myPoly.evaluateGrid(myGrid, gridResults);
+        myPoly.evaluateGridTensor(myGrid, tensorResults);
+        std::vector<double> evalPoint(rank, 0);
+        size_t gridPoint = 0;
+        for(size_t k = 0; k < gridSize; k++) {
+            evalPoint[2] = myGrid[2][k];
+            for(size_t j = 0; j < gridSize; j++) {
+                evalPoint[1] = myGrid[1][j];
+                for(size_t i = 0; i < gridSize; i++) {
+                    evalPoint[0] = myGrid[0][i];
+                    double result = myPoly.evaluate<double>(evalPoint); //Quick Eval
+                    double result2 = myPoly.evaluateSlow(evalPoint); //Slow Eval to compare
+                    XCTAssert(withinEpslion(result, result2, epsilon));
+                    XCTAssert(withinEpslion(result, gridResults[gridPoint], epsilon));
+                    XCTAssert(withinEpslion(result, tensorResults[gridPoint], epsilon));
+                    gridPoint++;
+                }
+            }
+        }
+    }
+}
+
+- (void)testPolySparseND {
+    srand(7781023); //Seed the randomness
+
+    const size_t gridSize = 3;
+    const double epsilon = 1e-10;
+
+    //Sparse high degree polynomials in many variables use the sparse evaluation, dense ones keep using Horner.
+    std::vector<size_t> ranksToTest = {6, 8, 4};
+    std::vector<size_t> numTermsToTest = {200, 300, 0};
+    std::vector<size_t> maxPowersToTest = {12, 20, 4};
+    std::vector<bool> expectSparse = {true, true, false};
+
+    for(size_t testNum = 0; testNum < ranksToTest.size(); testNum++) {
+        const size_t rank = ranksToTest[testNum];
+        const size_t maxPower = maxPowersToTest[testNum];
+        Polynomial myPoly(rank);
+        Monomial myMonomial;
+        myMonomial.spot.resize(rank);
+        if(numTermsToTest[testNum] == 0) {
+            //Every monomial up to maxPower in each dimension
+            for(size_t termNum = 0; termNum < power(maxPower + 1, rank); termNum++) {
+                size_t spot = termNum;
+                for(size_t dim = 0; dim < rank; dim++) {
+                    myMonomial.spot[dim] = spot % (maxPower + 1);
+                    spot /= maxPower + 1;
+                }
+                myMonomial.coeff = randomUniform2();
+                myPoly.addMonomial(myMonomial);
+            }
+        }
+        else {
+            //Each term uses about a third of the variables
+            for(size_t termNum = 0; termNum < numTermsToTest[testNum]; termNum++) {
+                for(size_t dim = 0; dim < rank; dim++) {
+                    myMonomial.spot[dim] = randomUniform1() < 0.33 ? static_cast<size_t>(randomUniform1() * maxPower) : 0;
+                }
+                myMonomial.coeff = randomUniform2();
+                myPoly.addMonomial(myMonomial);
+            }
+        }
+        myPoly.prepEvaluation();
+        XCTAssert(myPoly.usesSparseEvaluation() == expectSparse[testNum]);
+        XCTAssert(myPoly.getNumUsedDimensions() == rank);
+
+        //Create a random grid
+        std::vector<std::vector<double>> myGrid(rank);
+        for(size_t i = 0; i < rank; i++) {
+            for(size_t j = 0; j < gridSize; j++) {
+                myGrid[i].push_back(randomUniform2());
+            }
+        }
+
+        //Evaluate the grid both ways and compare to evaluating every point seperately
+        std::vector<double> gridResults(power(gridSize, rank), 0);
+        std::vector<double> sparseResults(power(gridSize, rank), 0);
+        myPoly.evaluateGrid(myGrid, gridResults);
+        myPoly.evaluateGridSparse(myGrid, sparseResults);
+        std::vector<double> evalPoint(rank, 0);
+        for(size_t gridPoint = 0; gridPoint < gridResults.size(); gridPoint++) {
+            size_t spot = gridPoint;
+            for(size_t dim = 0; dim < rank; dim++) {
+                evalPoint[dim] = myGrid[dim][spot % gridSize];
+                spot /= gridSize;
+            }
+            double result = myPoly.evaluate<double>(evalPoint); //Quick Eval
+            double result2 = myPoly.evaluateSlow(evalPoint); //Slow Eval to compare
+            ErrorTracker result3 = myPoly.evaluate<ErrorTracker>(evalPoint);
+            XCTAssert(withinEpslion(result, result2, epsilon));
+            XCTAssert(withinEpslion(result, myPoly.evaluateSparse<double>(evalPoint), epsilon));
+            XCTAssert(withinEpslion(result, result3.value, epsilon));
+            XCTAssert(result3.error >= 0 && result3.error < epsilon);
+            XCTAssert(withinEpslion(result, gridResults[gridPoint], epsilon));
+            XCTAssert(withinEpslion(result, sparseResults[gridPoint], epsilon));
+        }
+    }
+}
 
 - (void)testPoly2DTiming {
     const size_t polyDegree = 100;
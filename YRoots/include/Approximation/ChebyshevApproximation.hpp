@@ -24,6 +24,8 @@ public:
     inline bool isGoodApproximationSetDegree(double absApproxTol, double relApproxTol);
     
     bool trimCoefficients(double _absApproxTol, double _relApproxTol, size_t _targetDegree);
+    //The lowest degree trimCoefficients could trim down to while staying good, without changing anything.
+    size_t getTrimmedDegree(double _absApproxTol, double _relApproxTol);
     
     void    sumAbsValues();
     double* getArray();
@@ -76,5 +76,20 @@ bool ChebyshevApproximation<1>::trimCoefficients(double _absApproxTol, double _r
     return false;
 }
 
+template <>
+size_t ChebyshevApproximation<1>::getTrimmedDegree(double _absApproxTol, double _relApproxTol) {
+    const double tol = _absApproxTol + _relApproxTol*m_infNorm;
+    if(m_approximationError >= tol) {
+        return std::numeric_limits<size_t>::max();
+    }
+    size_t degree = m_degree;
+    double error = m_approximationError;
+    while(degree > 1 && error + std::abs(m_approximation[degree]) < tol) {
+        error += std::abs(m_approximation[degree]);
+        degree--;
+    }
+    return degree;
+}
+
 
 #endif /* ChebyshevApproximation1D_ipp */
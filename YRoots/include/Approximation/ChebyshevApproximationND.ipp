@@ -153,6 +153,28 @@ bool ChebyshevApproximation<Rank>::trimCoefficients(double _absApproxTol, double
     return false;
 }
 
+template <int Rank>
+size_t ChebyshevApproximation<Rank>::getTrimmedDegree(double _absApproxTol, double _relApproxTol) {
+    const double tol = _absApproxTol + _relApproxTol*m_infNorm;
+    if(m_approximationError >= tol) {
+        return std::numeric_limits<size_t>::max();
+    }
+    size_t degree = m_degree;
+    double error = m_approximationError;
+    while(degree > 1) {
+        double degreeSum = 0;
+        for(size_t& spot : m_degreeSpots[m_partialSideLength][degree]) {
+            degreeSum += std::abs(m_approximation[spot]);
+        }
+        if(error + degreeSum >= tol) {
+            break;
+        }
+        error += degreeSum;
+        degree--;
+    }
+    return degree;
+}
+
 template <int Rank>
 void ChebyshevApproximation<Rank>::clear() {
     m_absValWasSummed = false;
@@ -11,17 +11,22 @@
 
 #include "Approximation/IntervalApproximator.hpp"
 #include "Approximation/ChebyshevApproximation.hpp"
+#include "Approximation/ChebyshevModel.hpp"
 #include "Utilities/Timer.hpp"
 
 template <int Rank>
 class ChebyshevApproximator
 {
 public:
-    ChebyshevApproximator(size_t _rank, size_t _maxApproximationDegree, ChebyshevApproximation<Rank>& _approximation);
+    ChebyshevApproximator(size_t _rank, size_t _maxApproximationDegree, ChebyshevApproximation<Rank>& _approximation, size_t _threadNum = 0, bool _useChebyshevModels = false, bool _findEvaluationError = false);
     ~ChebyshevApproximator();
     
-    void approximate(const Function::SharedFunctionPtr _function, const Interval& _currentInterval, size_t _approximationDegree);
-    double getAbsApproxTol(const Function::SharedFunctionPtr _function, const Interval& _currentInterval);
+    //_function is a Function::SharedFunctionPtr, or a TypedFunction<Rank, Callable>::SharedFunctionPtr to skip the function parsing.
+    template<typename FunctionPtr>
+    void approximate(const FunctionPtr& _function, const Interval& _currentInterval, size_t _approximationDegree);
+    //Call after approximate on the same interval, which finds the evaluation error when it's sampled if _findEvaluationError.
+    template<typename FunctionPtr>
+    double getAbsApproxTol(const FunctionPtr& _function, const Interval& _currentInterval);
 
     bool hasSignChange() {
         return m_signChange;
@@ -33,10 +38,18 @@ public:
     
 private:
     void calculateApproximationError();
+    bool approximateWithModel(const Function::SharedFunctionPtr& _function, const Interval& _currentInterval, size_t _approximationDegree);
+    //Only function trees can be turned into Chebyshev models.
+    template<typename FunctionPtr>
+    bool approximateWithModel(const FunctionPtr& _function, const Interval& _currentInterval, size_t _approximationDegree) {
+        return false;
+    }
     
 private:
     size_t                                  m_rank;
     size_t                                  m_maxApproximationDegree;
+    //The thread this runs on, used to pick the scratch space when evaluating the shared functions.
+    size_t                                  m_threadNum;
     
     double*                                 m_input;
     double*                                 m_output1;
@@ -58,9 +71,22 @@ private:
     double                                  m_approximationError;
     
     Interval                                m_absApproxErrorCalcInterval;
+    //The batch of points getAbsApproxTol evaluates at, and the results.
+    std::vector<std::vector<double> >       m_absApproxTolPoints;
+    std::vector<ErrorTracker>               m_absApproxTolResults;
+    //If the evaluation error is bounded on the approximation grid, it's used instead of evaluating at a point.
+    bool                                    m_findEvaluationError;
+    bool                                    m_evaluationErrorFound;
+    double                                  m_evaluationError;
     
     ChebyshevApproximation<Rank>&              m_approximation;
     
+    //For building the approximation from the function tree instead of sampling
+    bool                                    m_useChebyshevModels;
+    ChebyshevModelBuilder                   m_modelBuilder;
+    ChebyshevModel                          m_model;
+    std::vector<double>                     m_modelOutput;
+    
     static size_t           m_timerFullApproximateIndex;
     static size_t           m_timerAbsApproxErrorCalcIndex;
     Timer&                  m_timer = Timer::getInstance();
@@ -12,11 +12,17 @@
 #include "Utilities/ErrorTracker.hpp"
 
 template <int Rank>
-ChebyshevApproximator<Rank>::ChebyshevApproximator(size_t _rank, size_t _maxApproximationDegree, ChebyshevApproximation<Rank>& _approximation):
+ChebyshevApproximator<Rank>::ChebyshevApproximator(size_t _rank, size_t _maxApproximationDegree, ChebyshevApproximation<Rank>& _approximation, size_t _threadNum, bool _useChebyshevModels, bool _findEvaluationError):
 m_rank(_rank),
 m_maxApproximationDegree(2*_maxApproximationDegree), //We will always double the approximation given
+m_threadNum(_threadNum),
 m_fftwWisdomFile("YRoots/FFTW/bin/fftwWisdom.txt"),
-m_approximation(_approximation)
+m_findEvaluationError(_findEvaluationError),
+m_evaluationErrorFound(false),
+m_evaluationError(0),
+m_approximation(_approximation),
+m_useChebyshevModels(_useChebyshevModels),
+m_modelBuilder(_rank)
 {
     size_t sideLength1 = m_maxApproximationDegree;
     size_t arrayLength1 = power(sideLength1, m_rank);
@@ -49,12 +55,13 @@ m_approximation(_approximation)
             nextChangeDegree /= 2;
             use1 = !use1;
         }
-        m_intervalApproximators[degree-1] = ::make_unique<IntervalApproximator<Rank> >(m_rank, degree, m_input, use1 ? m_output1 : m_output2, m_kinds, partialArrayLength);
+        m_intervalApproximators[degree-1] = ::make_unique<IntervalApproximator<Rank> >(m_rank, degree, m_input, use1 ? m_output1 : m_output2, m_kinds, partialArrayLength, m_threadNum);
     }
     
     //Initialize m_absApproxErrorCalcInterval
     m_absApproxErrorCalcInterval.lowerBounds.resize(m_rank);
     m_absApproxErrorCalcInterval.upperBounds.resize(m_rank);
+    m_absApproxTolPoints.resize(m_rank, std::vector<double>(1));
     
     m_timer.registerTimer(m_timerFullApproximateIndex, "Cheb Approximator Full");
     m_timer.registerTimer(m_timerAbsApproxErrorCalcIndex, "Cheb Approximator Abs Approx Estimate");
@@ -79,7 +86,8 @@ ChebyshevApproximator<Rank>::~ChebyshevApproximator()
 
 
 template <int Rank>
-void ChebyshevApproximator<Rank>::approximate(const Function::SharedFunctionPtr _function, const Interval& _currentInterval, size_t _approximationDegree)
+template <typename FunctionPtr>
+void ChebyshevApproximator<Rank>::approximate(const FunctionPtr& _function, const Interval& _currentInterval, size_t _approximationDegree)
 {
     m_timer.startTimer(m_timerFullApproximateIndex);
     if(_approximationDegree > m_intervalApproximators.size()) {
@@ -89,6 +97,12 @@ void ChebyshevApproximator<Rank>::approximate(const Function::SharedFunctionPtr
         printAndThrowRuntimeError("Approximation Degree can not be 0!");
     }
     
+    m_evaluationErrorFound = false;
+    if(m_useChebyshevModels && approximateWithModel(_function, _currentInterval, _approximationDegree)) {
+        m_timer.stopTimer(m_timerFullApproximateIndex);
+        return;
+    }
+    
     m_firstApproximator = _approximationDegree-1;
     m_secondApproximator = 2*_approximationDegree-1;
     m_sideLength1 = 2*_approximationDegree;
@@ -97,7 +111,11 @@ void ChebyshevApproximator<Rank>::approximate(const Function::SharedFunctionPtr
     m_approxLength2 = 2*_approximationDegree+1;
 
     m_intervalApproximators[m_firstApproximator]->approximate(_function, _currentInterval, false);
-    m_intervalApproximators[m_secondApproximator]->approximate(_function, _currentInterval, true);
+    m_intervalApproximators[m_secondApproximator]->approximate(_function, _currentInterval, true, m_findEvaluationError);
+    if(m_findEvaluationError) {
+        m_evaluationError = m_intervalApproximators[m_secondApproximator]->getEvaluationError();
+        m_evaluationErrorFound = true;
+    }
     m_infNorm = m_intervalApproximators[m_secondApproximator]->getInfNorm();
     m_signChange = m_intervalApproximators[m_secondApproximator]->getSignChange();
     calculateApproximationError();
@@ -108,17 +126,60 @@ void ChebyshevApproximator<Rank>::approximate(const Function::SharedFunctionPtr
 }
 
 template <int Rank>
-double ChebyshevApproximator<Rank>::getAbsApproxTol(const Function::SharedFunctionPtr _function, const Interval& _currentInterval)
+bool ChebyshevApproximator<Rank>::approximateWithModel(const Function::SharedFunctionPtr& _function, const Interval& _currentInterval, size_t _approximationDegree)
 {
+    if(!m_modelBuilder.build(_function, _currentInterval, _approximationDegree, m_model)) {
+        return false;
+    }
+    
+    //Copy the coefficients into the same layout as the sampled approximation, 2*degree spots in each dimension.
+    m_sideLength1 = 2*_approximationDegree;
+    const size_t modelSideLength = _approximationDegree + 1;
+    m_modelOutput.assign(power(m_sideLength1, m_rank), 0.0);
+    const std::vector<double>& coeffs = m_model.getCoeffs();
+    double infNorm = 0;
+    for(size_t i = 0; i < coeffs.size(); i++) {
+        size_t index = i;
+        size_t spot = 0;
+        size_t multiplier = 1;
+        size_t numNonZeroDegrees = 0;
+        for(size_t dim = 0; dim < m_rank; dim++) {
+            spot += (index % modelSideLength) * multiplier;
+            numNonZeroDegrees += index % modelSideLength != 0;
+            index /= modelSideLength;
+            multiplier *= m_sideLength1;
+        }
+        m_modelOutput[spot] = coeffs[i];
+        //|f| is at least |c_k| / 2^(number of non-zero degrees in k) somewhere in the interval.
+        infNorm = std::max(infNorm, std::abs(coeffs[i]) / power(2.0, numNonZeroDegrees));
+    }
+    
+    //There are no samples to find a sign change with, so the interval checks always get run.
+    m_infNorm = infNorm;
+    m_signChange = false;
+    m_approximationError = m_model.getRemainder();
+    m_approximation.setApproximation(_approximationDegree, m_sideLength1, m_modelOutput.data(), m_infNorm, m_signChange, m_approximationError);
+    return true;
+}
+
+template <int Rank>
+template <typename FunctionPtr>
+double ChebyshevApproximator<Rank>::getAbsApproxTol(const FunctionPtr& _function, const Interval& _currentInterval)
+{
+    //The largest evaluation error on the grid the function was just sampled on
+    if(m_evaluationErrorFound) {
+        return m_evaluationError * 10;
+    }
+    
     m_timer.startTimer(m_timerAbsApproxErrorCalcIndex);
 
-    std::vector<double> evalPoints;
     for(size_t i = 0; i < m_rank; i++) {
         const double rand = 0.51234127384517283654; //TODO: Rand uniform [0,1]. Make sure the random point is not 0!
         const double randomPoint = _currentInterval.lowerBounds[i] + rand * (_currentInterval.upperBounds[i] - _currentInterval.lowerBounds[i]);
-        evalPoints.push_back(randomPoint);
+        m_absApproxTolPoints[i][0] = randomPoint;
     }
-    ErrorTracker result = _function->evaluate<ErrorTracker>(evalPoints);
+    _function->template evaluateBatch<ErrorTracker>(m_absApproxTolPoints, m_absApproxTolResults, m_threadNum);
+    const ErrorTracker& result = m_absApproxTolResults[0];
     
     m_timer.stopTimer(m_timerAbsApproxErrorCalcIndex);
 
@@ -0,0 +1,754 @@
+//
+//  ChebyshevModel.hpp
+//  YRoots
+//
+//  Created by Erik Hales Parkinson on 10/19/26.
+//  Copyright © 2026 Erik Hales Parkinson. All rights reserved.
+//
+
+#ifndef ChebyshevModel_hpp
+#define ChebyshevModel_hpp
+
+#include <unordered_map>
+#include "Functions/Function.hpp"
+#include "Utilities/utilities.hpp"
+#include "Utilities/ErrorTracker.hpp"
+#include "Utilities/Timer.hpp"
+
+//A Chebyshev series over [-1,1]^rank, truncated at m_degree in every dimension, and a bound on the remainder.
+//The function being modeled is within m_remainder of the series everywhere in [-1,1]^rank.
+//The coefficients are laid out with the first dimension changing fastest, with m_degree+1 spots in each dimension.
+class ChebyshevModel {
+public:
+    ChebyshevModel() :
+    m_rank(0),
+    m_degree(0),
+    m_remainder(0)
+    {}
+
+    ChebyshevModel(size_t _rank, size_t _degree) {
+        reset(_rank, _degree);
+    }
+
+    void reset(size_t _rank, size_t _degree) {
+        m_rank = _rank;
+        m_degree = _degree;
+        m_coeffs.assign(power(m_degree + 1, m_rank), 0.0);
+        m_remainder = 0;
+    }
+
+    void setConstant(double _value) {
+        std::fill(m_coeffs.begin(), m_coeffs.end(), 0.0);
+        m_coeffs[0] = _value;
+        m_remainder = 0;
+    }
+
+    //Every T_k is bounded by 1, so this bounds the series on [-1,1]^rank.
+    double sumAbsValues() const {
+        double sumAbsVal = 0;
+        for(double coeff : m_coeffs) {
+            sumAbsVal += std::abs(coeff);
+        }
+        return sumAbsVal;
+    }
+
+    //An interval containing every value the modeled function takes.
+    void getRange(double& _lower, double& _upper) const {
+        const double spread = sumAbsValues() - std::abs(m_coeffs[0]) + m_remainder;
+        _lower = m_coeffs[0] - spread;
+        _upper = m_coeffs[0] + spread;
+    }
+
+    void scale(double _value) {
+        for(double& coeff : m_coeffs) {
+            coeff *= _value;
+        }
+        m_remainder = std::abs(_value) * m_remainder + machineEpsilon * sumAbsValues();
+    }
+
+    void addConstant(double _value) {
+        m_coeffs[0] += _value;
+        m_remainder += machineEpsilon * std::abs(m_coeffs[0]);
+    }
+
+    //Adds or subtracts _other.
+    void add(const ChebyshevModel& _other, bool _isPositive) {
+        assert(m_coeffs.size() == _other.m_coeffs.size());
+        if(_isPositive) {
+            for(size_t i = 0; i < m_coeffs.size(); i++) {
+                m_coeffs[i] += _other.m_coeffs[i];
+            }
+        }
+        else {
+            for(size_t i = 0; i < m_coeffs.size(); i++) {
+                m_coeffs[i] -= _other.m_coeffs[i];
+            }
+        }
+        m_remainder += _other.m_remainder + machineEpsilon * sumAbsValues();
+    }
+
+    //Sets this to _model1 * _model2, neither of which can be this. Uses T_i*T_j = (T_i+j + T_|i-j|)/2 in each dimension.
+    //Anything past m_degree is moved into the remainder. Returns false if the product would cost more than _maxCost
+    //multiply adds, it can be very expensive for dense models in higher dimensions.
+    bool multiply(const ChebyshevModel& _model1, const ChebyshevModel& _model2, size_t _maxCost) {
+        assert(this != &_model1 && this != &_model2);
+        assert(_model1.m_coeffs.size() == _model2.m_coeffs.size());
+        reset(_model1.m_rank, _model1.m_degree);
+        _model1.getNonZeros(m_nonZeros1, m_nonZeroSpots1);
+        _model2.getNonZeros(m_nonZeros2, m_nonZeroSpots2);
+        const size_t numCombinations = power(2, m_rank);
+        if(m_nonZeros1.size() * m_nonZeros2.size() * numCombinations > _maxCost) {
+            return false;
+        }
+
+        std::vector<size_t> multipliers(m_rank, 1);
+        for(size_t dim = 1; dim < m_rank; dim++) {
+            multipliers[dim] = multipliers[dim-1] * (m_degree + 1);
+        }
+        const double combinationWeight = 1.0 / numCombinations;
+        double droppedSum = 0;
+        std::vector<size_t> sums(m_rank);
+        std::vector<size_t> differences(m_rank);
+        for(size_t i = 0; i < m_nonZeros1.size(); i++) {
+            const size_t* spot1 = &m_nonZeroSpots1[i * m_rank];
+            for(size_t j = 0; j < m_nonZeros2.size(); j++) {
+                const size_t* spot2 = &m_nonZeroSpots2[j * m_rank];
+                for(size_t dim = 0; dim < m_rank; dim++) {
+                    sums[dim] = spot1[dim] + spot2[dim];
+                    differences[dim] = spot1[dim] > spot2[dim] ? spot1[dim] - spot2[dim] : spot2[dim] - spot1[dim];
+                }
+                const double product = m_nonZeros1[i] * m_nonZeros2[j] * combinationWeight;
+                //Bit dim of combination picks the sum or the difference in dimension dim.
+                for(size_t combination = 0; combination < numCombinations; combination++) {
+                    size_t spot = 0;
+                    bool inDegree = true;
+                    for(size_t dim = 0; dim < m_rank; dim++) {
+                        const size_t degree = (combination >> dim) & 1 ? sums[dim] : differences[dim];
+                        if(degree > m_degree) {
+                            inDegree = false;
+                            break;
+                        }
+                        spot += degree * multipliers[dim];
+                    }
+                    if(inDegree) {
+                        m_coeffs[spot] += product;
+                    }
+                    else {
+                        droppedSum += std::abs(product);
+                    }
+                }
+            }
+        }
+
+        //(p1 + r1)(p2 + r2) = p1p2 + p1r2 + p2r1 + r1r2, plus what was truncated and the rounding.
+        const double sumAbs1 = _model1.sumAbsValues();
+        const double sumAbs2 = _model2.sumAbsValues();
+        m_remainder = sumAbs1 * _model2.m_remainder + sumAbs2 * _model1.m_remainder + _model1.m_remainder * _model2.m_remainder;
+        m_remainder += droppedSum + (m_rank + 2) * machineEpsilon * sumAbs1 * sumAbs2;
+        return true;
+    }
+
+    //Evaluates the series at a point in [-1,1]^rank. Only for testing and verifying.
+    double evaluate(const std::vector<double>& _point) const {
+        double result = 0;
+        for(size_t i = 0; i < m_coeffs.size(); i++) {
+            size_t index = i;
+            double term = m_coeffs[i];
+            for(size_t dim = 0; dim < m_rank; dim++) {
+                term *= chebPower(_point[dim], index % (m_degree + 1));
+                index /= m_degree + 1;
+            }
+            result += term;
+        }
+        return result;
+    }
+
+    std::vector<double>& getCoeffs() {
+        return m_coeffs;
+    }
+
+    const std::vector<double>& getCoeffs() const {
+        return m_coeffs;
+    }
+
+    double getRemainder() const {
+        return m_remainder;
+    }
+
+    void addRemainder(double _remainder) {
+        m_remainder += _remainder;
+    }
+
+    size_t getRank() const {
+        return m_rank;
+    }
+
+    size_t getDegree() const {
+        return m_degree;
+    }
+
+private:
+    //The non-zero coefficients, and the degree in each dimension of each of them.
+    void getNonZeros(std::vector<double>& _values, std::vector<size_t>& _spots) const {
+        _values.clear();
+        _spots.clear();
+        for(size_t i = 0; i < m_coeffs.size(); i++) {
+            if(m_coeffs[i] != 0) {
+                _values.push_back(m_coeffs[i]);
+                size_t index = i;
+                for(size_t dim = 0; dim < m_rank; dim++) {
+                    _spots.push_back(index % (m_degree + 1));
+                    index /= m_degree + 1;
+                }
+            }
+        }
+    }
+
+private:
+    size_t                  m_rank;
+    size_t                  m_degree;
+    std::vector<double>     m_coeffs;
+    double                  m_remainder;
+
+    //Scratch space for multiply
+    std::vector<double>     m_nonZeros1;
+    std::vector<double>     m_nonZeros2;
+    std::vector<size_t>     m_nonZeroSpots1;
+    std::vector<size_t>     m_nonZeroSpots2;
+};
+
+//Builds a ChebyshevModel of a function bottom up from its function tree instead of sampling it.
+//Sums and products are done on the coefficients. Elementary functions are composed with a Chebyshev interpolant of the
+//function on the range of their input, whose error is bounded with the function's size on a Bernstein ellipse.
+class ChebyshevModelBuilder {
+public:
+    ChebyshevModelBuilder(size_t _rank) :
+    m_rank(_rank),
+    m_degree(0)
+    {
+        m_timer.registerTimer(m_timerBuildIndex, "Cheb Model Build");
+    }
+
+    //Builds a model of _function over _interval with degree _degree in each dimension. Returns false if some part of the
+    //function can't be modeled on this interval, or would take too long, and the function has to be sampled instead.
+    bool build(const Function::SharedFunctionPtr& _function, const Interval& _interval, size_t _degree, ChebyshevModel& _model) {
+        m_timer.startTimer(m_timerBuildIndex);
+        m_degree = _degree;
+        m_interval = &_interval;
+        m_models.clear();
+        m_powerSeries.assign(m_rank, std::vector<std::vector<double> >());
+        m_chebyshevSeries.assign(m_rank, std::vector<std::vector<double> >());
+
+        const ChebyshevModel* result = buildModel(_function.get());
+        const bool success = result != nullptr && std::isfinite(result->getRemainder());
+        if(success) {
+            _model = *result;
+        }
+        m_timer.stopTimer(m_timerBuildIndex);
+        return success;
+    }
+
+private:
+    //Returns the model of _function, or nullptr if it couldn't be built. Subfunctions shared in the tree are only built once.
+    const ChebyshevModel* buildModel(const Function* _function) {
+        std::unordered_map<const Function*, ChebyshevModel>::iterator found = m_models.find(_function);
+        if(found != m_models.end()) {
+            return &found->second;
+        }
+
+        ChebyshevModel model(m_rank, m_degree);
+        const std::vector<Function::SharedFunctionPtr>& subfunctions = _function->getSubfunctions();
+        const double value = _function->getValue();
+        switch(_function->getFunctionType()) {
+            case FunctionType::CONSTANT:
+                model.setConstant(value);
+                break;
+            case FunctionType::VARIABLE: {
+                //value * x = value * (mid + halfWidth * t)
+                const size_t dim = _function->getVarIndex();
+                model.getCoeffs()[0] = value * (m_interval->upperBounds[dim] + m_interval->lowerBounds[dim]) / 2;
+                model.getCoeffs()[power(m_degree + 1, dim)] = value * (m_interval->upperBounds[dim] - m_interval->lowerBounds[dim]) / 2;
+                model.addRemainder(machineEpsilon * model.sumAbsValues());
+                break;
+            }
+            case FunctionType::POWER_BASIS_MONOMIAL: {
+                const Monomial& monomial = _function->getMonomial();
+                addPowerBasisTerm(monomial, model);
+                break;
+            }
+            case FunctionType::POWER_BASIS_POLYNOMIAL:
+                for(const Monomial& monomial : _function->getPolynomial().getMonomials()) {
+                    addPowerBasisTerm(monomial, model);
+                }
+                break;
+            case FunctionType::CHEBYSHEV_BASIS_MONOMIAL:
+            case FunctionType::CHEBYSHEV_BASIS_POLYNOMIAL:
+                for(const Monomial& monomial : _function->getChebyshevPolynomial().getMonomials()) {
+                    addChebyshevBasisTerm(monomial, model);
+                }
+                break;
+            case FunctionType::SUM: {
+                model.setConstant(value);
+                const std::vector<bool>& operatorSigns = _function->getOperatorSigns();
+                for(size_t i = 0; i < subfunctions.size(); i++) {
+                    const ChebyshevModel* subModel = buildModel(subfunctions[i].get());
+                    if(subModel == nullptr) {
+                        return nullptr;
+                    }
+                    model.add(*subModel, operatorSigns[i]);
+                }
+                break;
+            }
+            case FunctionType::PRODUCT: {
+                model.setConstant(value);
+                const std::vector<bool>& operatorSigns = _function->getOperatorSigns();
+                for(size_t i = 0; i < subfunctions.size(); i++) {
+                    const ChebyshevModel* subModel = buildModel(subfunctions[i].get());
+                    if(subModel == nullptr) {
+                        return nullptr;
+                    }
+                    if(operatorSigns[i]) {
+                        if(!multiplyInPlace(model, *subModel)) {
+                            return nullptr;
+                        }
+                    }
+                    else {
+                        ChebyshevModel reciprocal = *subModel;
+                        if(!compose(reciprocal, FunctionType::POWER, -1) || !multiplyInPlace(model, reciprocal)) {
+                            return nullptr;
+                        }
+                    }
+                }
+                break;
+            }
+            case FunctionType::POWER: {
+                const ChebyshevModel* base = buildModel(subfunctions[0].get());
+                if(base == nullptr) {
+                    return nullptr;
+                }
+                model = *base;
+                const Function* exponent = subfunctions[1].get();
+                if(exponent->getFunctionType() == FunctionType::CONSTANT) {
+                    const double exponentValue = exponent->getValue();
+                    if(exponentValue >= 0 && exponentValue == std::floor(exponentValue) && exponentValue <= s_maxIntegerPower) {
+                        if(!integerPower(model, static_cast<size_t>(exponentValue))) {
+                            return nullptr;
+                        }
+                    }
+                    else if(!compose(model, FunctionType::POWER, exponentValue)) {
+                        return nullptr;
+                    }
+                }
+                else {
+                    //x^y = exp(y*log(x))
+                    const ChebyshevModel* exponentModel = buildModel(exponent);
+                    if(exponentModel == nullptr || !compose(model, FunctionType::LOG) || !multiplyInPlace(model, *exponentModel) || !compose(model, FunctionType::EXP)) {
+                        return nullptr;
+                    }
+                }
+                model.scale(value);
+                break;
+            }
+            case FunctionType::TAN:
+            case FunctionType::TANH: {
+                //tan = sin/cos and tanh = sinh/cosh
+                const bool isTan = _function->getFunctionType() == FunctionType::TAN;
+                const ChebyshevModel* subModel = buildModel(subfunctions[0].get());
+                if(subModel == nullptr) {
+                    return nullptr;
+                }
+                ChebyshevModel denominator = *subModel;
+                model = *subModel;
+                if(!compose(model, isTan ? FunctionType::SIN : FunctionType::SINH) || !compose(denominator, isTan ? FunctionType::COS : FunctionType::COSH)) {
+                    return nullptr;
+                }
+                if(!compose(denominator, FunctionType::POWER, -1) || !multiplyInPlace(model, denominator)) {
+                    return nullptr;
+                }
+                model.scale(value);
+                break;
+            }
+            case FunctionType::SIN:
+            case FunctionType::COS:
+            case FunctionType::SINH:
+            case FunctionType::COSH:
+            case FunctionType::LOG:
+            case FunctionType::LOG10:
+            case FunctionType::LOG2:
+            case FunctionType::SQRT:
+            case FunctionType::EXP: {
+                const ChebyshevModel* subModel = buildModel(subfunctions[0].get());
+                if(subModel == nullptr) {
+                    return nullptr;
+                }
+                model = *subModel;
+                if(!compose(model, _function->getFunctionType())) {
+                    return nullptr;
+                }
+                model.scale(value);
+                break;
+            }
+            case FunctionType::CHEBYSHEV: {
+                //value * T_n(f), with the degree n stored in the var index.
+                const ChebyshevModel* subModel = buildModel(subfunctions[0].get());
+                if(subModel == nullptr || !chebyshevPower(*subModel, _function->getVarIndex(), model)) {
+                    return nullptr;
+                }
+                model.scale(value);
+                break;
+            }
+            default:
+                return nullptr;
+        }
+        if(!std::isfinite(model.getRemainder())) {
+            return nullptr;
+        }
+        return &(m_models[_function] = std::move(model));
+    }
+
+    //_model *= _other
+    bool multiplyInPlace(ChebyshevModel& _model, const ChebyshevModel& _other) {
+        const bool success = m_product.multiply(_model, _other, s_maxProductCost);
+        std::swap(_model, m_product);
+        return success;
+    }
+
+    //_model = _model^_power by repeated squaring.
+    bool integerPower(ChebyshevModel& _model, size_t _power) {
+        ChebyshevModel base = std::move(_model);
+        _model.reset(m_rank, m_degree);
+        _model.setConstant(1.0);
+        while(_power > 0) {
+            if(_power % 2 == 1 && !multiplyInPlace(_model, base)) {
+                return false;
+            }
+            _power /= 2;
+            if(_power > 0 && !multiplyInPlace(base, base)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    //_result = T_n(_model) with T_n+1 = 2xT_n - T_n-1.
+    bool chebyshevPower(const ChebyshevModel& _model, size_t _n, ChebyshevModel& _result) {
+        ChebyshevModel prev(m_rank, m_degree);
+        prev.setConstant(1.0);
+        _result = _model;
+        if(_n == 0) {
+            _result = prev;
+            return true;
+        }
+        for(size_t k = 1; k < _n; k++) {
+            ChebyshevModel next = _result;
+            if(!multiplyInPlace(next, _model)) {
+                return false;
+            }
+            next.scale(2.0);
+            next.add(prev, false);
+            prev = std::move(_result);
+            _result = std::move(next);
+        }
+        return true;
+    }
+
+    //Replaces _model with g(_model) for the univariate g given by _type and _exponent.
+    //g is interpolated at the Chebyshev points of the range of _model, and the interpolant is evaluated on the model
+    //with Clenshaw. If g is analytic inside the Bernstein ellipse E_rho around the range and bounded by M there, the
+    //interpolant of degree n is within 4M rho^-n / (rho - 1) of g on the range.
+    bool compose(ChebyshevModel& _model, FunctionType _type, double _exponent = 0) {
+        double lower, upper;
+        _model.getRange(lower, upper);
+        const double mid = (upper + lower) / 2;
+        const double halfWidth = (upper - lower) / 2;
+        if(!std::isfinite(mid) || !std::isfinite(halfWidth)) {
+            return false;
+        }
+        if(halfWidth == 0) {
+            //The model is exactly a constant
+            const double constant = evaluateUnivariate(_type, mid, _exponent);
+            _model.setConstant(constant);
+            _model.addRemainder(machineEpsilon * std::abs(constant));
+            return std::isfinite(constant);
+        }
+
+        //Bound the interpolation error. The best ellipse grows as the range shrinks, so keep doubling rho until the bound
+        //stops getting better or the ellipse reaches a singularity.
+        const size_t n = m_degree;
+        double interpolationError = std::numeric_limits<double>::infinity();
+        for(double rho = s_minBernsteinRho; rho < s_maxBernsteinRho; rho *= 2) {
+            const double semiMajor = halfWidth * (rho + 1/rho) / 2;
+            const double semiMinor = halfWidth * (rho - 1/rho) / 2;
+            const double bound = 4 * ellipseBound(_type, mid, semiMajor, semiMinor, _exponent) * std::pow(rho, -static_cast<double>(n)) / (rho - 1);
+            if(!(bound < interpolationError)) {
+                break;
+            }
+            interpolationError = bound;
+        }
+        if(!std::isfinite(interpolationError)) {
+            return false;
+        }
+
+        //Interpolate g at the n+1 Chebyshev points of the first kind.
+        std::vector<double>& values = m_univariateValues;
+        std::vector<double>& coeffs = m_univariateCoeffs;
+        values.resize(n + 1);
+        coeffs.assign(n + 1, 0.0);
+        double maxValue = 0;
+        for(size_t j = 0; j <= n; j++) {
+            values[j] = evaluateUnivariate(_type, mid + halfWidth * std::cos(M_PI * (j + 0.5) / (n + 1)), _exponent);
+            maxValue = std::max(maxValue, std::abs(values[j]));
+        }
+        for(size_t k = 0; k <= n; k++) {
+            for(size_t j = 0; j <= n; j++) {
+                coeffs[k] += values[j] * std::cos(M_PI * k * (j + 0.5) / (n + 1));
+            }
+            coeffs[k] *= (k == 0 ? 1.0 : 2.0) / (n + 1);
+        }
+        const double coeffsError = 2 * (n + 1) * machineEpsilon * maxValue;
+
+        //u = (_model - mid) / halfWidth is in [-1,1]. Sum coeffs[k] T_k(u) with Clenshaw.
+        ChebyshevModel& u = _model;
+        u.addConstant(-mid);
+        u.scale(1 / halfWidth);
+        ChebyshevModel b1(m_rank, m_degree);
+        ChebyshevModel b2(m_rank, m_degree);
+        for(size_t k = n; k > 0; k--) {
+            //b_k = c_k + 2u b_k+1 - b_k+2
+            ChebyshevModel bk = b1;
+            if(!multiplyInPlace(bk, u)) {
+                return false;
+            }
+            bk.scale(2.0);
+            bk.add(b2, false);
+            bk.addConstant(coeffs[k]);
+            b2 = std::move(b1);
+            b1 = std::move(bk);
+        }
+        //g(u) = c_0 + u b_1 - b_2
+        if(!multiplyInPlace(b1, u)) {
+            return false;
+        }
+        b1.add(b2, false);
+        b1.addConstant(coeffs[0]);
+        b1.addRemainder(interpolationError + (n + 1) * coeffsError);
+        _model = std::move(b1);
+        return true;
+    }
+
+    static double evaluateUnivariate(FunctionType _type, double _x, double _exponent) {
+        switch(_type) {
+            case FunctionType::SIN:
+                return sin(_x);
+            case FunctionType::COS:
+                return cos(_x);
+            case FunctionType::SINH:
+                return sinh(_x);
+            case FunctionType::COSH:
+                return cosh(_x);
+            case FunctionType::LOG:
+                return log(_x);
+            case FunctionType::LOG10:
+                return log10(_x);
+            case FunctionType::LOG2:
+                return log2(_x);
+            case FunctionType::SQRT:
+                return sqrt(_x);
+            case FunctionType::EXP:
+                return exp(_x);
+            case FunctionType::POWER:
+                return pow(_x, _exponent);
+            default:
+                printAndThrowRuntimeError("Unknown Function Type Encountered in evaluateUnivariate!");
+        }
+        return 0;
+    }
+
+    //A bound on |g| on the ellipse centered at _mid with the given semi-axes, or infinity if g has a singularity inside it.
+    static double ellipseBound(FunctionType _type, double _mid, double _semiMajor, double _semiMinor, double _exponent) {
+        const double infinity = std::numeric_limits<double>::infinity();
+        //The closest and furthest the ellipse gets to 0
+        const double minAbs = std::abs(_mid) - _semiMajor;
+        const double maxAbs = std::abs(_mid) + _semiMajor;
+        switch(_type) {
+            case FunctionType::SIN:
+            case FunctionType::COS:
+                //|sin(x+iy)| and |cos(x+iy)| are at most cosh(y)
+                return cosh(_semiMinor);
+            case FunctionType::SINH:
+            case FunctionType::COSH:
+                //|sinh(x+iy)| and |cosh(x+iy)| are at most cosh(x)
+                return cosh(maxAbs);
+            case FunctionType::EXP:
+                return exp(_mid + _semiMajor);
+            case FunctionType::LOG:
+            case FunctionType::LOG10:
+            case FunctionType::LOG2: {
+                if(_mid - _semiMajor <= 0) {
+                    return infinity;
+                }
+                //|log(z)| <= |log|z|| + pi
+                const double bound = std::max(std::abs(log(minAbs)), std::abs(log(maxAbs))) + M_PI;
+                return bound / (_type == FunctionType::LOG ? 1.0 : log(_type == FunctionType::LOG10 ? 10.0 : 2.0));
+            }
+            case FunctionType::SQRT:
+                return _mid - _semiMajor > 0 ? sqrt(maxAbs) : infinity;
+            case FunctionType::POWER:
+                //Negative integer powers only need to avoid 0, anything else needs to stay in the right half plane.
+                if(_exponent == std::floor(_exponent) ? minAbs <= 0 : _mid - _semiMajor <= 0) {
+                    return infinity;
+                }
+                return std::max(std::pow(minAbs, _exponent), std::pow(maxAbs, _exponent));
+            default:
+                return infinity;
+        }
+    }
+
+    //Adds coeff * x_0^k_0 * ... * x_n^k_n
+    void addPowerBasisTerm(const Monomial& _monomial, ChebyshevModel& _model) {
+        m_termFactors.resize(m_rank);
+        size_t totalDegree = 0;
+        for(size_t dim = 0; dim < m_rank; dim++) {
+            m_termFactors[dim] = &getPowerSeries(dim, _monomial.spot[dim]);
+            totalDegree += _monomial.spot[dim];
+        }
+        addSeparableTerm(_monomial.coeff, totalDegree, _model);
+    }
+
+    //Adds coeff * T_k_0(x_0) * ... * T_k_n(x_n)
+    void addChebyshevBasisTerm(const Monomial& _monomial, ChebyshevModel& _model) {
+        m_termFactors.resize(m_rank);
+        size_t totalDegree = 0;
+        for(size_t dim = 0; dim < m_rank; dim++) {
+            m_termFactors[dim] = &getChebyshevSeries(dim, _monomial.spot[dim]);
+            totalDegree += _monomial.spot[dim];
+        }
+        addSeparableTerm(_monomial.coeff, totalDegree, _model);
+    }
+
+    //Adds _coeff times the outer product of the series in m_termFactors. The series aren't truncated, anything past the
+    //degree of the model goes in the remainder. Each series took _totalDegree products in all to make, each adding rounding.
+    void addSeparableTerm(double _coeff, size_t _totalDegree, ChebyshevModel& _model) {
+        //The sum of the absolute values of each factor, and of the part of it in the degree of the model.
+        double fullProduct = std::abs(_coeff);
+        double keptProduct = std::abs(_coeff);
+        for(size_t dim = 0; dim < m_rank; dim++) {
+            const std::vector<double>& factor = *m_termFactors[dim];
+            double fullSum = 0;
+            double keptSum = 0;
+            for(size_t k = 0; k < factor.size(); k++) {
+                fullSum += std::abs(factor[k]);
+                keptSum += k <= m_degree ? std::abs(factor[k]) : 0;
+            }
+            fullProduct *= fullSum;
+            keptProduct *= keptSum;
+        }
+
+        std::vector<double>& coeffs = _model.getCoeffs();
+        std::vector<size_t> inputSpot(m_rank, 0);
+        size_t spot = 0;
+        while(true) {
+            double term = _coeff;
+            for(size_t dim = 0; dim < m_rank; dim++) {
+                term *= (*m_termFactors[dim])[inputSpot[dim]];
+            }
+            coeffs[spot] += term;
+
+            //Move to the next spot in the kept part of the outer product
+            size_t dim = 0;
+            size_t multiplier = 1;
+            while(dim < m_rank && ++inputSpot[dim] > std::min(m_degree, m_termFactors[dim]->size() - 1)) {
+                spot -= (inputSpot[dim] - 1) * multiplier;
+                inputSpot[dim] = 0;
+                multiplier *= m_degree + 1;
+                dim++;
+            }
+            if(dim == m_rank) {
+                break;
+            }
+            spot += multiplier;
+        }
+        _model.addRemainder(fullProduct - keptProduct + (m_rank + _totalDegree + 2) * machineEpsilon * fullProduct);
+    }
+
+    //x^k on the interval in dimension _dim as a Chebyshev series in t, where x = mid + halfWidth * t.
+    const std::vector<double>& getPowerSeries(size_t _dim, size_t _k) {
+        std::vector<std::vector<double> >& series = m_powerSeries[_dim];
+        if(series.size() == 0) {
+            series.push_back({1.0});
+        }
+        const std::vector<double> x = getVariableSeries(_dim);
+        while(series.size() <= _k) {
+            series.push_back(multiplySeries(series.back(), x));
+        }
+        return series[_k];
+    }
+
+    //T_k(x) on the interval in dimension _dim as a Chebyshev series in t.
+    const std::vector<double>& getChebyshevSeries(size_t _dim, size_t _k) {
+        std::vector<std::vector<double> >& series = m_chebyshevSeries[_dim];
+        if(series.size() == 0) {
+            series.push_back({1.0});
+            series.push_back(getVariableSeries(_dim));
+        }
+        const std::vector<double> x = getVariableSeries(_dim);
+        while(series.size() <= _k) {
+            //T_k+1 = 2xT_k - T_k-1
+            std::vector<double> next = multiplySeries(series.back(), x);
+            const std::vector<double>& prev = series[series.size() - 2];
+            for(size_t i = 0; i < next.size(); i++) {
+                next[i] = 2 * next[i] - (i < prev.size() ? prev[i] : 0);
+            }
+            series.push_back(std::move(next));
+        }
+        return series[_k];
+    }
+
+    std::vector<double> getVariableSeries(size_t _dim) const {
+        return {(m_interval->upperBounds[_dim] + m_interval->lowerBounds[_dim]) / 2, (m_interval->upperBounds[_dim] - m_interval->lowerBounds[_dim]) / 2};
+    }
+
+    //The product of two 1D Chebyshev series, with nothing truncated.
+    static std::vector<double> multiplySeries(const std::vector<double>& _series1, const std::vector<double>& _series2) {
+        std::vector<double> product(_series1.size() + _series2.size() - 1, 0.0);
+        for(size_t i = 0; i < _series1.size(); i++) {
+            for(size_t j = 0; j < _series2.size(); j++) {
+                const double term = _series1[i] * _series2[j] / 2;
+                product[i + j] += term;
+                product[i > j ? i - j : j - i] += term;
+            }
+        }
+        return product;
+    }
+
+private:
+    size_t                                                  m_rank;
+    size_t                                                  m_degree;
+    const Interval*                                         m_interval;
+
+    //The models of every function in the tree built so far.
+    std::unordered_map<const Function*, ChebyshevModel>     m_models;
+    //For each dimension, the Chebyshev series of x^k and T_k(x) for each k used so far.
+    std::vector<std::vector<std::vector<double> > >         m_powerSeries;
+    std::vector<std::vector<std::vector<double> > >         m_chebyshevSeries;
+
+    //Scratch space
+    ChebyshevModel                                          m_product;
+    std::vector<const std::vector<double>*>                 m_termFactors;
+    std::vector<double>                                     m_univariateValues;
+    std::vector<double>                                     m_univariateCoeffs;
+
+    //Products of dense models in high dimensions are slower than sampling the function.
+    static constexpr size_t                                 s_maxProductCost = 1 << 24;
+    static constexpr double                                 s_maxIntegerPower = 64;
+    //The ellipses tried when bounding the interpolation error.
+    static constexpr double                                 s_minBernsteinRho = 1.125;
+    static constexpr double                                 s_maxBernsteinRho = 1e300;
+
+    static size_t           m_timerBuildIndex;
+    Timer&                  m_timer = Timer::getInstance();
+};
+
+size_t ChebyshevModelBuilder::m_timerBuildIndex = -1;
+
+#endif /* ChebyshevModel_hpp */
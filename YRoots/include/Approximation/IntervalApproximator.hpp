@@ -12,18 +12,22 @@
 #include <iostream>
 #include "fftw3.h"
 #include "Functions/Function.hpp"
+#include "Functions/TypedFunction.hpp"
 #include "Utilities/utilities.hpp"
 
 template <int Rank>
 class IntervalApproximator
 {
 public:
-    IntervalApproximator(size_t _rank, size_t _approximationDegree, double* _input, double* _output, fftw_r2r_kind* _kinds, size_t _inputPartialSize);
+    IntervalApproximator(size_t _rank, size_t _approximationDegree, double* _input, double* _output, fftw_r2r_kind* _kinds, size_t _inputPartialSize, size_t _threadNum = 0);
     IntervalApproximator(IntervalApproximator const&) = delete;
     IntervalApproximator& operator=(IntervalApproximator const&) = delete;
     ~IntervalApproximator();
     
-    void approximate(const Function::SharedFunctionPtr _function, const Interval& _currentInterval, bool _findInfNorm);
+    //_function is a Function::SharedFunctionPtr, or a pointer to anything with the same grid evaluations, like a TypedFunction.
+    //If _findEvaluationError the errors of the function evaluations are bounded with the same grid evaluation.
+    template<typename FunctionPtr>
+    void approximate(const FunctionPtr& _function, const Interval& _currentInterval, bool _findInfNorm, bool _findEvaluationError = false);
 
     bool getSignChange() {
         return m_signChange;
@@ -33,6 +37,11 @@ public:
         return m_infNorm;
     }
     
+    //The largest error bound of the function evaluations, from the last approximation that found it.
+    double getEvaluationError() {
+        return m_evaluationError;
+    }
+    
     double* getOutput() {
         return m_output;
     }
@@ -55,12 +64,14 @@ private:
     size_t          m_arrayLength;
     size_t          m_partialSideLength;
     size_t          m_partialArrayLength;
+    size_t          m_threadNum;
     
     int*            m_dimensions;
     double*         m_input;
     double*         m_output;
     fftw_r2r_kind*  m_kinds;
     std::vector<double> m_inputPartial;
+    std::vector<double> m_inputPartialErrors;
     fftw_plan       m_plan;
     
     //For evaluating just part of the grid
@@ -73,6 +84,7 @@ private:
     
     //Other
     double          m_infNorm;
+    double          m_evaluationError;
     bool            m_signChange;
     
     static size_t           m_timerIntervalApproximatorIndex;
@@ -10,17 +10,19 @@
 #define IntervalApproximatorND_ipp
 
 template <int Rank>
-IntervalApproximator<Rank>::IntervalApproximator(size_t _rank, size_t _approximationDegree, double* _input, double* _output, fftw_r2r_kind* _kinds, size_t _inputPartialSize):
+IntervalApproximator<Rank>::IntervalApproximator(size_t _rank, size_t _approximationDegree, double* _input, double* _output, fftw_r2r_kind* _kinds, size_t _inputPartialSize, size_t _threadNum):
 m_rank(_rank),
 m_approximationDegree(_approximationDegree),
 m_sideLength(2*_approximationDegree),
 m_arrayLength(power(m_sideLength, m_rank)),
 m_partialSideLength(_approximationDegree + 1),
 m_partialArrayLength(power(m_partialSideLength, m_rank)),
+m_threadNum(_threadNum),
 m_input(_input),
 m_output(_output),
 m_kinds(_kinds),
 m_infNorm(0),
+m_evaluationError(0),
 m_signChange(false)
 {
     m_inputPartial.resize(_inputPartialSize);
@@ -152,7 +154,8 @@ void IntervalApproximator<Rank>::preComputePartialToFullTransition()
 }
 
 template <int Rank>
-void IntervalApproximator<Rank>::approximate(const Function::SharedFunctionPtr _function, const Interval& _currentInterval, bool _findInfNorm)
+template <typename FunctionPtr>
+void IntervalApproximator<Rank>::approximate(const FunctionPtr& _function, const Interval& _currentInterval, bool _findInfNorm, bool _findEvaluationError)
 {
     m_timer.startTimer(m_timerIntervalApproximatorIndex);
 
@@ -168,9 +171,24 @@ void IntervalApproximator<Rank>::approximate(const Function::SharedFunctionPtr _
     //Evaluate the functions at the points
     double divisor = static_cast<double>(power(m_approximationDegree, m_rank));
     m_timer.startTimer(m_timerEvalGrid);
-    _function->evaluateGrid(m_evaluationPoints, m_inputPartial);
+    if(_findEvaluationError) {
+        _function->evaluateGridWithErrors(m_evaluationPoints, m_inputPartial, m_inputPartialErrors, m_threadNum);
+    }
+    else {
+        _function->evaluateGrid(m_evaluationPoints, m_inputPartial, m_threadNum);
+    }
     m_timer.stopTimer(m_timerEvalGrid);
 
+    if(_findEvaluationError) {
+        //The largest error bound on the grid. Points where the error couldn't be bounded are skipped.
+        m_evaluationError = 0;
+        for(size_t i = 0; i < m_partialArrayLength; i++) {
+            if(std::isfinite(m_inputPartialErrors[i])) {
+                m_evaluationError = std::max(m_evaluationError, m_inputPartialErrors[i]);
+            }
+        }
+    }
+
     if(_findInfNorm) {
         m_infNorm = 0;
         bool hasPos = false;
@@ -0,0 +1,372 @@
+//
+//  ChebyshevPolynomial.h
+//  YRoots
+//
+//  Created by Erik Hales Parkinson on 10/18/26.
+//  Copyright © 2026 Erik Hales Parkinson. All rights reserved.
+//
+
+#ifndef ChebyshevPolynomial_h
+#define ChebyshevPolynomial_h
+
+#include <set>
+#include "Functions/Polynomial.hpp"
+#include "Functions/TensorGridEvaluation.hpp"
+#include "Utilities/utilities.hpp"
+#include "Utilities/ErrorTracker.hpp"
+#include "Utilities/RoundedInterval.hpp"
+
+//A polynomial in the Chebyshev basis. Each Monomial spot holds the Chebyshev degree in each dimension,
+//so the monomial [2,3] with coeff 5 is 5*T2(x)*T3(y).
+class ChebyshevPolynomial {
+public:
+    ChebyshevPolynomial (size_t _rank) :
+    m_numUsedDimensions(0),
+    m_rank(_rank),
+    m_constantTerm(0),
+    m_isMonomial(false),
+    m_maxPrefix(0),
+    m_readyToEval(false)
+    {}
+
+    double evaluateSlow(const std::vector<double>& _values) const { //Only use for testing and verifying
+        double result = 0;
+        for(const Monomial& m : m_monomials) {
+            double term = m.coeff;
+            for(size_t dim = 0; dim < m.spot.size(); dim++) {
+                term *= chebPower(_values[dim], m.spot[dim]);
+            }
+            result += term;
+        }
+        return result;
+    }
+
+    //Doesn't change the polynomial once it's been prepped, everything written to is in _scratch.
+    template<typename ReturnType, typename ValueType = double>
+    ReturnType evaluate(const std::vector<ValueType>& _values, PolynomialScratch& _scratch) {
+        if(unlikely(!m_readyToEval)) {
+            prepEvaluation();
+        }
+        if(unlikely(m_numUsedDimensions == 0)) { //Check the case of an empty polynomial.
+            return static_cast<ReturnType>(m_constantTerm);
+        }
+        if(m_isMonomial) {
+            ReturnType result = m_constantTerm;
+            for(size_t i = 0; i < m_numUsedDimensions; i++) {
+                result *= chebPower(static_cast<ReturnType>(_values[m_usedDimensions[i]]), m_monomialDegrees[i]);
+            }
+            return result;
+        }
+
+        //Run Clenshaw down each dimension, starting with the last as it is the slowest changing in m_coeffs.
+        ChebyshevClenshawScratch<ReturnType>& scratch = _scratch.getClenshaw<ReturnType>();
+        scratch.resize(m_maxPrefix);
+        size_t numPrefix = m_coeffs.size();
+        const size_t lastDim = m_numUsedDimensions - 1;
+        numPrefix /= m_numCoeffs[lastDim];
+        clenshawReduce(m_coeffs.data(), numPrefix, m_numCoeffs[lastDim], _values[m_usedDimensions[lastDim]], scratch.m_reduced1.data(), scratch);
+        ReturnType* input = scratch.m_reduced1.data();
+        ReturnType* output = scratch.m_reduced2.data();
+        for(size_t dim = lastDim - 1; dim < m_numUsedDimensions; dim--) {
+            numPrefix /= m_numCoeffs[dim];
+            clenshawReduce(input, numPrefix, m_numCoeffs[dim], _values[m_usedDimensions[dim]], output, scratch);
+            std::swap(input, output);
+        }
+        return input[0];
+    }
+
+    template<typename ReturnType, typename ValueType = double>
+    ReturnType evaluate(const std::vector<ValueType>& _values) {
+        return evaluate<ReturnType>(_values, m_scratch);
+    }
+
+    void evaluateGrid(const std::vector<std::vector<double> >& _grid, std::vector<double>& _results, PolynomialScratch& _scratch) {
+        if(unlikely(!m_readyToEval)) {
+            prepEvaluation();
+        }
+        if(unlikely(m_numUsedDimensions == 0)) { //Check the case of an empty polynomial.
+            std::fill(_results.begin(), _results.end(), m_constantTerm);
+            return;
+        }
+        const size_t gridSize = _grid[0].size();
+
+        if(m_isMonomial) {
+            //The result is the outer product of T_n on each grid axis.
+            std::vector<double>& axisValues = _scratch.m_axisValues;
+            if(axisValues.size() < gridSize) {
+                axisValues.resize(gridSize);
+            }
+            chebPowerGrid(_grid[m_usedDimensions[0]].data(), _results.data(), gridSize, m_monomialDegrees[0], m_constantTerm);
+            size_t blockSize = gridSize;
+            for(size_t i = 1; i < m_numUsedDimensions; i++) {
+                chebPowerGrid(_grid[m_usedDimensions[i]].data(), axisValues.data(), gridSize, m_monomialDegrees[i], 1.0);
+                //Go backwards so block 0 is overwritten last, as it's the one being copied.
+                for(size_t block = gridSize - 1; block < gridSize; block--) {
+                    const double multiplier = axisValues[block];
+                    double* blockResults = _results.data() + block * blockSize;
+                    for(size_t j = 0; j < blockSize; j++) {
+                        blockResults[j] = _results[j] * multiplier;
+                    }
+                }
+                blockSize *= gridSize;
+            }
+            return;
+        }
+
+        //Compute T_k on each grid axis once, then contract the coefficients against them.
+        _scratch.m_basisTables.resize(m_numUsedDimensions);
+        for(size_t i = 0; i < m_numUsedDimensions; i++) {
+            chebyshevBasisTable(_grid[m_usedDimensions[i]], m_numCoeffs[i] - 1, _scratch.m_basisTables[i]);
+        }
+        contractTensorGrid(m_coeffs, m_numCoeffs, _scratch.m_basisTables, gridSize, _scratch.m_buffer1, _scratch.m_buffer2, _results);
+    }
+
+    void evaluateGrid(const std::vector<std::vector<double> >& _grid, std::vector<double>& _results) {
+        evaluateGrid(_grid, _results, m_scratch);
+    }
+
+    void prepEvaluation() {
+        m_readyToEval = true;
+        m_hasDimension.clear();
+        m_hasDimension.resize(m_rank, false);
+        m_usedDimensions.clear();
+        m_numCoeffs.clear();
+        m_coeffs.clear();
+        m_constantTerm = 0;
+        m_isMonomial = false;
+        m_maxPrefix = 0;
+        m_scratch = PolynomialScratch();
+
+        //Find the dimensions used and the degree in each of them.
+        std::vector<size_t> maxDegrees(m_rank, 0);
+        for(const Monomial& m : m_monomials) {
+            for(size_t dim = 0; dim < m_rank; dim++) {
+                maxDegrees[dim] = std::max(maxDegrees[dim], m.spot[dim]);
+            }
+        }
+        for(size_t dim = 0; dim < m_rank; dim++) {
+            if(maxDegrees[dim] > 0) {
+                m_hasDimension[dim] = true;
+                m_usedDimensions.push_back(dim);
+                m_numCoeffs.push_back(maxDegrees[dim] + 1);
+            }
+        }
+        m_numUsedDimensions = m_usedDimensions.size();
+
+        //Check the case of just the constant term
+        if(m_numUsedDimensions == 0) {
+            for(const Monomial& m : m_monomials) {
+                m_constantTerm += m.coeff;
+            }
+            return;
+        }
+
+        //A single term is evaluated directly, there is no reason to store the dense coefficients.
+        if(m_monomials.size() == 1) {
+            const Monomial& m = *m_monomials.begin();
+            m_isMonomial = true;
+            m_constantTerm = m.coeff;
+            m_monomialDegrees.clear();
+            for(size_t i = 0; i < m_numUsedDimensions; i++) {
+                m_monomialDegrees.push_back(m.spot[m_usedDimensions[i]]);
+            }
+            return;
+        }
+
+        //Fill in the dense coefficient tensor, with the first used dimension changing fastest.
+        m_coeffs.resize(getDenseSize(), 0.0);
+        for(const Monomial& m : m_monomials) {
+            size_t spot = 0;
+            size_t multiplier = 1;
+            for(size_t i = 0; i < m_numUsedDimensions; i++) {
+                spot += multiplier * m.spot[m_usedDimensions[i]];
+                multiplier *= m_numCoeffs[i];
+            }
+            m_coeffs[spot] += m.coeff;
+        }
+        m_maxPrefix = m_coeffs.size() / m_numCoeffs.back();
+    }
+
+    //Multiplies every term by _newMonomial, using T_a*T_b = (T_(a+b) + T_|a-b|)/2 in each dimension.
+    void multiplyMonomial(const Monomial& _newMonomial) {
+        std::vector<Monomial> monomialVector(m_monomials.begin(), m_monomials.end());
+        m_monomials.clear();
+        std::vector<Monomial> products;
+        for(const Monomial& m : monomialVector) {
+            products.clear();
+            multiplyMonomials(m, _newMonomial, products);
+            addMonomials(products);
+        }
+        m_readyToEval = false;
+    }
+
+    static void multiplyMonomials(const Monomial& _monomial1, const Monomial& _monomial2, std::vector<Monomial>& _products) {
+        assert(_monomial1.spot.size() == _monomial2.spot.size());
+        Monomial product;
+        product.clear(_monomial1.spot.size());
+        product.coeff = _monomial1.coeff * _monomial2.coeff;
+        _products.push_back(product);
+        for(size_t dim = 0; dim < product.spot.size(); dim++) {
+            const size_t degree1 = _monomial1.spot[dim];
+            const size_t degree2 = _monomial2.spot[dim];
+            if(degree1 == 0 || degree2 == 0) {
+                for(Monomial& m : _products) {
+                    m.spot[dim] = degree1 + degree2;
+                }
+            }
+            else {
+                //Each term splits into two
+                const size_t numProducts = _products.size();
+                for(size_t i = 0; i < numProducts; i++) {
+                    _products[i].coeff /= 2;
+                    _products.push_back(_products[i]);
+                    _products[i].spot[dim] = degree1 + degree2;
+                    _products.back().spot[dim] = degree1 > degree2 ? degree1 - degree2 : degree2 - degree1;
+                }
+            }
+        }
+    }
+
+    void addMonomials(const std::vector<Monomial>& _newMonomials) {
+        for(const Monomial& m : _newMonomials) {
+            addMonomial(m);
+        }
+    }
+
+    void addMonomials(const std::set<Monomial, CustomMonomialLess>& _newMonomials) {
+        for(const Monomial& m : _newMonomials) {
+            addMonomial(m);
+        }
+    }
+
+    void addMonomial(const Monomial& _newMonomial) {
+        m_readyToEval = false;
+        std::set<Monomial, CustomMonomialLess>::iterator found = m_monomials.find(_newMonomial);
+        if(found != m_monomials.end()) {
+            Monomial toInsert = _newMonomial;
+            toInsert.coeff += found->coeff;
+            m_monomials.erase(found);
+            m_monomials.insert(toInsert);
+        }
+        else {
+            m_monomials.insert(_newMonomial);
+        }
+    }
+
+    //The number of coefficients in the dense tensor that would be needed to hold the given monomials.
+    static size_t getDenseSize(const std::set<Monomial, CustomMonomialLess>& _monomials, size_t _rank) {
+        std::vector<size_t> maxDegrees(_rank, 0);
+        for(const Monomial& m : _monomials) {
+            for(size_t dim = 0; dim < _rank; dim++) {
+                maxDegrees[dim] = std::max(maxDegrees[dim], m.spot[dim]);
+            }
+        }
+        size_t denseSize = 1;
+        for(size_t dim = 0; dim < _rank; dim++) {
+            denseSize *= maxDegrees[dim] + 1;
+        }
+        return denseSize;
+    }
+
+    size_t getDenseSize() const {
+        size_t denseSize = 1;
+        for(size_t i = 0; i < m_numCoeffs.size(); i++) {
+            denseSize *= m_numCoeffs[i];
+        }
+        return denseSize;
+    }
+
+    //Sparse polynomials, like T100(x)*T100(y) + 1, are cheaper to leave as sums of monomials.
+    bool worthStoringDense() const {
+        const size_t denseSize = getDenseSize(m_monomials, m_rank);
+        const size_t ratioSize = s_maxDenseRatio * m_monomials.size();
+        return denseSize <= s_minDenseSize || denseSize <= ratioSize;
+    }
+
+    const std::set<Monomial, CustomMonomialLess>& getMonomials() const {
+        return m_monomials;
+    }
+
+    double getEvaluationErrorBound(const std::vector<double>& _maxAbsValues) const {
+        return Polynomial::getEvaluationErrorBound(m_monomials, _maxAbsValues, true);
+    }
+
+    const std::vector<bool>& getHasDimension() const {
+        return m_hasDimension;
+    }
+
+    size_t getNumUsedDimensions() const {
+        return m_numUsedDimensions;
+    }
+
+    void clear() {
+        m_coeffs.clear();
+        m_numCoeffs.clear();
+        m_usedDimensions.clear();
+        m_hasDimension.clear();
+        m_numUsedDimensions = 0;
+        m_constantTerm = 0;
+        m_monomials.clear();
+        m_readyToEval = false;
+    }
+
+private:
+    //One step of the nested Clenshaw. _input holds _numPrefix interleaved series of length _numCoeffs, with the prefix
+    //changing fastest. Each series is evaluated at _value and stored in _output.
+    template<typename ReturnType, typename InputType, typename ValueType>
+    static void clenshawReduce(const InputType* _input, size_t _numPrefix, size_t _numCoeffs, const ValueType& _value, ReturnType* _output, ChebyshevClenshawScratch<ReturnType>& _scratch) {
+        if(_numCoeffs == 1) {
+            std::copy(_input, _input + _numPrefix, _output);
+            return;
+        }
+        ReturnType* b1 = _scratch.m_b1.data();
+        ReturnType* b2 = _scratch.m_b2.data();
+        std::fill(b1, b1 + _numPrefix, ReturnType(0));
+        std::fill(b2, b2 + _numPrefix, ReturnType(0));
+        const ReturnType twoValue = 2 * _value;
+        for(size_t k = _numCoeffs - 1; k > 0; k--) {
+            const InputType* coeffs = _input + k * _numPrefix;
+            for(size_t i = 0; i < _numPrefix; i++) {
+                ReturnType temp = b1[i];
+                b1[i] = twoValue * b1[i] - b2[i] + coeffs[i];
+                b2[i] = temp;
+            }
+        }
+        const ReturnType value = _value;
+        for(size_t i = 0; i < _numPrefix; i++) {
+            _output[i] = value * b1[i] - b2[i] + _input[i];
+        }
+    }
+
+private:
+    //The dense coefficients over the used dimensions, with the first used dimension changing fastest.
+    std::vector<double>                         m_coeffs;
+    //Degree + 1 in each used dimension
+    std::vector<size_t>                         m_numCoeffs;
+    //Which dimensions are used in the polynomial
+    std::vector<size_t>                         m_usedDimensions;
+    std::vector<bool>                           m_hasDimension;
+    size_t                                      m_numUsedDimensions;
+    //The rank of the space we are in, size of the m_hasDimension vector.
+    size_t                                      m_rank;
+    //For a constant polynomial this is the value, for a monomial this is the coefficient.
+    double                                      m_constantTerm;
+    //For the special case of a single monomial
+    bool                                        m_isMonomial;
+    std::vector<size_t>                         m_monomialDegrees;
+
+    //The monomials the make up the polynomial
+    std::set<Monomial, CustomMonomialLess>      m_monomials;
+
+    //The most series reduced at once in evaluate, the size the Clenshaw scratch needs.
+    size_t                                      m_maxPrefix;
+    //Used by the evaluations that aren't given a scratch.
+    PolynomialScratch                           m_scratch;
+
+    bool                                        m_readyToEval;
+
+    static constexpr size_t                     s_minDenseSize = 4096;
+    static constexpr size_t                     s_maxDenseRatio = 16;
+};
+
+#endif /* ChebyshevPolynomial_h */
@@ -10,6 +10,8 @@
 #define Function_h
 
 #include <math.h>
+#include <cerrno>
+#include <cstdlib>
 #include <unordered_map>
 #include <unordered_set>
 #include <set>
@@ -17,6 +19,7 @@
 #include "Utilities/utilities.hpp"
 #include "Utilities/Timer.hpp"
 #include "Functions/Polynomial.hpp"
+#include "Functions/ChebyshevPolynomial.hpp"
 
 enum FunctionType {
     SIN, //Syntax: sin(x)
@@ -75,6 +78,49 @@ struct EvaluateGridInfo {
     std::vector<size_t> topResultMap;
 };
 
+//Everything a Function writes to while evaluating. Each thread has it's own so the function trees can be shared.
+struct FunctionScratch {
+    FunctionScratch() : gridTileOffset(0) {}
+    
+    std::vector<double>             partialEvaluations;
+    std::vector<EvaluateGridInfo>   evaluateGridInfo;
+    //For tiled evaluate grid. The grid index of partialEvaluations[0]. This is 0 unless only a tile is stored.
+    size_t                          gridTileOffset;
+    PolynomialScratch               polynomialScratch;
+    
+    //For evaluate grid with errors. The error bound of each partial evaluation, and the largest absolute value on each grid axis.
+    std::vector<double>             partialErrors;
+    std::vector<double>             gridMaxAbsValues;
+    
+    //For evaluate batch. The evaluations at each point in the batch, and a single point to evaluate polynomials at.
+    std::vector<double>             batchEvaluations;
+    std::vector<ErrorTracker>       batchEvaluationsErrorTracker;
+    std::vector<double>             batchPoint;
+    
+    template<typename ReturnType>
+    std::vector<ReturnType>& getBatchEvaluations();
+};
+
+template<>
+inline std::vector<double>& FunctionScratch::getBatchEvaluations<double>() {
+    return batchEvaluations;
+}
+
+template<>
+inline std::vector<ErrorTracker>& FunctionScratch::getBatchEvaluations<ErrorTracker>() {
+    return batchEvaluationsErrorTracker;
+}
+
+//A piece of a function string parsed by the polynomial fast path. It is what the Function for that substring would
+//simplify to, which is always a CONSTANT, VARIABLE, POWER_BASIS_MONOMIAL or POWER_BASIS_POLYNOMIAL.
+struct PolynomialParseTerm {
+    FunctionType            type;
+    double                  value; //The m_value the Function would have
+    size_t                  varIndex;
+    Monomial                monomial;
+    std::vector<Monomial>   monomials; //For POWER_BASIS_POLYNOMIAL, in the order the Polynomial stores them.
+};
+
 #define SIGNCHECKSUM(isPositive, result, number) (isPositive ? result += number : result -= number)
 #define SIGNCHECKPRODUCT(isPositive, result, number) (isPositive ? result *= number : result /= number)
 
@@ -94,7 +140,9 @@ public:
     m_functionName(_functionName),
     m_variableNames(_variableNames),
     m_polynomial(_variableNames.size()),
-    m_rank(_variableNames.size())
+    m_chebyshevPolynomial(_variableNames.size()),
+    m_rank(_variableNames.size()),
+    m_threadScratch(1)
     {
         //Parse the function
         functionParse(m_functionString);
@@ -113,13 +161,14 @@ public:
                 m_monomial.prepEvaluation();
                 m_hasDimension = m_monomial.getHasDimension();
                 break;
-            case FunctionType::CHEBYSHEV_BASIS_MONOMIAL: //TODO: Write this for Chebyshev Monomials
-                break;
             case FunctionType::POWER_BASIS_POLYNOMIAL:
                 m_polynomial.prepEvaluation();
                 m_hasDimension = m_polynomial.getHasDimension();
                 break;
-            case FunctionType::CHEBYSHEV_BASIS_POLYNOMIAL: //TODO: Write this for Chebyshev Polynomials
+            case FunctionType::CHEBYSHEV_BASIS_MONOMIAL:
+            case FunctionType::CHEBYSHEV_BASIS_POLYNOMIAL:
+                m_chebyshevPolynomial.prepEvaluation();
+                m_hasDimension = m_chebyshevPolynomial.getHasDimension();
                 break;
             default: {
                 //Everything that is a base function should be in the case statements above.
@@ -183,11 +232,6 @@ public:
         //Get the childEvalSize
         _infoToPopulate.childEvalSize = power(_gridSize, m_numUsedDimensions);
 
-        //Make sure the m_partialEvaluations is big enough
-        if(m_partialEvaluations.size() <= _infoToPopulate.childEvalSize) {
-            m_partialEvaluations.resize(_infoToPopulate.childEvalSize);
-        }
-
         if(m_evaluateGridType == EvaluateGridType::COMBINE) {
             //We need to create the childEvalIndexes for the non simple cases
             _infoToPopulate.childEvalIndexes.resize(_infoToPopulate.childEvalSize);
@@ -296,7 +340,8 @@ public:
         }
     }
     
-    void evaluateGridBase(const std::vector<std::vector<double> >& _grid, std::vector<double>& _results) {
+    void evaluateGridBase(const std::vector<std::vector<double> >& _grid, std::vector<double>& _results, size_t _threadNum) {
+        PolynomialScratch& polynomialScratch = m_threadScratch[_threadNum].polynomialScratch;
         switch(m_functionType) {
             case FunctionType::CONSTANT:
                 _results[0] =  m_value;
@@ -307,88 +352,87 @@ public:
                 }
                 break;
             case FunctionType::POWER_BASIS_MONOMIAL:
-                m_monomial.evaluateGrid(_grid, _results);
+                m_monomial.evaluateGrid(_grid, _results, polynomialScratch);
                 break;
-            //case FunctionType::CHEBYSHEV_BASIS_MONOMIAL:  //TODO: Write the specialized base call for CHEBYSHEV_BASIS_MONOMIAL
-            //    break;
             case FunctionType::POWER_BASIS_POLYNOMIAL:
-                m_polynomial.evaluateGrid(_grid, _results);
+                m_polynomial.evaluateGrid(_grid, _results, polynomialScratch);
+                break;
+            case FunctionType::CHEBYSHEV_BASIS_MONOMIAL:
+            case FunctionType::CHEBYSHEV_BASIS_POLYNOMIAL:
+                m_chebyshevPolynomial.evaluateGrid(_grid, _results, polynomialScratch);
                 break;
-            //case FunctionType::CHEBYSHEV_BASIS_POLYNOMIAL:  //TODO: Write the specialized base call for CHEBYSHEV_BASIS_POLYNOMIAL
-            //    break;
             default:
                 printAndThrowRuntimeError("Unknown Function Type Encountered in evaluate grid base! Fix Switch Statement!");
                 break;
         }
     }
 
-    void evaluateGridSimple(size_t _gridSize, std::vector<double>& _results) {
-        //Get the childs evaluations and resize the result vector if needed
-        const std::vector<double>& childEvals = m_subfunctions[0]->getPartialEvals();
-        size_t numEvals = m_evaluateGridInfo[_gridSize].childEvalSize;
+    //Evaluates grid indices [_begin, _end). The result of grid index i goes in _results[i - _resultsOffset].
+    void evaluateGridSimple(size_t _begin, size_t _end, std::vector<double>& _results, size_t _resultsOffset, size_t _threadNum) {
+        //Get the childs evaluations for this range
+        const double* childEvals = m_subfunctions[0]->getPartialEvals(_threadNum).data() + (_begin - m_subfunctions[0]->getGridTileOffset(_threadNum));
+        double* results = _results.data() + (_begin - _resultsOffset);
+        const size_t numEvals = _end - _begin;
 
         //Run the functions over each evaluation
         switch(m_functionType) {
             case FunctionType::SIN:
                 for(size_t i = 0; i < numEvals; i++) {
-                    _results[i] =  m_value * sin(childEvals[i]);
+                    results[i] =  m_value * sin(childEvals[i]);
                 }
                 break;
             case FunctionType::COS:
                 for(size_t i = 0; i < numEvals; i++) {
-                    _results[i] =  m_value * cos(childEvals[i]);
+                    results[i] =  m_value * cos(childEvals[i]);
                 }
                 break;
             case FunctionType::TAN:
                 for(size_t i = 0; i < numEvals; i++) {
-                    _results[i] =  m_value * tan(childEvals[i]);
+                    results[i] =  m_value * tan(childEvals[i]);
                 }
                 break;
             case FunctionType::SINH:
                 for(size_t i = 0; i < numEvals; i++) {
-                    _results[i] =  m_value * sinh(childEvals[i]);
+                    results[i] =  m_value * sinh(childEvals[i]);
                 }
                 break;
             case FunctionType::COSH:
                 for(size_t i = 0; i < numEvals; i++) {
-                    _results[i] =  m_value * cosh(childEvals[i]);
+                    results[i] =  m_value * cosh(childEvals[i]);
                 }
                 break;
             case FunctionType::TANH:
                 for(size_t i = 0; i < numEvals; i++) {
-                    _results[i] =  m_value * tanh(childEvals[i]);
+                    results[i] =  m_value * tanh(childEvals[i]);
                 }
                 break;
             case FunctionType::LOG:
                 for(size_t i = 0; i < numEvals; i++) {
-                    _results[i] =  m_value * log(childEvals[i]);
+                    results[i] =  m_value * log(childEvals[i]);
                 }
                 break;
             case FunctionType::LOG10:
                 for(size_t i = 0; i < numEvals; i++) {
-                    _results[i] =  m_value * log10(childEvals[i]);
+                    results[i] =  m_value * log10(childEvals[i]);
                 }
                 break;
             case FunctionType::LOG2:
                 for(size_t i = 0; i < numEvals; i++) {
-                    _results[i] =  m_value * log2(childEvals[i]);
+                    results[i] =  m_value * log2(childEvals[i]);
                 }
                 break;
             case FunctionType::SQRT:
                 for(size_t i = 0; i < numEvals; i++) {
-                    _results[i] =  m_value * sqrt(childEvals[i]);
+                    results[i] =  m_value * sqrt(childEvals[i]);
                 }
                 break;
             case FunctionType::EXP:
                 for(size_t i = 0; i < numEvals; i++) {
-                    _results[i] =  m_value * exp(childEvals[i]);
+                    results[i] =  m_value * exp(childEvals[i]);
                 }
                 break;
             case FunctionType::CHEBYSHEV:
-                for(size_t i = 0; i < numEvals; i++) {
-                    //TODO: This is inefficient, make a function that does all of them at once.
-                    _results[i] =  m_value * chebPower(childEvals[i], m_varIndex);
-                }
+                chebPowerGrid(childEvals, results, numEvals, m_varIndex, m_value);
                 break;
             default:
                 printAndThrowRuntimeError("Unknown Function Type Encountered in evaluate grid main! Fix Switch Statement!");
@@ -396,36 +440,39 @@ public:
         }
     }
 
-    void evaluateGridCombine(size_t _gridSize, std::vector<double>& _results) {
-        std::vector<std::vector<size_t> >& currSpots = m_evaluateGridInfo[_gridSize].childEvalIndexes;
+    //Evaluates grid indices [_begin, _end). The result of grid index i goes in _results[i - _resultsOffset].
+    void evaluateGridCombine(size_t _gridSize, size_t _begin, size_t _end, std::vector<double>& _results, size_t _resultsOffset, size_t _threadNum) {
+        const std::vector<std::vector<size_t> >& currSpots = m_threadScratch[_threadNum].evaluateGridInfo[_gridSize].childEvalIndexes;
         switch(m_functionType) {
             case FunctionType::POWER: {
-                const std::vector<double>& childEvals1 = m_subfunctions[0]->getPartialEvals();
-                const std::vector<double>& childEvals2 = m_subfunctions[1]->getPartialEvals();
-                for(size_t i = 0; i < currSpots.size(); i++) {
-                    _results[i] =  m_value * pow(childEvals1[currSpots[i][0]], childEvals2[currSpots[i][1]]);
+                const std::vector<double>& childEvals1 = m_subfunctions[0]->getPartialEvals(_threadNum);
+                const std::vector<double>& childEvals2 = m_subfunctions[1]->getPartialEvals(_threadNum);
+                const size_t childOffset1 = m_subfunctions[0]->getGridTileOffset(_threadNum);
+                const size_t childOffset2 = m_subfunctions[1]->getGridTileOffset(_threadNum);
+                for(size_t i = _begin; i < _end; i++) {
+                    _results[i - _resultsOffset] =  m_value * pow(childEvals1[currSpots[i][0] - childOffset1], childEvals2[currSpots[i][1] - childOffset2]);
                 }
                 break;
             }
             case FunctionType::SUM:{
                 double result;
-                for(size_t i = 0; i < currSpots.size(); i++) {
+                for(size_t i = _begin; i < _end; i++) {
                     result = m_value;
                     for(size_t j = 0; j < currSpots[i].size(); j++) {
-                        SIGNCHECKSUM(m_operatorSigns[j], result, m_subfunctions[j]->getPartialEvals()[currSpots[i][j]]);
+                        SIGNCHECKSUM(m_operatorSigns[j], result, m_subfunctions[j]->getPartialEvals(_threadNum)[currSpots[i][j] - m_subfunctions[j]->getGridTileOffset(_threadNum)]);
                     }
-                    _results[i] = result;
+                    _results[i - _resultsOffset] = result;
                 }
                 break;
             }
             case FunctionType::PRODUCT:{
                 double result;
-                for(size_t i = 0; i < currSpots.size(); i++) {
+                for(size_t i = _begin; i < _end; i++) {
                     result = m_value;
                     for(size_t j = 0; j < currSpots[i].size(); j++) {
-                        SIGNCHECKPRODUCT(m_operatorSigns[j], result, m_subfunctions[j]->getPartialEvals()[currSpots[i][j]]);
+                        SIGNCHECKPRODUCT(m_operatorSigns[j], result, m_subfunctions[j]->getPartialEvals(_threadNum)[currSpots[i][j] - m_subfunctions[j]->getGridTileOffset(_threadNum)]);
                     }
-                    _results[i] = result;
+                    _results[i - _resultsOffset] = result;
                 }
                 break;
             }
@@ -435,88 +482,168 @@ public:
         }
     }
     
-    void evaluateGridMain(const std::vector<std::vector<double> >& _grid) {
+    void prepEvaluateGridInfo(size_t _gridSize, size_t _threadNum) {
         //Prep the evaluate grid info if it hasn't already been done
-        size_t gridSize = _grid[0].size();
-        if(unlikely(m_evaluateGridInfo.size() <= gridSize)) {
-            m_evaluateGridInfo.resize(gridSize + 1);
+        FunctionScratch& scratch = m_threadScratch[_threadNum];
+        if(unlikely(scratch.evaluateGridInfo.size() <= _gridSize)) {
+            scratch.evaluateGridInfo.resize(_gridSize + 1);
         }
-        if(unlikely(!m_evaluateGridInfo[gridSize].precomputed)) {
-            prepEvaluatGrid(gridSize, m_evaluateGridInfo[gridSize]);
+        if(unlikely(!scratch.evaluateGridInfo[_gridSize].precomputed)) {
+            prepEvaluatGrid(_gridSize, scratch.evaluateGridInfo[_gridSize]);
+            //Make sure the partial evaluations are big enough
+            if(scratch.partialEvaluations.size() <= scratch.evaluateGridInfo[_gridSize].childEvalSize) {
+                scratch.partialEvaluations.resize(scratch.evaluateGridInfo[_gridSize].childEvalSize);
+            }
         }
+    }
+    
+    //Evaluates grid indices [_begin, _end) for the SIMPLE and COMBINE types.
+    void evaluateGridRange(size_t _gridSize, size_t _begin, size_t _end, std::vector<double>& _results, size_t _resultsOffset, size_t _threadNum) {
+        switch(m_evaluateGridType) {
+            case EvaluateGridType::SIMPLE:
+                evaluateGridSimple(_begin, _end, _results, _resultsOffset, _threadNum);
+                break;
+            case EvaluateGridType::COMBINE:
+                evaluateGridCombine(_gridSize, _begin, _end, _results, _resultsOffset, _threadNum);
+                break;
+            default:
+                printAndThrowRuntimeError("Unknown Function Type Encountered in evaluate grid range! Fix Switch Statement!");
+                break;
+        }
+    }
+
+    void evaluateGridMain(const std::vector<std::vector<double> >& _grid, size_t _threadNum) {
+        size_t gridSize = _grid[0].size();
+        prepEvaluateGridInfo(gridSize, _threadNum);
+        FunctionScratch& scratch = m_threadScratch[_threadNum];
+        scratch.gridTileOffset = 0;
 
         switch(m_evaluateGridType) {
             case EvaluateGridType::BASE:
-                evaluateGridBase(_grid, m_partialEvaluations);
+                evaluateGridBase(_grid, scratch.partialEvaluations, _threadNum);
                 break;
             case EvaluateGridType::SIMPLE:
-                evaluateGridSimple(gridSize, m_partialEvaluations);
-                break;
             case EvaluateGridType::COMBINE:
-                evaluateGridCombine(gridSize, m_partialEvaluations);
+                evaluateGridRange(gridSize, 0, scratch.evaluateGridInfo[gridSize].childEvalSize, scratch.partialEvaluations, 0, _threadNum);
                 break;
             default:
                 printAndThrowRuntimeError("Unknown Function Type Encountered in evaluate grid main! Fix Switch Statement!");
                 break;
         }
     }
+    
+    //True if this function is evaluated a tile at a time in the tiled evaluate grid.
+    //The tiles split up the last dimension, which is the slowest changing one, so each tile is a contiguous block of
+    //the partial evaluations for every function that uses it. Everything else is evaluated once over the whole grid.
+    bool usesGridTiles() const {
+        return m_evaluateGridType != EvaluateGridType::BASE && m_hasDimension[m_rank - 1];
+    }
 
-    void evaluateGridMain(const std::vector<std::vector<double> >& _grid, std::vector<double>& _results) {
+    //Evaluates the tile of the grid where the last dimension is in [_beginSlice, _endSlice).
+    //The results are stored at the start of the partial evaluations, and the grid tile offset is the grid index of the first one.
+    void evaluateGridTile(size_t _gridSize, size_t _beginSlice, size_t _endSlice, size_t _threadNum) {
+        prepEvaluateGridInfo(_gridSize, _threadNum);
+        FunctionScratch& scratch = m_threadScratch[_threadNum];
+        const size_t sliceSize = power(_gridSize, m_numUsedDimensions - 1);
+        scratch.gridTileOffset = _beginSlice * sliceSize;
+        evaluateGridRange(_gridSize, scratch.gridTileOffset, _endSlice * sliceSize, scratch.partialEvaluations, scratch.gridTileOffset, _threadNum);
+    }
+
+    void evaluateGridMain(const std::vector<std::vector<double> >& _grid, std::vector<double>& _results, size_t _threadNum) {
         assert(m_isTopFunction); //This should only be called by the top function.
-        //Prep the evaluate grid info if it hasn't already been done
         size_t gridSize = _grid[0].size();
-        if(unlikely(m_evaluateGridInfo.size() <= gridSize)) {
-            m_evaluateGridInfo.resize(gridSize + 1);
-        }
-        if(unlikely(!m_evaluateGridInfo[gridSize].precomputed)) {
-            prepEvaluatGrid(gridSize, m_evaluateGridInfo[gridSize]);
-        }
+        prepEvaluateGridInfo(gridSize, _threadNum);
+        FunctionScratch& scratch = m_threadScratch[_threadNum];
+        scratch.gridTileOffset = 0;
         
-        //If we are not using all the dimensions, run the evaluations with m_partialEvaluations, then copy it into _results after
+        //If we are not using all the dimensions, run the evaluations with the partial evaluations, then copy it into _results after
         const bool usesAllDims = m_numUsedDimensions == m_rank;
-        std::vector<double>& resultSpot = usesAllDims ? _results : m_partialEvaluations;
+        std::vector<double>& resultSpot = usesAllDims ? _results : scratch.partialEvaluations;
         
         switch(m_evaluateGridType) {
             case EvaluateGridType::BASE:
-                evaluateGridBase(_grid, resultSpot);
+                evaluateGridBase(_grid, resultSpot, _threadNum);
                 break;
             case EvaluateGridType::SIMPLE:
-                evaluateGridSimple(gridSize, resultSpot);
-                break;
             case EvaluateGridType::COMBINE:
-                evaluateGridCombine(gridSize, resultSpot);
+                evaluateGridRange(gridSize, 0, scratch.evaluateGridInfo[gridSize].childEvalSize, resultSpot, 0, _threadNum);
                 break;
             default:
                 printAndThrowRuntimeError("Unknown Function Type Encountered in evaluate grid main! Fix Switch Statement!");
                 break;
         }
         
-        if(!usesAllDims) { //Copy from m_partialEvaluations into _results.
+        if(!usesAllDims) { //Copy from the partial evaluations into _results.
             //For every dim that isn't used,
-            for(size_t i = 0; i < m_evaluateGridInfo[gridSize].topResultMap.size(); i++) {
-                _results[i] = m_partialEvaluations[m_evaluateGridInfo[gridSize].topResultMap[i]];
+            const std::vector<size_t>& topResultMap = scratch.evaluateGridInfo[gridSize].topResultMap;
+            for(size_t i = 0; i < topResultMap.size(); i++) {
+                _results[i] = scratch.partialEvaluations[topResultMap[i]];
+            }
+        }
+    }
+    
+    bool useTiledEvaluateGrid(size_t _gridSize) const {
+        //The top function writes it's tiles straight into the results, so it needs to use every dimension.
+        //If it's a BASE function there aren't any partial evaluations to keep in cache.
+        return m_numUsedDimensions == m_rank && m_evaluateGridType != EvaluateGridType::BASE && power(_gridSize, m_rank) > s_gridTileSize;
+    }
+    
+    //Runs the whole function tree over one tile of the grid before moving on to the next tile.
+    //The results are in the same order as evaluateGrid.
+    void evaluateGridTiled(const std::vector<std::vector<double> >& _grid, std::vector<double>& _results, size_t _threadNum) {
+        const size_t gridSize = _grid[0].size();
+        prepEvaluateGridInfo(gridSize, _threadNum);
+        
+        //Evaluate everything that doesn't depend on the tile once
+        for(size_t level = 0; level < m_allFunctionLevels.size(); level++) {
+            for(auto&& func: m_allFunctionLevels[level]) {
+                if(!func->usesGridTiles()) {
+                    func->evaluateGridMain(_grid, _threadNum);
+                }
             }
         }
+        
+        //Run the tiles. Each one is a range of the last dimension.
+        const size_t sliceSize = power(gridSize, m_rank - 1);
+        const size_t slicesPerTile = sliceSize < s_gridTileSize ? s_gridTileSize / sliceSize : 1;
+        m_threadScratch[_threadNum].gridTileOffset = 0;
+        for(size_t beginSlice = 0; beginSlice < gridSize; beginSlice += slicesPerTile) {
+            const size_t endSlice = std::min(beginSlice + slicesPerTile, gridSize);
+            for(size_t level = 0; level < m_allFunctionLevels.size(); level++) {
+                for(auto&& func: m_allFunctionLevels[level]) {
+                    if(func->usesGridTiles()) {
+                        func->evaluateGridTile(gridSize, beginSlice, endSlice, _threadNum);
+                    }
+                }
+            }
+            evaluateGridRange(gridSize, beginSlice * sliceSize, endSlice * sliceSize, _results, 0, _threadNum);
+        }
     }
     
-    void evaluateGrid(const std::vector<std::vector<double> >& _grid, std::vector<double>& _results) {
+    //Only uses the scratch space of _threadNum, so different threads can evaluate the same function at once.
+    void evaluateGrid(const std::vector<std::vector<double> >& _grid, std::vector<double>& _results, size_t _threadNum = 0) {
         //Evaluates the grid so that the evaluation of (grid[0][i], grid[1][j]) is in _results[j+grid.size() + i]
         
-        //Create the function tree to evaluate.
+        //Create the function tree to evaluate. With more than one thread this was already done in addThreadFunctions.
         if(unlikely(!m_isTopFunction)) {
-            m_isTopFunction = true;
-            getFunctionLevels(m_allFunctionLevels);
+            setAsTopFunction();
+        }
+        
+        //Big grids are done a tile at a time so the partial evaluations stay in cache
+        if(useTiledEvaluateGrid(_grid[0].size())) {
+            evaluateGridTiled(_grid, _results, _threadNum);
+            return;
         }
         
         //Call everything level by level
         for(size_t level = 0; level < m_allFunctionLevels.size(); level++) {
             for(auto&& func: m_allFunctionLevels[level]) {
-                func->evaluateGridMain(_grid);
+                func->evaluateGridMain(_grid, _threadNum);
             }
         }
         
         //Now call this top function.
-        evaluateGridMain(_grid, _results);
+        evaluateGridMain(_grid, _results, _threadNum);
         return;
 
         //This is the old code, it can still be run with the assert statement to  gives the same results.
@@ -557,108 +684,852 @@ public:
         }
     }
 
-    template<typename ReturnType>
-    ReturnType evaluate(const std::vector<double>& _inputPoints) {
+    //Only uses the scratch space of _threadNum, so different threads can evaluate the same function at once.
+    //The inputs are doubles, RoundedIntervals to get an interval containing the function on a box, or DualNumbers to get
+    //a directional derivative.
+    template<typename ReturnType, typename InputType = double>
+    ReturnType evaluate(const std::vector<InputType>& _inputPoints, size_t _threadNum = 0) {
         switch(m_functionType) {
             case FunctionType::SIN:
-                return static_cast<ReturnType>(m_value) * sin(m_subfunctions[0]->evaluate<ReturnType>(_inputPoints));
+                return static_cast<ReturnType>(m_value) * sin(m_subfunctions[0]->evaluate<ReturnType>(_inputPoints, _threadNum));
             case FunctionType::COS:
-                return static_cast<ReturnType>(m_value) * cos(m_subfunctions[0]->evaluate<ReturnType>(_inputPoints));
+                return static_cast<ReturnType>(m_value) * cos(m_subfunctions[0]->evaluate<ReturnType>(_inputPoints, _threadNum));
             case FunctionType::TAN:
-                return static_cast<ReturnType>(m_value) * tan(m_subfunctions[0]->evaluate<ReturnType>(_inputPoints));
+                return static_cast<ReturnType>(m_value) * tan(m_subfunctions[0]->evaluate<ReturnType>(_inputPoints, _threadNum));
             case FunctionType::SINH:
-                return static_cast<ReturnType>(m_value) * sinh(m_subfunctions[0]->evaluate<ReturnType>(_inputPoints));
+                return static_cast<ReturnType>(m_value) * sinh(m_subfunctions[0]->evaluate<ReturnType>(_inputPoints, _threadNum));
             case FunctionType::COSH:
-                return static_cast<ReturnType>(m_value) * cosh(m_subfunctions[0]->evaluate<ReturnType>(_inputPoints));
+                return static_cast<ReturnType>(m_value) * cosh(m_subfunctions[0]->evaluate<ReturnType>(_inputPoints, _threadNum));
             case FunctionType::TANH:
-                return static_cast<ReturnType>(m_value) * tanh(m_subfunctions[0]->evaluate<ReturnType>(_inputPoints));
+                return static_cast<ReturnType>(m_value) * tanh(m_subfunctions[0]->evaluate<ReturnType>(_inputPoints, _threadNum));
             case FunctionType::LOG:
-                return static_cast<ReturnType>(m_value) * log(m_subfunctions[0]->evaluate<ReturnType>(_inputPoints));
+                return static_cast<ReturnType>(m_value) * log(m_subfunctions[0]->evaluate<ReturnType>(_inputPoints, _threadNum));
             case FunctionType::LOG10:
-                return static_cast<ReturnType>(m_value) * log10(m_subfunctions[0]->evaluate<ReturnType>(_inputPoints));
+                return static_cast<ReturnType>(m_value) * log10(m_subfunctions[0]->evaluate<ReturnType>(_inputPoints, _threadNum));
             case FunctionType::LOG2:
-                return static_cast<ReturnType>(m_value) * log2(m_subfunctions[0]->evaluate<ReturnType>(_inputPoints));
+                return static_cast<ReturnType>(m_value) * log2(m_subfunctions[0]->evaluate<ReturnType>(_inputPoints, _threadNum));
             case FunctionType::POWER:
-                return static_cast<ReturnType>(m_value) * pow(m_subfunctions[0]->evaluate<ReturnType>(_inputPoints), m_subfunctions[1]->evaluate<ReturnType>(_inputPoints));
+                return static_cast<ReturnType>(m_value) * pow(m_subfunctions[0]->evaluate<ReturnType>(_inputPoints, _threadNum), m_subfunctions[1]->evaluate<ReturnType>(_inputPoints, _threadNum));
             case FunctionType::SQRT:
-                return static_cast<ReturnType>(m_value) * sqrt(m_subfunctions[0]->evaluate<ReturnType>(_inputPoints));
+                return static_cast<ReturnType>(m_value) * sqrt(m_subfunctions[0]->evaluate<ReturnType>(_inputPoints, _threadNum));
             case FunctionType::EXP:
-                return static_cast<ReturnType>(m_value) * exp(m_subfunctions[0]->evaluate<ReturnType>(_inputPoints));
+                return static_cast<ReturnType>(m_value) * exp(m_subfunctions[0]->evaluate<ReturnType>(_inputPoints, _threadNum));
             case FunctionType::CONSTANT:
                 return static_cast<ReturnType>(m_value);
             case FunctionType::POWER_BASIS_POLYNOMIAL:
-                return m_polynomial.evaluate<ReturnType>(_inputPoints);
-            //case FunctionType::CHEBYSHEV_BASIS_POLYNOMIAL:
-            //    break;
+                return m_polynomial.evaluate<ReturnType>(_inputPoints, m_threadScratch[_threadNum].polynomialScratch);
+            case FunctionType::CHEBYSHEV_BASIS_POLYNOMIAL:
+                return m_chebyshevPolynomial.evaluate<ReturnType>(_inputPoints, m_threadScratch[_threadNum].polynomialScratch);
             case FunctionType::SUM:
-                return sumEval<ReturnType>(_inputPoints);
+                return sumEval<ReturnType>(_inputPoints, _threadNum);
             case FunctionType::PRODUCT:
-                return productEval<ReturnType>(_inputPoints);
+                return productEval<ReturnType>(_inputPoints, _threadNum);
             case FunctionType::POWER_BASIS_MONOMIAL:
                 return m_monomial.evaluate<ReturnType>(_inputPoints);
-            //case FunctionType::CHEBYSHEV_BASIS_MONOMIAL:
-            //    return chebyshevMonomialEval<ReturnType>(_inputPoints);
+            case FunctionType::CHEBYSHEV_BASIS_MONOMIAL:
+                return m_chebyshevPolynomial.evaluate<ReturnType>(_inputPoints, m_threadScratch[_threadNum].polynomialScratch);
             case FunctionType::CHEBYSHEV:
-                return static_cast<ReturnType>(m_value) * chebPower(m_subfunctions[0]->evaluate<ReturnType>(_inputPoints), m_varIndex);
+                return static_cast<ReturnType>(m_value) * chebPower(m_subfunctions[0]->evaluate<ReturnType>(_inputPoints, _threadNum), m_varIndex);
             case FunctionType::VARIABLE:
                 return static_cast<ReturnType>(m_value) * ((ReturnType)_inputPoints[m_varIndex]);
             default:
                 printAndThrowRuntimeError("Unknown Function Type Encountered in evaluate! Fix Switch Statement!");
                 break;
         }
-        return 0.0;
+        return 0.0;
+    }
+    
+    //Evaluates the function at a batch of points, where _points[dim][i] is coordinate dim of point i.
+    //The result for point i goes in _results[i]. Each function in the tree is run once over the whole batch instead
+    //of recursing through the tree once per point. Gives the same results as calling evaluate on each point.
+    template<typename ReturnType>
+    void evaluateBatch(const std::vector<std::vector<double> >& _points, std::vector<ReturnType>& _results, size_t _threadNum = 0) {
+        //Create the function tree to evaluate. With more than one thread this was already done in addThreadFunctions.
+        if(unlikely(!m_isTopFunction)) {
+            setAsTopFunction();
+        }
+        const size_t numPoints = _points[0].size();
+        if(_results.size() < numPoints) {
+            _results.resize(numPoints);
+        }
+        
+        //Call everything level by level
+        for(size_t level = 0; level < m_allFunctionLevels.size(); level++) {
+            for(auto&& func: m_allFunctionLevels[level]) {
+                std::vector<ReturnType>& batchEvaluations = func->m_threadScratch[_threadNum].template getBatchEvaluations<ReturnType>();
+                if(batchEvaluations.size() < numPoints) {
+                    batchEvaluations.resize(numPoints);
+                }
+                func->evaluateBatchMain<ReturnType>(_points, numPoints, batchEvaluations.data(), _threadNum);
+            }
+        }
+        
+        //Now call this top function.
+        evaluateBatchMain<ReturnType>(_points, numPoints, _results.data(), _threadNum);
+    }
+    
+    template<typename ReturnType>
+    const std::vector<ReturnType>& getBatchEvals(size_t _threadNum) {
+        return m_threadScratch[_threadNum].template getBatchEvaluations<ReturnType>();
+    }
+    
+    //Evaluates the grid like evaluateGrid, and bounds the error of every evaluation like evaluate<ErrorTracker> does.
+    //The values and errors are kept in separate arrays and each function in the tree is run once over the whole grid.
+    //Polynomials get one error bound for the whole grid from the largest absolute value on each axis.
+    //Evaluations that can't be bounded, like dividing by something that might be 0, get an infinite error.
+    void evaluateGridWithErrors(const std::vector<std::vector<double> >& _grid, std::vector<double>& _results, std::vector<double>& _errors, size_t _threadNum = 0) {
+        //Create the function tree to evaluate. With more than one thread this was already done in addThreadFunctions.
+        if(unlikely(!m_isTopFunction)) {
+            setAsTopFunction();
+        }
+        const size_t gridSize = _grid[0].size();
+        const size_t numResults = power(gridSize, m_rank);
+        if(_errors.size() < numResults) {
+            _errors.resize(numResults);
+        }
+        
+        //The largest absolute value on each axis, for the polynomial error bounds
+        std::vector<double>& gridMaxAbsValues = m_threadScratch[_threadNum].gridMaxAbsValues;
+        gridMaxAbsValues.resize(_grid.size());
+        for(size_t dim = 0; dim < _grid.size(); dim++) {
+            gridMaxAbsValues[dim] = 0;
+            for(size_t i = 0; i < gridSize; i++) {
+                gridMaxAbsValues[dim] = std::max(gridMaxAbsValues[dim], std::abs(_grid[dim][i]));
+            }
+        }
+        
+        //Call everything level by level, and then this top function.
+        for(size_t level = 0; level < m_allFunctionLevels.size(); level++) {
+            for(auto&& func: m_allFunctionLevels[level]) {
+                func->evaluateGridWithErrorsMain(_grid, gridMaxAbsValues, _threadNum);
+            }
+        }
+        evaluateGridWithErrorsMain(_grid, gridMaxAbsValues, _threadNum);
+        
+        //Copy from the partial evaluations into the results
+        FunctionScratch& scratch = m_threadScratch[_threadNum];
+        if(m_numUsedDimensions == m_rank) {
+            std::copy(scratch.partialEvaluations.begin(), scratch.partialEvaluations.begin() + numResults, _results.begin());
+            std::copy(scratch.partialErrors.begin(), scratch.partialErrors.begin() + numResults, _errors.begin());
+        }
+        else {
+            const std::vector<size_t>& topResultMap = scratch.evaluateGridInfo[gridSize].topResultMap;
+            for(size_t i = 0; i < topResultMap.size(); i++) {
+                _results[i] = scratch.partialEvaluations[topResultMap[i]];
+                _errors[i] = scratch.partialErrors[topResultMap[i]];
+            }
+        }
+    }
+    
+private:
+    void evaluateGridWithErrorsMain(const std::vector<std::vector<double> >& _grid, const std::vector<double>& _gridMaxAbsValues, size_t _threadNum) {
+        const size_t gridSize = _grid[0].size();
+        prepEvaluateGridInfo(gridSize, _threadNum);
+        FunctionScratch& scratch = m_threadScratch[_threadNum];
+        scratch.gridTileOffset = 0;
+        const size_t numEvals = scratch.evaluateGridInfo[gridSize].childEvalSize;
+        if(scratch.partialErrors.size() < numEvals) {
+            scratch.partialErrors.resize(numEvals);
+        }
+        
+        double* results = scratch.partialEvaluations.data();
+        double* errors = scratch.partialErrors.data();
+        switch(m_evaluateGridType) {
+            case EvaluateGridType::BASE:
+                evaluateGridBase(_grid, scratch.partialEvaluations, _threadNum);
+                evaluateGridBaseErrors(_grid, _gridMaxAbsValues, numEvals, errors);
+                break;
+            case EvaluateGridType::SIMPLE:
+                evaluateGridSimpleWithErrors(numEvals, results, errors, _threadNum);
+                break;
+            case EvaluateGridType::COMBINE:
+                evaluateGridCombineWithErrors(gridSize, numEvals, results, errors, _threadNum);
+                break;
+            default:
+                printAndThrowRuntimeError("Unknown Function Type Encountered in evaluate grid with errors! Fix Switch Statement!");
+                break;
+        }
+    }
+    
+    void evaluateGridBaseErrors(const std::vector<std::vector<double> >& _grid, const std::vector<double>& _gridMaxAbsValues, size_t _numEvals, double* _errors) {
+        switch(m_functionType) {
+            case FunctionType::CONSTANT:
+                _errors[0] = ErrorTracker(m_value).error;
+                break;
+            case FunctionType::VARIABLE: {
+                const ErrorTracker value(m_value);
+                for(size_t i = 0; i < _numEvals; i++) {
+                    _errors[i] = (value * ErrorTracker(_grid[m_varIndex][i])).error;
+                }
+                break;
+            }
+            case FunctionType::POWER_BASIS_MONOMIAL:
+                std::fill(_errors, _errors + _numEvals, m_monomial.getEvaluationErrorBound(_gridMaxAbsValues));
+                break;
+            case FunctionType::POWER_BASIS_POLYNOMIAL:
+                std::fill(_errors, _errors + _numEvals, m_polynomial.getEvaluationErrorBound(_gridMaxAbsValues));
+                break;
+            case FunctionType::CHEBYSHEV_BASIS_MONOMIAL:
+            case FunctionType::CHEBYSHEV_BASIS_POLYNOMIAL:
+                std::fill(_errors, _errors + _numEvals, m_chebyshevPolynomial.getEvaluationErrorBound(_gridMaxAbsValues));
+                break;
+            default:
+                printAndThrowRuntimeError("Unknown Function Type Encountered in evaluate grid base errors! Fix Switch Statement!");
+                break;
+        }
+    }
+    
+    //Runs m_value * _operation over the child's evaluations in ErrorTracker arithmetic.
+    template<typename Operation>
+    void evaluateGridSimpleWithErrors(size_t _numEvals, double* _results, double* _errors, size_t _threadNum, Operation _operation) {
+        const double* childEvals = m_subfunctions[0]->getPartialEvals(_threadNum).data();
+        const double* childErrors = m_subfunctions[0]->getPartialErrors(_threadNum).data();
+        const ErrorTracker value(m_value);
+        for(size_t i = 0; i < _numEvals; i++) {
+            const ErrorTracker result = value * _operation(ErrorTracker(childEvals[i], childErrors[i]));
+            _results[i] = result.value;
+            _errors[i] = result.error;
+        }
+    }
+    
+    void evaluateGridSimpleWithErrors(size_t _numEvals, double* _results, double* _errors, size_t _threadNum) {
+        switch(m_functionType) {
+            case FunctionType::SIN:
+                evaluateGridSimpleWithErrors(_numEvals, _results, _errors, _threadNum, [](const ErrorTracker& x) {return sin(x);});
+                break;
+            case FunctionType::COS:
+                evaluateGridSimpleWithErrors(_numEvals, _results, _errors, _threadNum, [](const ErrorTracker& x) {return cos(x);});
+                break;
+            case FunctionType::TAN:
+                evaluateGridSimpleWithErrors(_numEvals, _results, _errors, _threadNum, [](const ErrorTracker& x) {
+                    const ErrorTracker cosine = cos(x);
+                    if(cosine.error >= std::abs(cosine.value)) {
+                        //Too close to a pole to bound
+                        return ErrorTracker(tan(x.value), std::numeric_limits<double>::infinity());
+                    }
+                    return sin(x) / cosine;
+                });
+                break;
+            case FunctionType::SINH:
+                evaluateGridSimpleWithErrors(_numEvals, _results, _errors, _threadNum, [](const ErrorTracker& x) {return sinh(x);});
+                break;
+            case FunctionType::COSH:
+                evaluateGridSimpleWithErrors(_numEvals, _results, _errors, _threadNum, [](const ErrorTracker& x) {return cosh(x);});
+                break;
+            case FunctionType::TANH:
+                evaluateGridSimpleWithErrors(_numEvals, _results, _errors, _threadNum, [](const ErrorTracker& x) {return tanh(x);});
+                break;
+            case FunctionType::LOG:
+                evaluateGridSimpleWithErrors(_numEvals, _results, _errors, _threadNum, [](const ErrorTracker& x) {return log(x);});
+                break;
+            case FunctionType::LOG10:
+                evaluateGridSimpleWithErrors(_numEvals, _results, _errors, _threadNum, [](const ErrorTracker& x) {return log10(x);});
+                break;
+            case FunctionType::LOG2:
+                evaluateGridSimpleWithErrors(_numEvals, _results, _errors, _threadNum, [](const ErrorTracker& x) {return log2(x);});
+                break;
+            case FunctionType::SQRT:
+                evaluateGridSimpleWithErrors(_numEvals, _results, _errors, _threadNum, [](const ErrorTracker& x) {return sqrt(x);});
+                break;
+            case FunctionType::EXP:
+                evaluateGridSimpleWithErrors(_numEvals, _results, _errors, _threadNum, [](const ErrorTracker& x) {return exp(x);});
+                break;
+            case FunctionType::CHEBYSHEV: {
+                //The values come from the faster grid recurrence, only the errors need the ErrorTracker recurrence.
+                const double* childEvals = m_subfunctions[0]->getPartialEvals(_threadNum).data();
+                const double* childErrors = m_subfunctions[0]->getPartialErrors(_threadNum).data();
+                const ErrorTracker value(m_value);
+                chebPowerGrid(childEvals, _results, _numEvals, m_varIndex, m_value);
+                for(size_t i = 0; i < _numEvals; i++) {
+                    _errors[i] = (value * chebPower(ErrorTracker(childEvals[i], childErrors[i]), m_varIndex)).error;
+                }
+                break;
+            }
+            default:
+                printAndThrowRuntimeError("Unknown Function Type Encountered in evaluate grid simple with errors! Fix Switch Statement!");
+                break;
+        }
+    }
+    
+    void evaluateGridCombineWithErrors(size_t _gridSize, size_t _numEvals, double* _results, double* _errors, size_t _threadNum) {
+        const std::vector<std::vector<size_t> >& currSpots = m_threadScratch[_threadNum].evaluateGridInfo[_gridSize].childEvalIndexes;
+        const ErrorTracker value(m_value);
+        switch(m_functionType) {
+            case FunctionType::POWER: {
+                const double* childEvals1 = m_subfunctions[0]->getPartialEvals(_threadNum).data();
+                const double* childEvals2 = m_subfunctions[1]->getPartialEvals(_threadNum).data();
+                const double* childErrors1 = m_subfunctions[0]->getPartialErrors(_threadNum).data();
+                const double* childErrors2 = m_subfunctions[1]->getPartialErrors(_threadNum).data();
+                for(size_t i = 0; i < _numEvals; i++) {
+                    const ErrorTracker base(childEvals1[currSpots[i][0]], childErrors1[currSpots[i][0]]);
+                    const ErrorTracker exponent(childEvals2[currSpots[i][1]], childErrors2[currSpots[i][1]]);
+                    if(base.value < 0 && exponent.error != 0) {
+                        //A negative base to an inexact power can't be bounded
+                        _results[i] = m_value * pow(base.value, exponent.value);
+                        _errors[i] = std::numeric_limits<double>::infinity();
+                        continue;
+                    }
+                    const ErrorTracker result = value * pow(base, exponent);
+                    _results[i] = result.value;
+                    _errors[i] = result.error;
+                }
+                break;
+            }
+            case FunctionType::SUM: {
+                for(size_t i = 0; i < _numEvals; i++) {
+                    ErrorTracker result = value;
+                    for(size_t j = 0; j < currSpots[i].size(); j++) {
+                        const size_t childSpot = currSpots[i][j];
+                        SIGNCHECKSUM(m_operatorSigns[j], result, ErrorTracker(m_subfunctions[j]->getPartialEvals(_threadNum)[childSpot], m_subfunctions[j]->getPartialErrors(_threadNum)[childSpot]));
+                    }
+                    _results[i] = result.value;
+                    _errors[i] = result.error;
+                }
+                break;
+            }
+            case FunctionType::PRODUCT: {
+                for(size_t i = 0; i < _numEvals; i++) {
+                    ErrorTracker result = value;
+                    for(size_t j = 0; j < currSpots[i].size(); j++) {
+                        const size_t childSpot = currSpots[i][j];
+                        const ErrorTracker child(m_subfunctions[j]->getPartialEvals(_threadNum)[childSpot], m_subfunctions[j]->getPartialErrors(_threadNum)[childSpot]);
+                        if(m_operatorSigns[j]) {
+                            result *= child;
+                        }
+                        else if(child.error < std::abs(child.value)) {
+                            result /= child;
+                        }
+                        else {
+                            //Dividing by something that might be 0 can't be bounded
+                            result.value /= child.value;
+                            result.error = std::numeric_limits<double>::infinity();
+                        }
+                    }
+                    _results[i] = result.value;
+                    _errors[i] = result.error;
+                }
+                break;
+            }
+            default:
+                printAndThrowRuntimeError("Unknown Function Type Encountered in evaluate grid combine with errors! Fix Switch Statement!");
+                break;
+        }
+    }
+    
+    template<typename ReturnType>
+    void evaluateBatchMain(const std::vector<std::vector<double> >& _points, size_t _numPoints, ReturnType* _results, size_t _threadNum) {
+        const ReturnType value = static_cast<ReturnType>(m_value);
+        const ReturnType* childEvals = m_subfunctions.size() > 0 ? m_subfunctions[0]->getBatchEvals<ReturnType>(_threadNum).data() : nullptr;
+        switch(m_functionType) {
+            case FunctionType::SIN:
+                for(size_t i = 0; i < _numPoints; i++) {
+                    _results[i] = value * sin(childEvals[i]);
+                }
+                break;
+            case FunctionType::COS:
+                for(size_t i = 0; i < _numPoints; i++) {
+                    _results[i] = value * cos(childEvals[i]);
+                }
+                break;
+            case FunctionType::TAN:
+                for(size_t i = 0; i < _numPoints; i++) {
+                    _results[i] = value * tan(childEvals[i]);
+                }
+                break;
+            case FunctionType::SINH:
+                for(size_t i = 0; i < _numPoints; i++) {
+                    _results[i] = value * sinh(childEvals[i]);
+                }
+                break;
+            case FunctionType::COSH:
+                for(size_t i = 0; i < _numPoints; i++) {
+                    _results[i] = value * cosh(childEvals[i]);
+                }
+                break;
+            case FunctionType::TANH:
+                for(size_t i = 0; i < _numPoints; i++) {
+                    _results[i] = value * tanh(childEvals[i]);
+                }
+                break;
+            case FunctionType::LOG:
+                for(size_t i = 0; i < _numPoints; i++) {
+                    _results[i] = value * log(childEvals[i]);
+                }
+                break;
+            case FunctionType::LOG10:
+                for(size_t i = 0; i < _numPoints; i++) {
+                    _results[i] = value * log10(childEvals[i]);
+                }
+                break;
+            case FunctionType::LOG2:
+                for(size_t i = 0; i < _numPoints; i++) {
+                    _results[i] = value * log2(childEvals[i]);
+                }
+                break;
+            case FunctionType::SQRT:
+                for(size_t i = 0; i < _numPoints; i++) {
+                    _results[i] = value * sqrt(childEvals[i]);
+                }
+                break;
+            case FunctionType::EXP:
+                for(size_t i = 0; i < _numPoints; i++) {
+                    _results[i] = value * exp(childEvals[i]);
+                }
+                break;
+            case FunctionType::CHEBYSHEV:
+                for(size_t i = 0; i < _numPoints; i++) {
+                    _results[i] = value * chebPower(childEvals[i], m_varIndex);
+                }
+                break;
+            case FunctionType::POWER: {
+                const ReturnType* childEvals2 = m_subfunctions[1]->getBatchEvals<ReturnType>(_threadNum).data();
+                for(size_t i = 0; i < _numPoints; i++) {
+                    _results[i] = value * pow(childEvals[i], childEvals2[i]);
+                }
+                break;
+            }
+            case FunctionType::SUM:
+                std::fill(_results, _results + _numPoints, value);
+                for(size_t j = 0; j < m_subfunctions.size(); j++) {
+                    const ReturnType* subEvals = m_subfunctions[j]->getBatchEvals<ReturnType>(_threadNum).data();
+                    for(size_t i = 0; i < _numPoints; i++) {
+                        SIGNCHECKSUM(m_operatorSigns[j], _results[i], subEvals[i]);
+                    }
+                }
+                break;
+            case FunctionType::PRODUCT:
+                std::fill(_results, _results + _numPoints, value);
+                for(size_t j = 0; j < m_subfunctions.size(); j++) {
+                    const ReturnType* subEvals = m_subfunctions[j]->getBatchEvals<ReturnType>(_threadNum).data();
+                    for(size_t i = 0; i < _numPoints; i++) {
+                        SIGNCHECKPRODUCT(m_operatorSigns[j], _results[i], subEvals[i]);
+                    }
+                }
+                break;
+            case FunctionType::CONSTANT:
+                std::fill(_results, _results + _numPoints, value);
+                break;
+            case FunctionType::VARIABLE: {
+                const std::vector<double>& variablePoints = _points[m_varIndex];
+                for(size_t i = 0; i < _numPoints; i++) {
+                    _results[i] = value * ((ReturnType)variablePoints[i]);
+                }
+                break;
+            }
+            case FunctionType::POWER_BASIS_POLYNOMIAL:
+            case FunctionType::POWER_BASIS_MONOMIAL:
+            case FunctionType::CHEBYSHEV_BASIS_POLYNOMIAL:
+            case FunctionType::CHEBYSHEV_BASIS_MONOMIAL: {
+                //The polynomials already evaluate all their terms together, so gather one point at a time.
+                FunctionScratch& scratch = m_threadScratch[_threadNum];
+                scratch.batchPoint.resize(m_rank);
+                for(size_t i = 0; i < _numPoints; i++) {
+                    for(size_t dim = 0; dim < m_rank; dim++) {
+                        scratch.batchPoint[dim] = _points[dim][i];
+                    }
+                    _results[i] = evaluate<ReturnType>(scratch.batchPoint, _threadNum);
+                }
+                break;
+            }
+            default:
+                printAndThrowRuntimeError("Unknown Function Type Encountered in evaluate batch! Fix Switch Statement!");
+                break;
+        }
+    }
+        
+private:
+    void functionParse(std::string _functionString) { //Don't pass by reference, as we change it.
+        //GRAMMER:
+        // ( and ) make subfunctions
+        // +,-,*,/,^ are math symbols
+        //numbers, e, pi are constants
+        //Everything else must be a FunctionType, string variable name, or subfunction name
+
+        //Large polynomials are parsed straight into monomials in one pass instead of being split up recursively.
+        if(parsePolynomialString(_functionString)) {
+            return;
+        }
+
+        //Remove excess parenthesis surrounding the entire function.
+        removeExtraParenthesis(_functionString);
+        
+        //To start, split on +-.
+        std::vector<std::string> subparts;
+        splitSum(_functionString, subparts, m_operatorSigns);
+        
+        if(subparts.size() == 0) { //This is an empty string! Something went wrong
+            printAndThrowRuntimeError("Error Parsing Functions! Found Empty string in recursive step!");
+        }
+        //If m_operatorSigns[0] is false, then the function is of the form -<expression>. This must be parsed as a sum type.
+        else if(subparts.size() == 1 && m_operatorSigns[0]) {
+            //Reparse to split on */
+            subparts.clear();
+            m_operatorSigns.clear();
+            splitProduct(_functionString, subparts, m_operatorSigns);
+            
+            if(subparts.size() == 1) {
+                //Reparse to splt on ^
+                subparts.clear();
+                m_operatorSigns.clear();
+                splitPower(_functionString, subparts);
+
+                if(subparts.size() == 1) { //This is a more complex type.
+                    parseComplexType(_functionString);
+                }
+                else { //Make this a POWER type and split it up
+                    parsePower(subparts);
+                }
+            }
+            else { //Make this a PRODUCT type and split it up
+                parseProduct(subparts);
+            }
+        }
+        else { //Make this a SUM type and split it up
+            parseSum(subparts);
+        }
+        
+        //Make simplifications that will make calculations easier in the future.
+        simplifyExpressions();
+    }
+
+    //The polynomial fast path. The string is read once from left to right with one parse function per level of
+    //precedence, sums then products then powers, so no substrings or subfunctions are made. Each level follows the
+    //same rules as splitSum/splitProduct/splitPower and simplifyExpressions, so the result is exactly what the
+    //recursive parse would give. Anything that isn't a polynomial in the variables returns false and gets parsed
+    //the normal way, which is also where all the parse errors come from.
+    bool parsePolynomialString(const std::string& _functionString) {
+        const char* position = _functionString.data();
+        const char* end = position + _functionString.length();
+        PolynomialParseTerm result;
+        if(!parsePolynomialSum(position, end, result) || position != end) {
+            return false;
+        }
+
+        switch(result.type) {
+            case FunctionType::POWER_BASIS_MONOMIAL:
+                m_functionType = FunctionType::POWER_BASIS_MONOMIAL;
+                m_value = result.value;
+                m_monomial = result.monomial;
+                m_monomial.prepEvaluation();
+                return true;
+            case FunctionType::POWER_BASIS_POLYNOMIAL:
+                m_functionType = FunctionType::POWER_BASIS_POLYNOMIAL;
+                m_value = result.value;
+                m_polynomial.clear();
+                m_polynomial.addMonomials(result.monomials);
+                return true;
+            default:
+                //Constants and variables are quick to parse the normal way.
+                return false;
+        }
+    }
+
+    bool parsePolynomialSum(const char*& _position, const char* _end, PolynomialParseTerm& _result) {
+        //A leading - makes this a sum even with one term. A leading + fails in splitSum, so leave it to that.
+        bool isSum = false;
+        bool currentIsSum = true;
+        if(_position != _end && *_position == CHAR::MINUS) {
+            isSum = true;
+            currentIsSum = false;
+            _position++;
+        }
+        PolynomialParseTerm term;
+        if(!parsePolynomialProduct(_position, _end, term)) {
+            return false;
+        }
+        if(!isSum && (_position == _end || (*_position != CHAR::PLUS && *_position != CHAR::MINUS))) {
+            _result = std::move(term);
+            return true;
+        }
+
+        //Pull the constants out and gather the monomials to add, like simplifyExpressions does for a SUM.
+        double constant = 0;
+        std::vector<Monomial> toAdd;
+        while(true) {
+            switch(term.type) {
+                case FunctionType::CONSTANT:
+                    SIGNCHECKSUM(currentIsSum, constant, term.value);
+                    break;
+                case FunctionType::VARIABLE:
+                    toAdd.emplace_back();
+                    toAdd.back().clear(m_rank);
+                    toAdd.back().coeff = term.value * (currentIsSum ? 1.0 : -1.0);
+                    toAdd.back().spot[term.varIndex] = 1;
+                    break;
+                case FunctionType::POWER_BASIS_MONOMIAL:
+                    toAdd.push_back(std::move(term.monomial));
+                    if(!currentIsSum) {
+                        toAdd.back().coeff *= -1;
+                    }
+                    break;
+                default: //POWER_BASIS_POLYNOMIAL
+                    for(Monomial& m : term.monomials) {
+                        toAdd.push_back(std::move(m));
+                        if(!currentIsSum) {
+                            toAdd.back().coeff *= -1;
+                        }
+                    }
+                    break;
+            }
+            if(_position == _end || (*_position != CHAR::PLUS && *_position != CHAR::MINUS)) {
+                break;
+            }
+            currentIsSum = *_position == CHAR::PLUS;
+            _position++;
+            //Repeated signs and trailing signs are left to splitSum.
+            if(_position == _end || *_position == CHAR::PLUS || *_position == CHAR::MINUS) {
+                return false;
+            }
+            if(!parsePolynomialProduct(_position, _end, term)) {
+                return false;
+            }
+        }
+
+        _result.value = constant;
+        if(toAdd.size() == 0) {
+            _result.type = FunctionType::CONSTANT;
+            return true;
+        }
+        //The constant goes in first, then everything else in order.
+        Polynomial polynomial(m_rank);
+        if(constant != 0.0) {
+            Monomial constantTerm;
+            constantTerm.clear(m_rank);
+            constantTerm.coeff = constant;
+            polynomial.addMonomial(constantTerm);
+        }
+        polynomial.addMonomials(toAdd);
+        _result.type = FunctionType::POWER_BASIS_POLYNOMIAL;
+        _result.monomials.assign(polynomial.getMonomials().begin(), polynomial.getMonomials().end());
+        return true;
+    }
+
+    bool parsePolynomialProduct(const char*& _position, const char* _end, PolynomialParseTerm& _result) {
+        PolynomialParseTerm factor;
+        if(!parsePolynomialPower(_position, _end, factor)) {
+            return false;
+        }
+        if(_position == _end || (*_position != CHAR::TIMES && *_position != CHAR::DIVIDE)) {
+            _result = std::move(factor);
+            return true;
+        }
+
+        //Pull the constants out, the rest must be multiplied monomials and at most one polynomial.
+        double constant = 1;
+        bool currentIsMultiply = true;
+        std::vector<PolynomialParseTerm> factors;
+        int polySpot = -1;
+        while(true) {
+            if(factor.type == FunctionType::CONSTANT) {
+                SIGNCHECKPRODUCT(currentIsMultiply, constant, factor.value);
+            }
+            else {
+                if(!currentIsMultiply) {
+                    return false;
+                }
+                if(factor.type == FunctionType::POWER_BASIS_POLYNOMIAL) {
+                    if(polySpot != -1) {
+                        return false;
+                    }
+                    polySpot = static_cast<int>(factors.size());
+                }
+                factors.push_back(std::move(factor));
+            }
+            if(_position == _end || (*_position != CHAR::TIMES && *_position != CHAR::DIVIDE)) {
+                break;
+            }
+            currentIsMultiply = *_position == CHAR::TIMES;
+            _position++;
+            if(!parsePolynomialPower(_position, _end, factor)) {
+                return false;
+            }
+        }
+
+        _result.value = constant;
+        if(factors.size() == 0) {
+            _result.type = FunctionType::CONSTANT;
+        }
+        else if(polySpot == -1) {
+            _result.type = FunctionType::POWER_BASIS_MONOMIAL;
+            _result.monomial.clear(m_rank);
+            _result.monomial.coeff = constant;
+            for(const PolynomialParseTerm& term : factors) {
+                if(term.type == FunctionType::POWER_BASIS_MONOMIAL) {
+                    _result.monomial *= term.monomial;
+                }
+                else { //VARIABLE
+                    _result.monomial.coeff *= term.value;
+                    _result.monomial.spot[term.varIndex] += 1;
+                }
+            }
+        }
+        else {
+            //Multiplying every monomial by the same thing keeps them sorted.
+            _result.type = FunctionType::POWER_BASIS_POLYNOMIAL;
+            _result.monomials = std::move(factors[polySpot].monomials);
+            if(constant != 1.0) {
+                for(Monomial& m : _result.monomials) {
+                    m.coeff *= constant;
+                }
+            }
+            for(size_t funcNum = 0; funcNum < factors.size(); funcNum++) {
+                if(static_cast<int>(funcNum) == polySpot) {
+                    continue;
+                }
+                const PolynomialParseTerm& term = factors[funcNum];
+                for(Monomial& m : _result.monomials) {
+                    if(term.type == FunctionType::POWER_BASIS_MONOMIAL) {
+                        m *= term.monomial;
+                    }
+                    else { //VARIABLE
+                        m.coeff *= term.value;
+                        m.spot[term.varIndex] += 1;
+                    }
+                }
+            }
+        }
+        return true;
+    }
+
+    bool isPolynomialPowerSign(const char* _position, const char* _end) {
+        return _position != _end && (*_position == CHAR::POWER || (*_position == CHAR::TIMES && _position + 1 != _end && *(_position + 1) == CHAR::TIMES));
+    }
+
+    bool parsePolynomialPower(const char*& _position, const char* _end, PolynomialParseTerm& _result) {
+        if(!parsePolynomialPrimary(_position, _end, _result)) {
+            return false;
+        }
+        if(!isPolynomialPowerSign(_position, _end)) {
+            return true;
+        }
+        _position += *_position == CHAR::POWER ? 1 : 2;
+        PolynomialParseTerm exponent;
+        if(!parsePolynomialPrimary(_position, _end, exponent) || isPolynomialPowerSign(_position, _end)) {
+            return false;
+        }
+
+        //The same checks simplifyExpressions does on a POWER, in the same order.
+        const bool constantBase = _result.type == FunctionType::CONSTANT;
+        const bool constantExponent = exponent.type == FunctionType::CONSTANT;
+        if(constantBase && constantExponent) {
+            _result.value = pow(_result.value, exponent.value);
+            return true;
+        }
+        if(constantExponent && exponent.value == 0.0) {
+            _result.type = FunctionType::CONSTANT;
+            _result.value = 1;
+            return true;
+        }
+        else if(constantExponent && exponent.value == 1.0) {
+            //Falls through to the monomial check
+        }
+        else if(constantBase && _result.value == 0.0) {
+            _result.value = 0;
+            return true;
+        }
+        else if(constantBase && _result.value == 1.0) {
+            _result.value = 1;
+            return true;
+        }
+        if(_result.type == FunctionType::VARIABLE && constantExponent && exponent.value > 0 && exponent.value < 4294967296.0) {
+            const size_t power = static_cast<size_t>(exponent.value);
+            if(power == exponent.value) {
+                const double coeff = _result.value;
+                _result.type = FunctionType::POWER_BASIS_MONOMIAL;
+                _result.value = 1;
+                _result.monomial.clear(m_rank);
+                _result.monomial.spot[_result.varIndex] = power;
+                _result.monomial.coeff = coeff;
+                return true;
+            }
+        }
+        return false;
     }
-        
-private:
-    void functionParse(std::string _functionString) { //Don't pass by reference, as we change it.
-        //GRAMMER:
-        // ( and ) make subfunctions
-        // +,-,*,/,^ are math symbols
-        //numbers, e, pi are constants
-        //Everything else must be a FunctionType, string variable name, or subfunction name
-                
-        //Remove excess parenthesis surrounding the entire function.
-        removeExtraParenthesis(_functionString);
-        
-        //To start, split on +-.
-        std::vector<std::string> subparts;
-        splitSum(_functionString, subparts, m_operatorSigns);
-        
-        if(subparts.size() == 0) { //This is an empty string! Something went wrong
-            printAndThrowRuntimeError("Error Parsing Functions! Found Empty string in recursive step!");
+
+    bool parsePolynomialPrimary(const char*& _position, const char* _end, PolynomialParseTerm& _result) {
+        if(_position == _end) {
+            return false;
         }
-        //If m_operatorSigns[0] is false, then the function is of the form -<expression>. This must be parsed as a sum type.
-        else if(subparts.size() == 1 && m_operatorSigns[0]) {
-            //Reparse to split on */
-            subparts.clear();
-            m_operatorSigns.clear();
-            splitProduct(_functionString, subparts, m_operatorSigns);
-            
-            if(subparts.size() == 1) {
-                //Reparse to splt on ^
-                subparts.clear();
-                m_operatorSigns.clear();
-                splitPower(_functionString, subparts);
 
-                if(subparts.size() == 1) { //This is a more complex type.
-                    parseComplexType(_functionString);
+        //A subfunction in parenthesis
+        if(*_position == CHAR::LEFT_PAREN) {
+            _position++;
+            if(!parsePolynomialSum(_position, _end, _result) || _position == _end || *_position != CHAR::RIGHT_PAREN) {
+                return false;
+            }
+            _position++;
+            return true;
+        }
+
+        //A number. Only the - in scientific notation is kept, like splitSum does.
+        const char* start = _position;
+        if(isNumericDigit(*_position) || *_position == '.') {
+            while(_position != _end && (isNumericDigit(*_position) || *_position == '.')) {
+                _position++;
+            }
+            if(_position != _end && (*_position == 'e' || *_position == 'E')) {
+                const char* exponentStart = _position + 1;
+                const bool numericBefore = isNumericDigit(*(_position - 1)) || (_position - start >= 2 && *(_position - 1) == '.' && isNumericDigit(*(_position - 2)));
+                if(exponentStart != _end && *exponentStart == CHAR::MINUS && numericBefore) {
+                    exponentStart++;
                 }
-                else { //Make this a POWER type and split it up
-                    parsePower(subparts);
+                if(exponentStart != _end && (isNumericDigit(*exponentStart) || (*exponentStart == '.' && exponentStart + 1 != _end && isNumericDigit(*(exponentStart + 1))))) {
+                    _position = exponentStart;
+                    while(_position != _end && (isNumericDigit(*_position) || *_position == '.')) {
+                        _position++;
+                    }
                 }
             }
-            else { //Make this a PRODUCT type and split it up
-                parseProduct(subparts);
+            //The whole number must be read by strtod, std::stod in parseNumber would quietly ignore the rest.
+            char* parsedEnd;
+            errno = 0;
+            _result.type = FunctionType::CONSTANT;
+            _result.value = std::strtod(start, &parsedEnd);
+            return parsedEnd == _position && errno != ERANGE;
+        }
+
+        //A name. These are looked up in the order parseComplexType uses.
+        while(_position != _end && *_position != CHAR::PLUS && *_position != CHAR::MINUS && *_position != CHAR::TIMES && *_position != CHAR::DIVIDE && *_position != CHAR::POWER && *_position != CHAR::LEFT_PAREN && *_position != CHAR::RIGHT_PAREN) {
+            _position++;
+        }
+        const size_t length = _position - start;
+        if(length == 0 || ((*(_position - 1) == 'e' || *(_position - 1) == 'E') && _position != _end && *_position == CHAR::MINUS)) {
+            //Could be scientific notation to splitSum
+            return false;
+        }
+        const bool isE = length == 1 && (*start == 'e' || *start == 'E');
+        const bool isPi = length == 2 && std::tolower(start[0]) == 'p' && std::tolower(start[1]) == 'i';
+        if(isE || isPi) {
+            //A function name is checked first by addSubfunction.
+            if(s_allFunctionNames.find(std::string(start, length)) != s_allFunctionNames.end()) {
+                return false;
             }
+            _result.type = FunctionType::CONSTANT;
+            _result.value = isE ? M_E : M_PI;
+            return true;
         }
-        else { //Make this a SUM type and split it up
-            parseSum(subparts);
+        //Names starting with a function type are parsed as that function type.
+        if(length > 3) {
+            const std::string lowercase = {static_cast<char>(std::tolower(start[0])), static_cast<char>(std::tolower(start[1])), static_cast<char>(std::tolower(start[2])), static_cast<char>(std::tolower(start[3]))};
+            const std::string lowercase3 = lowercase.substr(0, 3);
+            if(lowercase3 == "sin" || lowercase3 == "cos" || lowercase3 == "tan" || lowercase3 == "exp" || lowercase3 == "log" || lowercase3 == "sum") {
+                return false;
+            }
+            if(length > 4 && (lowercase == "sqrt" || lowercase == "prod")) {
+                return false;
+            }
         }
-        
-        //Make simplifications that will make calculations easier in the future.
-        simplifyExpressions();
+        for(size_t i = 0; i < m_variableNames.size(); i++) {
+            if(m_variableNames[i].length() == length && m_variableNames[i].compare(0, length, start, length) == 0) {
+                _result.type = FunctionType::VARIABLE;
+                _result.value = 1;
+                _result.varIndex = i;
+                return true;
+            }
+        }
+        return false;
     }
-        
+
     void simplifyExpressions() {
         //TODO: To Update everything to shared ptrs, it is important to never change a function besdides the
         //one you are currently in. Otherwise it will be changing other copies of the function that are unrelated.
@@ -667,9 +1538,7 @@ private:
         //twice in a sum I should remove both and make a new function that is 2*<that function> (parens needed?)
         //If a function appears twice in a product then I should remove both and make a new function that is <that function>^2
         
-        //TODO: If I have a monomial raised to a power I should be able to simplify that.
-        
-        
+
         //Pull any constants out of a sum
         if(m_functionType == FunctionType::SUM) {
             //Pull any constants out of a sum
@@ -809,6 +1678,15 @@ private:
             }
         }
 
+        //Check for a contant CHEBYSHEV
+        if(m_functionType == FunctionType::CHEBYSHEV) {
+            if(m_subfunctions[0]->getFunctionType() == FunctionType::CONSTANT) {
+                m_value *= chebPower(m_subfunctions[0]->getValue(), m_varIndex);
+                m_subfunctions.erase(m_subfunctions.begin());
+                m_functionType = FunctionType::CONSTANT;
+            }
+        }
+
         //Check for a contant POWER
         if(m_functionType == FunctionType::POWER) {
             if(m_subfunctions[0]->getFunctionType() == FunctionType::CONSTANT && m_subfunctions[1]->getFunctionType() == FunctionType::CONSTANT) {
@@ -869,6 +1747,41 @@ private:
             }
         }
         
+        //Expand a POWER of a POWER_BASIS_MONOMIAL or POWER_BASIS_POLYNOMIAL to a whole number.
+        if(m_functionType == FunctionType::POWER) {
+            const FunctionType baseType = m_subfunctions[0]->getFunctionType();
+            const bool isPowerBasis = baseType == FunctionType::POWER_BASIS_MONOMIAL || baseType == FunctionType::POWER_BASIS_POLYNOMIAL;
+            if(isPowerBasis && m_subfunctions[1]->getFunctionType() == FunctionType::CONSTANT) {
+                const double exponent = m_subfunctions[1]->getValue();
+                const size_t wholeExponent = exponent >= 1 && exponent <= s_maxExpandedPolynomialSize ? static_cast<size_t>(exponent) : 0;
+                if(wholeExponent != 0 && wholeExponent == exponent) {
+                    if(baseType == FunctionType::POWER_BASIS_MONOMIAL) {
+                        m_monomial = m_subfunctions[0]->getMonomial();
+                        for(size_t i = 0; i < m_rank; i++) {
+                            m_monomial.spot[i] *= wholeExponent;
+                        }
+                        m_monomial.coeff = m_value * power(m_monomial.coeff, wholeExponent);
+                        m_subfunctions.clear();
+                        m_functionType = FunctionType::POWER_BASIS_MONOMIAL;
+                    }
+                    else {
+                        const Polynomial& base = m_subfunctions[0]->getPolynomial();
+                        Polynomial expanded = base;
+                        bool smallEnough = true;
+                        for(size_t i = 1; i < wholeExponent && smallEnough; i++) {
+                            smallEnough = multiplyIfSmallEnough(expanded, base);
+                        }
+                        if(smallEnough) {
+                            m_polynomial = expanded;
+                            multiplyByConstant(m_polynomial, m_value);
+                            m_subfunctions.clear();
+                            m_functionType = FunctionType::POWER_BASIS_POLYNOMIAL;
+                        }
+                    }
+                }
+            }
+        }
+        
         //Check if a PRODUCT is composed of only POWER_BASIS_MONOMIALs, VARIABLEs and CONSTANTs. Then it should be just one big POWER_BASIS_MONOMIAL.
         if(m_functionType == FunctionType::PRODUCT) {
             //Check if everything is POWER_BASIS_MONOMIAL or VARIABLE
@@ -1032,12 +1945,182 @@ private:
             }
         }
         
+        //Expand a PRODUCT of several POWER_BASIS_POLYNOMIALs, POWER_BASIS_MONOMIALs and VARIABLEs if the result isn't too big.
+        if(m_functionType == FunctionType::PRODUCT) {
+            bool isPowerBasis = true;
+            for(size_t funcNum = 0; funcNum < m_subfunctions.size(); funcNum++) {
+                isPowerBasis &= isPowerBasisType(m_subfunctions[funcNum]->getFunctionType()) && m_operatorSigns[funcNum]; //Make sure it's not a division
+            }
+            if(isPowerBasis) {
+                Polynomial expanded = m_subfunctions[0]->getAsPolynomial();
+                bool smallEnough = true;
+                for(size_t funcNum = 1; funcNum < m_subfunctions.size() && smallEnough; funcNum++) {
+                    smallEnough = multiplyIfSmallEnough(expanded, m_subfunctions[funcNum]->getAsPolynomial());
+                }
+                if(smallEnough) {
+                    m_polynomial = expanded;
+                    multiplyByConstant(m_polynomial, m_value);
+                    m_subfunctions.clear();
+                    m_functionType = FunctionType::POWER_BASIS_POLYNOMIAL;
+                }
+            }
+        }
+        
+        //Check if a CHEBYSHEV is a CHEBYSHEV_BASIS_MONOMIAL. For CHEBYSHEV the m_varIndex is the degree.
+        if(m_functionType == FunctionType::CHEBYSHEV) {
+            if(m_subfunctions[0]->getFunctionType() == FunctionType::VARIABLE && m_subfunctions[0]->getValue() == 1.0) {
+                m_monomial.clear(m_rank);
+                m_monomial.spot[m_subfunctions[0]->getVarIndex()] = m_varIndex;
+                m_monomial.coeff = m_value;
+                m_chebyshevPolynomial.clear();
+                m_chebyshevPolynomial.addMonomial(m_monomial);
+                m_subfunctions.clear();
+                m_functionType = FunctionType::CHEBYSHEV_BASIS_MONOMIAL;
+            }
+        }
+
+        //Check if a PRODUCT is composed of only CHEBYSHEV_BASIS_MONOMIALs, VARIABLEs and at most one CHEBYSHEV_BASIS_POLYNOMIAL.
+        //A VARIABLE is T1, so it can be folded in as well.
+        if(m_functionType == FunctionType::PRODUCT) {
+            bool isChebyshev = true;
+            bool hasChebyshev = false;
+            int polySpot = -1;
+            for(size_t funcNum = 0; funcNum < m_subfunctions.size(); funcNum++) {
+                const FunctionType subType = m_subfunctions[funcNum]->getFunctionType();
+                const bool chebStuff = subType == FunctionType::CHEBYSHEV_BASIS_MONOMIAL || subType == FunctionType::CHEBYSHEV_BASIS_POLYNOMIAL;
+                isChebyshev &= (chebStuff || subType == FunctionType::VARIABLE) && m_operatorSigns[funcNum]; //Make sure it's not a division
+                hasChebyshev |= chebStuff;
+                if(subType == FunctionType::CHEBYSHEV_BASIS_POLYNOMIAL) {
+                    if(polySpot == -1) { //Allow one polynomial
+                        polySpot = funcNum;
+                    }
+                    else {
+                        isChebyshev = false;
+                    }
+                }
+            }
+            if(isChebyshev && hasChebyshev) {
+                //Start with the constant, or the polynomial times the constant
+                Monomial toMultiply;
+                toMultiply.clear(m_rank);
+                toMultiply.coeff = m_value;
+                m_chebyshevPolynomial.clear();
+                if(polySpot == -1) {
+                    m_chebyshevPolynomial.addMonomial(toMultiply);
+                }
+                else {
+                    m_chebyshevPolynomial = m_subfunctions[polySpot]->getChebyshevPolynomial();
+                    m_chebyshevPolynomial.multiplyMonomial(toMultiply);
+                }
+                //Multiply by everything else
+                for(size_t funcNum = 0; funcNum < m_subfunctions.size(); funcNum++) {
+                    if(funcNum == polySpot) {
+                        continue;
+                    }
+                    switch(m_subfunctions[funcNum]->getFunctionType()) {
+                    case FunctionType::CHEBYSHEV_BASIS_MONOMIAL: {
+                        m_chebyshevPolynomial.multiplyMonomial(m_subfunctions[funcNum]->getMonomial());
+                        break;
+                    }
+                    case FunctionType::VARIABLE: {
+                        toMultiply.clear(m_rank);
+                        toMultiply.spot[m_subfunctions[funcNum]->getVarIndex()] = 1;
+                        toMultiply.coeff = m_subfunctions[funcNum]->getValue();
+                        m_chebyshevPolynomial.multiplyMonomial(toMultiply);
+                        break;
+                    }
+                    default: {
+                        printAndThrowRuntimeError("Error converting product to Chebyshev Basis Polynomial!");
+                        break;
+                    }
+                    }
+                }
+                //Keep it as a product if the result is too sparse to be worth storing densely.
+                if(m_chebyshevPolynomial.getMonomials().size() == 1) {
+                    m_monomial = *m_chebyshevPolynomial.getMonomials().begin();
+                    m_functionType = FunctionType::CHEBYSHEV_BASIS_MONOMIAL;
+                    m_subfunctions.clear();
+                }
+                else if(m_chebyshevPolynomial.worthStoringDense()) {
+                    m_functionType = FunctionType::CHEBYSHEV_BASIS_POLYNOMIAL;
+                    m_subfunctions.clear();
+                }
+                else {
+                    m_chebyshevPolynomial.clear();
+                }
+            }
+        }
+
+        //Check if a SUM is composed of only CHEBYSHEV_BASIS_POLYNOMIALs, CHEBYSHEV_BASIS_MONOMIALs and VARIABLEs. Then it is a CHEBYSHEV_BASIS_POLYNOMIAL.
+        if(m_functionType == FunctionType::SUM) {
+            bool isChebyshev = true;
+            bool hasChebyshev = false;
+            for(size_t funcNum = 0; funcNum < m_subfunctions.size(); funcNum++) {
+                const FunctionType subType = m_subfunctions[funcNum]->getFunctionType();
+                const bool chebStuff = subType == FunctionType::CHEBYSHEV_BASIS_MONOMIAL || subType == FunctionType::CHEBYSHEV_BASIS_POLYNOMIAL;
+                isChebyshev &= chebStuff || subType == FunctionType::VARIABLE;
+                hasChebyshev |= chebStuff;
+            }
+            if(isChebyshev && hasChebyshev) {
+                m_chebyshevPolynomial.clear();
+                //Add the constant term.
+                Monomial toAdd;
+                if(m_value != 0.0) {
+                    toAdd.clear(m_rank);
+                    toAdd.coeff = m_value;
+                    m_chebyshevPolynomial.addMonomial(toAdd);
+                }
+                //Add the monomials
+                for(size_t funcNum = 0; funcNum < m_subfunctions.size(); funcNum++) {
+                    const double sign = m_operatorSigns[funcNum] ? 1.0 : -1.0; //Get the sign based on the +-
+                    switch(m_subfunctions[funcNum]->getFunctionType()) {
+                    case FunctionType::CHEBYSHEV_BASIS_POLYNOMIAL: {
+                        for(const Monomial& m : m_subfunctions[funcNum]->getChebyshevPolynomial().getMonomials()) {
+                            toAdd = m;
+                            toAdd.coeff *= sign;
+                            m_chebyshevPolynomial.addMonomial(toAdd);
+                        }
+                        break;
+                    }
+                    case FunctionType::CHEBYSHEV_BASIS_MONOMIAL: {
+                        toAdd = m_subfunctions[funcNum]->getMonomial();
+                        toAdd.coeff *= sign;
+                        m_chebyshevPolynomial.addMonomial(toAdd);
+                        break;
+                    }
+                    case FunctionType::VARIABLE: {
+                        toAdd.clear(m_rank);
+                        toAdd.coeff = m_subfunctions[funcNum]->getValue() * sign;
+                        toAdd.spot[m_subfunctions[funcNum]->getVarIndex()] = 1;
+                        m_chebyshevPolynomial.addMonomial(toAdd);
+                        break;
+                    }
+                    default: {
+                        printAndThrowRuntimeError("Error converting sum to Chebyshev Basis Polynomial!");
+                        break;
+                    }
+                    }
+                }
+                //Keep it as a sum if the result is too sparse to be worth storing densely.
+                if(m_chebyshevPolynomial.worthStoringDense()) {
+                    m_functionType = FunctionType::CHEBYSHEV_BASIS_POLYNOMIAL;
+                    m_subfunctions.clear();
+                }
+                else {
+                    m_chebyshevPolynomial.clear();
+                }
+            }
+        }
+
+        //Whatever is left of a SUM or PRODUCT that is polynomial gets folded into one subfunction.
+        if(m_functionType == FunctionType::SUM || m_functionType == FunctionType::PRODUCT) {
+            groupPowerBasisSubfunctions();
+        }
+
         if(m_functionType == FunctionType::POWER_BASIS_MONOMIAL) {
             m_monomial.prepEvaluation();
         }
         
-        //TODO: A product with 1 POWER_BASIS_POLYNOMIAL and POWER_BASIS_MONOMIALs and VARIABLEs
-        
         
         //Check if a SUM has multiple POWER_BASIS_MONOMIAL, VARIABLE, and CONSTANT in it
         //TODO: Decide then this should be turned to a POWER_BASIS_POLYNOMIAL
@@ -1046,9 +2129,6 @@ private:
         //A sum of polynomials has to do the log reduction which is much slower, plus the function
         //Call and switch statement. Overall maybe 10 operations or so? But also probably slower ones.
         //I'd guess the change boundary is when it is between 1-10% full. Try something and then run timings
-                
-        //Check if a SUM has multiple CHEBYSHEV_BASIS_MONOMIAL and CONSTANT in it
-        //TODO: Decide then this should be turned to a CHEBYSHEV_BASIS_POLYNOMIAL
 
         
         
@@ -1071,6 +2151,77 @@ private:
         //Unless the whole function is one big constant I guess.
     }
         
+    static bool isPowerBasisType(FunctionType _functionType) {
+        return _functionType == FunctionType::POWER_BASIS_MONOMIAL || _functionType == FunctionType::POWER_BASIS_POLYNOMIAL || _functionType == FunctionType::VARIABLE;
+    }
+    
+    //Multiplies _polynomial by _other unless the result could have more than s_maxExpandedPolynomialSize monomials
+    //or a degree over s_maxExpandedDegree.
+    static bool multiplyIfSmallEnough(Polynomial& _polynomial, const Polynomial& _other) {
+        if(_polynomial.getMonomials().size() * _other.getMonomials().size() > s_maxExpandedPolynomialSize) {
+            return false;
+        }
+        if(_polynomial.getTotalDegree() + _other.getTotalDegree() > s_maxExpandedDegree) {
+            return false;
+        }
+        _polynomial.multiplyPolynomial(_other);
+        return true;
+    }
+    
+    void multiplyByConstant(Polynomial& _polynomial, double _constant) {
+        if(_constant != 1.0) {
+            Monomial toMultiply;
+            toMultiply.clear(m_rank);
+            toMultiply.coeff = _constant;
+            _polynomial.multiplyMonomial(toMultiply);
+        }
+    }
+    
+    void groupPowerBasisSubfunctions() {
+        //Build the string of the polynomial parts so the group is parsed, stored and shared like any other subfunction.
+        const bool isSum = m_functionType == FunctionType::SUM;
+        std::string groupString;
+        std::vector<size_t> groupSpots;
+        size_t groupSize = 1;
+        size_t groupDegree = 0;
+        for(size_t funcNum = 0; funcNum < m_subfunctions.size(); funcNum++) {
+            const SharedFunctionPtr& subfunction = m_subfunctions[funcNum];
+            if(!isPowerBasisType(subfunction->getFunctionType()) || (!isSum && !m_operatorSigns[funcNum])) {
+                continue;
+            }
+            if(isSum) {
+                if(!m_operatorSigns[funcNum]) {
+                    groupString += CHAR::MINUS;
+                }
+                else if(groupSpots.size() > 0) {
+                    groupString += CHAR::PLUS;
+                }
+            }
+            else {
+                const Polynomial polynomial = subfunction->getAsPolynomial();
+                groupSize *= polynomial.getMonomials().size();
+                groupDegree += polynomial.getTotalDegree();
+                if(groupSpots.size() > 0) {
+                    groupString += CHAR::TIMES;
+                }
+            }
+            groupString += CHAR::LEFT_PAREN + subfunction->m_functionString + CHAR::RIGHT_PAREN;
+            groupSpots.push_back(funcNum);
+        }
+        //A product is only grouped if the group will expand, otherwise the group would try to group itself again.
+        if(groupSpots.size() < 2 || groupSize > s_maxExpandedPolynomialSize || groupDegree > s_maxExpandedDegree) {
+            return;
+        }
+        
+        //Replace the parts with the group
+        for(size_t i = groupSpots.size() - 1; i < groupSpots.size(); i--) {
+            m_subfunctions.erase(m_subfunctions.begin() + groupSpots[i]);
+            m_operatorSigns.erase(m_operatorSigns.begin() + groupSpots[i]);
+        }
+        addSubfunction(groupString);
+        m_operatorSigns.push_back(true);
+    }
+    
     void removeExtraParenthesis(std::string& _functionString) {
         //Loop that removes parenthesis
         while(_functionString.length() > 0 && _functionString[0] == CHAR::LEFT_PAREN) {
@@ -1598,11 +2749,6 @@ private:
     }
     
     void addSubfunction(const std::string& subfunctionString) {
-        if(unlikely(s_allFunctions.size() == 0)) {
-            s_allFunctions.resize(1);
-            s_allFunctionNames.resize(1);
-        }
-
         //Get rid of a + at the start of the string
         std::string newString = subfunctionString;
         if(newString.length() > 0 && newString[0] == CHAR::PLUS) {
@@ -1613,14 +2759,14 @@ private:
         removeExtraParenthesis(newString);
         
         //Check if this is already a function
-        FunctionMap::const_iterator found = s_allFunctions[0].find(newString);
-        if(found != s_allFunctions[0].end()) {
+        FunctionMap::const_iterator found = s_allFunctions.find(newString);
+        if(found != s_allFunctions.end()) {
             m_subfunctions.push_back(found->second);
             return;
         }
         //Check if this is already a function name.
-        found = s_allFunctionNames[0].find(newString);
-        if(found != s_allFunctionNames[0].end()) {
+        found = s_allFunctionNames.find(newString);
+        if(found != s_allFunctionNames.end()) {
             m_subfunctions.push_back(found->second);
             return;
         }
@@ -1630,12 +2776,12 @@ private:
     }
     
 //Specialized Function Evals
-    template<typename ReturnType>
-    ReturnType sumEval(const std::vector<double>& _inputPoints) {
+    template<typename ReturnType, typename InputType>
+    ReturnType sumEval(const std::vector<InputType>& _inputPoints, size_t _threadNum) {
         assert(m_subfunctions.size() == m_operatorSigns.size());
         ReturnType result = m_value;
         for(size_t i = 0; i < m_subfunctions.size(); i++) {
-            SIGNCHECKSUM(m_operatorSigns[i], result, m_subfunctions[i]->evaluate<ReturnType>(_inputPoints));
+            SIGNCHECKSUM(m_operatorSigns[i], result, m_subfunctions[i]->evaluate<ReturnType>(_inputPoints, _threadNum));
         }
         return result;
         
@@ -1648,12 +2794,12 @@ private:
         //is a double and then an error, so the end result of the eval returns the answer and the maximum error.
     }
     
-    template<typename ReturnType>
-    ReturnType productEval(const std::vector<double>& _inputPoints) {
+    template<typename ReturnType, typename InputType>
+    ReturnType productEval(const std::vector<InputType>& _inputPoints, size_t _threadNum) {
         assert(m_subfunctions.size() == m_operatorSigns.size());
         ReturnType result = m_value;
         for(size_t i = 0; i < m_operatorSigns.size(); i++) {
-            SIGNCHECKPRODUCT(m_operatorSigns[i], result, m_subfunctions[i]->evaluate<ReturnType>(_inputPoints));
+            SIGNCHECKPRODUCT(m_operatorSigns[i], result, m_subfunctions[i]->evaluate<ReturnType>(_inputPoints, _threadNum));
         }
         return result;
     }
@@ -1691,6 +2837,17 @@ public:
         //Figure out what dimensions the function exists in.
         defineFunctionDimensions();
     }
+    
+    //Builds the function tree below this function so it can be evaluated on a grid.
+    void setAsTopFunction() {
+        m_isTopFunction = true;
+        m_allFunctionLevels.clear();
+        getFunctionLevels(m_allFunctionLevels);
+        //Anything already prepped for the grid was done as a subfunction, without the top result map.
+        for(FunctionScratch& scratch : m_threadScratch) {
+            scratch.evaluateGridInfo.clear();
+        }
+    }
         
 //Overloaded Operators
 public:
@@ -1739,6 +2896,32 @@ public:
     const Polynomial& getPolynomial() const {
         return m_polynomial;
     }
+
+    //A POWER_BASIS_POLYNOMIAL, POWER_BASIS_MONOMIAL or VARIABLE as a Polynomial.
+    Polynomial getAsPolynomial() const {
+        if(m_functionType == FunctionType::POWER_BASIS_POLYNOMIAL) {
+            return m_polynomial;
+        }
+        Polynomial polynomial(m_rank);
+        Monomial toAdd;
+        if(m_functionType == FunctionType::POWER_BASIS_MONOMIAL) {
+            toAdd = m_monomial;
+        }
+        else if(m_functionType == FunctionType::VARIABLE) {
+            toAdd.clear(m_rank);
+            toAdd.spot[m_varIndex] = 1;
+            toAdd.coeff = m_value;
+        }
+        else {
+            printAndThrowRuntimeError("Function is not a power basis polynomial!");
+        }
+        polynomial.addMonomial(toAdd);
+        return polynomial;
+    }
+
+    const ChebyshevPolynomial& getChebyshevPolynomial() const {
+        return m_chebyshevPolynomial;
+    }
     
     bool isTopFunction() const {
         return m_isTopFunction;
@@ -1748,8 +2931,20 @@ public:
         return m_functionLevel;
     }
     
-    const std::vector<double>& getPartialEvals() const {
-        return m_partialEvaluations;
+    const std::vector<double>& getPartialEvals(size_t _threadNum) const {
+        return m_threadScratch[_threadNum].partialEvaluations;
+    }
+    
+    const std::vector<double>& getPartialErrors(size_t _threadNum) const {
+        return m_threadScratch[_threadNum].partialErrors;
+    }
+    
+    size_t getGridTileOffset(size_t _threadNum) const {
+        return m_threadScratch[_threadNum].gridTileOffset;
+    }
+
+    size_t getNumThreadScratch() const {
+        return m_threadScratch.size();
     }
 
     const std::vector<bool>& getHasDimension() const {
@@ -1764,10 +2959,6 @@ public:
         return m_numUsedDimensions;
     }
 
-    const std::vector<EvaluateGridInfo>& getEvaluateGridInfo() const {
-        return m_evaluateGridInfo;
-    }
-
     EvaluateGridType getEvaluateGridType() const {
         return m_evaluateGridType;
     }
@@ -1781,89 +2972,30 @@ public:
     }
         
     static SharedFunctionPtr getThreadFunctionByName(size_t _threadNum, const std::string& _functionName) {
-        if(_threadNum >= s_allFunctionNames.size()) {
-            printAndThrowRuntimeError("Functions not copied for thread number " + std::to_string(_threadNum));
+        if(s_allFunctionNames.find(_functionName) == s_allFunctionNames.end()) {
+            printAndThrowRuntimeError("No definition found for function " + _functionName);
         }
-        if(s_allFunctionNames[_threadNum].find(_functionName) == s_allFunctionNames[_threadNum].end()) {
-            printAndThrowRuntimeError("No definition found for function " + _functionName + " on thread " + std::to_string(_threadNum));
+        SharedFunctionPtr function = s_allFunctionNames[_functionName];
+        if(_threadNum >= function->getNumThreadScratch()) {
+            printAndThrowRuntimeError("Functions not prepared for thread number " + std::to_string(_threadNum));
         }
-        return s_allFunctionNames[_threadNum][_functionName];
+        return function;
     }
 
+    //Every thread uses the same functions, each with it's own scratch space for evaluating.
+    //The function trees are all built here so evaluating never changes the shared parts of a function.
     static void addThreadFunctions(size_t _requiredThreads) {
-        while(s_allFunctions.size() <_requiredThreads) {
-            //Add 1 to the vectors
-            s_allFunctions.resize(s_allFunctions.size() + 1);
-            s_allFunctionNames.resize(s_allFunctionNames.size() + 1);
-            const size_t size = s_allFunctions.size()-1;
-            
-            //Copy all s_allFunctions.
-            for(FunctionMap::const_iterator it = s_allFunctions[0].begin(); it != s_allFunctions[0].end(); it++) {
-                //Copy this function
-                SharedFunctionPtr currFunction = std::make_shared<Function>(*it->second.get());
-                //Add it to s_allFunctions
-                s_allFunctions[size].insert({it->first,currFunction});
-            }
-            
-            //Finalize Copy on Everything
-            for(FunctionMap::const_iterator it = s_allFunctions[size].begin(); it != s_allFunctions[size].end(); it++) {
-                //Find the function to copy by string, and copy it
-                std::string funcStringToFind = it->first;
-                FunctionMap::const_iterator found = s_allFunctions[0].find(funcStringToFind);
-                std::shared_ptr<Function> functionToCopy = found->second;
-                it->second->finalizeCopy(*functionToCopy.get());
-            }
-            
-            //Copy s_allFunctionNames
-            for(FunctionMap::const_iterator it = s_allFunctions[size].begin(); it != s_allFunctions[size].end(); it++) {
-                const std::string& functionName = it->second->getFunctionName();
-                if(functionName != "") { //The should be every function that has a name.
-                    s_allFunctionNames[s_allFunctionNames.size() - 1][functionName] = it->second;
-                }
-            }
+        for(FunctionMap::const_iterator it = s_allFunctionNames.begin(); it != s_allFunctionNames.end(); it++) {
+            it->second->setAsTopFunction();
+        }
+        for(FunctionMap::const_iterator it = s_allFunctions.begin(); it != s_allFunctions.end(); it++) {
+            it->second->addThreadScratch(_requiredThreads);
         }
     }
     
-    //Copy Constructor that doesn't copy the pointers.
-    Function(const Function& other) :
-    m_isTopFunction(other.isTopFunction()),
-    m_functionLevel(other.getFunctionLevel()),
-    m_operatorSigns(other.getOperatorSigns()),
-    m_functionType(other.getFunctionType()),
-    m_value(other.getValue()),
-    m_varIndex(other.getVarIndex()),
-    m_functionString(other.getFunctionString()),
-    m_functionName(other.getFunctionName()),
-    m_variableNames(other.getVariableNames()),
-    m_monomial(other.getMonomial()),
-    m_polynomial(other.getPolynomial()),
-    m_rank(other.getRank()),
-    m_hasDimension(other.getHasDimension()),
-    m_numUsedDimensions(other.getNumUsedDimensions()),
-    m_partialEvaluations(other.getPartialEvals()),
-    m_evaluateGridInfo(other.getEvaluateGridInfo()),
-    m_evaluateGridType(other.getEvaluateGridType())
-    {}
-    
-    //Helper to the copy constructor, updates the pointers
-    void finalizeCopy(const Function& other) {
-        const size_t threadNum = s_allFunctions.size() - 1; //Copy from this spot in the s_allFunctions
-        
-        //Copy m_allFunctionLevels
-        const std::vector<std::vector<SharedFunctionPtr> >& functionLevelsToCopy = other.getAllFunctionLevels();
-        m_allFunctionLevels.resize(functionLevelsToCopy.size());
-        for(size_t level = 0; level < functionLevelsToCopy.size(); level++) {
-            m_allFunctionLevels[level].resize(functionLevelsToCopy[level].size());
-            for(size_t innerLevel = 0; innerLevel < functionLevelsToCopy[level].size(); innerLevel++) {
-                m_allFunctionLevels[level][innerLevel] = s_allFunctions[threadNum][functionLevelsToCopy[level][innerLevel]->getFunctionString()];
-            }
-        }
-        
-        //Copy m_subfunctions
-        const std::vector<SharedFunctionPtr>& subfunctionsToCopy = other.getSubfunctions();
-        m_subfunctions.resize(subfunctionsToCopy.size());
-        for(size_t level = 0; level < subfunctionsToCopy.size(); level++) {
-            m_subfunctions[level] = s_allFunctions[threadNum][subfunctionsToCopy[level]->getFunctionString()];
+    void addThreadScratch(size_t _requiredThreads) {
+        if(m_threadScratch.size() < _requiredThreads) {
+            m_threadScratch.resize(_requiredThreads);
         }
     }
     
@@ -1872,7 +3004,7 @@ private:
         if(s_claimedVariableNames.find(_name) != s_claimedVariableNames.end() && _type != "Variable Name") {
             printAndThrowRuntimeError("Illegal " + _type + " Name: " + _name + ". Already a Variable Name.");
         }
-        else if(s_allFunctionNames[0].find(_name) != s_allFunctionNames[0].end()) {
+        else if(s_allFunctionNames.find(_name) != s_allFunctionNames.end()) {
             printAndThrowRuntimeError("Illegal " + _type + " Name: " + _name + ". Already a Function Name.");
         }
         else if(s_claimedFunctionNames.find(_name) != s_claimedFunctionNames.end()) {
@@ -1886,11 +3018,6 @@ private:
 public:
     //A function should only be created through this. It adds them to the maps correctly.
     static SharedFunctionPtr addFunction(const std::string& _functionName, const std::string& _functionString, const std::vector<std::string>& _variableNames) {
-        if(unlikely(s_allFunctions.size() == 0)) {
-            s_allFunctions.resize(1);
-            s_allFunctionNames.resize(1);
-        }
-        
         //Claim the variable names
         for(size_t i = 0; i < _variableNames.size(); i++) {
             checkNameNotClaimed( _variableNames[i], "Variable Name");
@@ -1903,26 +3030,26 @@ public:
         //Check if we are double adding it
         bool namedFuncAlreadyExists = false;
         if(_functionName != "") {
-            if(s_allFunctions[0].find(_functionString) != s_allFunctions[0].end()) {
+            if(s_allFunctions.find(_functionString) != s_allFunctions.end()) {
                 namedFuncAlreadyExists = true;
             }
         }
-        else if(s_allFunctions[0].find(_functionString) != s_allFunctions[0].end()) {
+        else if(s_allFunctions.find(_functionString) != s_allFunctions.end()) {
             printAndThrowRuntimeError("Trying to add function Twice! Name is " + _functionName + " String is " + _functionString);
         }
         
         if(namedFuncAlreadyExists) {
-            SharedFunctionPtr function = s_allFunctions[0][_functionString];
-            s_allFunctionNames[0][_functionName] = function;
+            SharedFunctionPtr function = s_allFunctions[_functionString];
+            s_allFunctionNames[_functionName] = function;
             return function;
         }
         else {
             SharedFunctionPtr function = std::make_shared<Function>(_functionName, _functionString, _variableNames);
 
             if(_functionName != "") {
-                s_allFunctionNames[0][_functionName] = function;
+                s_allFunctionNames[_functionName] = function;
             }
-            s_allFunctions[0][_functionString] = function;
+            s_allFunctions[_functionString] = function;
             
             return function;
         }
@@ -1935,8 +3062,8 @@ public:
 
 private:
     //The Top Function and m_allFunctions Map.
-    static std::vector<FunctionMap>             s_allFunctions; //Map from function string to function
-    static std::vector<FunctionMap>             s_allFunctionNames; //Map from function name to function
+    static FunctionMap                          s_allFunctions; //Map from function string to function
+    static FunctionMap                          s_allFunctionNames; //Map from function name to function
     
     bool                                        m_isTopFunction;
     size_t                                      m_functionLevel;
@@ -1963,22 +3090,29 @@ private:
     //For Polynomials
     Monomial                                    m_monomial;
     Polynomial                                  m_polynomial;
+    ChebyshevPolynomial                         m_chebyshevPolynomial;
     
     //For evaluate grid
     size_t                                      m_rank;
     std::vector<bool>                           m_hasDimension;
     size_t                                      m_numUsedDimensions;
-    std::vector<double>                         m_partialEvaluations;
-    std::vector<EvaluateGridInfo>               m_evaluateGridInfo;
     EvaluateGridType                            m_evaluateGridType;
+    //Everything written to while evaluating, one for each thread.
+    std::vector<FunctionScratch>                m_threadScratch;
+    //The number of grid points to evaluate at once in a tile, small enough that a few tiles stay in cache.
+    static constexpr size_t                     s_gridTileSize = 4096;
+    //The most monomials a product or power is allowed to expand to when it's folded into a POWER_BASIS_POLYNOMIAL.
+    //The degree is limited too, high degree expansions lose too much accuracy to cancellation.
+    static constexpr size_t                     s_maxExpandedPolynomialSize = 1024;
+    static constexpr size_t                     s_maxExpandedDegree = 8;
         
     static                  std::unordered_set<std::string> s_claimedConstantNames;
     static                  std::unordered_set<std::string> s_claimedFunctionNames;
     static                  std::unordered_set<std::string> s_claimedVariableNames;
 };
 
-std::vector<Function::FunctionMap>  Function::s_allFunctions;
-std::vector<Function::FunctionMap>  Function::s_allFunctionNames;
+Function::FunctionMap  Function::s_allFunctions;
+Function::FunctionMap  Function::s_allFunctionNames;
 
 std::unordered_set<std::string> Function::s_claimedConstantNames({"e","pi",});
 std::unordered_set<std::string> Function::s_claimedFunctionNames({"sin","cos","tan","sinh","cosh","tanh","sqrt","exp","log","log2","log10"});
@@ -16,6 +16,125 @@
 #include <type_traits>
 #include "Utilities/utilities.hpp"
 #include "Utilities/ErrorTracker.hpp"
+#include "Utilities/RoundedInterval.hpp"
+#include "Utilities/DualNumber.hpp"
+#include "Functions/TensorGridEvaluation.hpp"
+
+//Scratch space for the nested Clenshaw evaluation, one per ReturnType.
+template<typename ReturnType>
+struct ChebyshevClenshawScratch {
+    std::vector<ReturnType> m_b1;
+    std::vector<ReturnType> m_b2;
+    std::vector<ReturnType> m_reduced1;
+    std::vector<ReturnType> m_reduced2;
+
+    void resize(size_t _size) {
+        if(m_b1.size() < _size) {
+            m_b1.resize(_size);
+            m_b2.resize(_size);
+            m_reduced1.resize(_size);
+            m_reduced2.resize(_size);
+        }
+    }
+};
+
+//Everything that gets written to while evaluating a Monomial, Polynomial or ChebyshevPolynomial.
+//Evaluating doesn't change the polynomials, so they can be shared between threads as long as each thread has it's own scratch.
+struct PolynomialScratch {
+    //For Horner, the results of each dimension
+    std::vector<std::vector<double> >           m_results;
+    std::vector<std::vector<ErrorTracker> >     m_resultsErrorTracker;
+    std::vector<std::vector<RoundedInterval> >  m_resultsRoundedInterval;
+    std::vector<std::vector<DualNumber> >       m_resultsDualNumber;
+    
+    //For Clenshaw
+    ChebyshevClenshawScratch<double>            m_clenshawDouble;
+    ChebyshevClenshawScratch<ErrorTracker>      m_clenshawErrorTracker;
+    ChebyshevClenshawScratch<RoundedInterval>   m_clenshawRoundedInterval;
+    ChebyshevClenshawScratch<DualNumber>        m_clenshawDualNumber;
+
+    //For evaluate grid
+    std::vector<std::vector<double> >           m_basisTables;
+    std::vector<double>                         m_buffer1;
+    std::vector<double>                         m_buffer2;
+    std::vector<double>                         m_axisValues;
+    
+    //For the sparse evaluation, the powers of every used variable and the partial sums of each grid dimension
+    std::vector<double>                         m_sparsePowers;
+    std::vector<ErrorTracker>                   m_sparsePowersErrorTracker;
+    std::vector<RoundedInterval>                m_sparsePowersRoundedInterval;
+    std::vector<DualNumber>                     m_sparsePowersDualNumber;
+    std::vector<std::vector<double> >           m_sparseGridSums;
+    
+    template<typename ReturnType>
+    std::vector<std::vector<ReturnType> >& getResults();
+
+    template<typename ReturnType>
+    std::vector<ReturnType>& getSparsePowers();
+
+    template<typename ReturnType>
+    ChebyshevClenshawScratch<ReturnType>& getClenshaw();
+};
+
+template<>
+inline std::vector<std::vector<double> >& PolynomialScratch::getResults<double>() {
+    return m_results;
+}
+
+template<>
+inline std::vector<std::vector<ErrorTracker> >& PolynomialScratch::getResults<ErrorTracker>() {
+    return m_resultsErrorTracker;
+}
+
+template<>
+inline std::vector<std::vector<RoundedInterval> >& PolynomialScratch::getResults<RoundedInterval>() {
+    return m_resultsRoundedInterval;
+}
+
+template<>
+inline std::vector<std::vector<DualNumber> >& PolynomialScratch::getResults<DualNumber>() {
+    return m_resultsDualNumber;
+}
+
+template<>
+inline std::vector<double>& PolynomialScratch::getSparsePowers<double>() {
+    return m_sparsePowers;
+}
+
+template<>
+inline std::vector<ErrorTracker>& PolynomialScratch::getSparsePowers<ErrorTracker>() {
+    return m_sparsePowersErrorTracker;
+}
+
+template<>
+inline std::vector<RoundedInterval>& PolynomialScratch::getSparsePowers<RoundedInterval>() {
+    return m_sparsePowersRoundedInterval;
+}
+
+template<>
+inline std::vector<DualNumber>& PolynomialScratch::getSparsePowers<DualNumber>() {
+    return m_sparsePowersDualNumber;
+}
+
+template<>
+inline ChebyshevClenshawScratch<double>& PolynomialScratch::getClenshaw<double>() {
+    return m_clenshawDouble;
+}
+
+template<>
+inline ChebyshevClenshawScratch<ErrorTracker>& PolynomialScratch::getClenshaw<ErrorTracker>() {
+    return m_clenshawErrorTracker;
+}
+
+template<>
+inline ChebyshevClenshawScratch<RoundedInterval>& PolynomialScratch::getClenshaw<RoundedInterval>() {
+    return m_clenshawRoundedInterval;
+}
+
+template<>
+inline ChebyshevClenshawScratch<DualNumber>& PolynomialScratch::getClenshaw<DualNumber>() {
+    return m_clenshawDualNumber;
+}
 
 struct Monomial {
     std::vector<size_t> spot;
@@ -28,8 +147,8 @@ struct Monomial {
         m_readyToEval = false;
     }
     
-    template<typename ReturnType>
-    ReturnType evaluate(const std::vector<double>& _values) const {
+    template<typename ReturnType, typename ValueType = double>
+    ReturnType evaluate(const std::vector<ValueType>& _values) const {
         //This is just used for the unit tests for now
         assert(spot.size() == _values.size());
         ReturnType result = coeff;
@@ -39,52 +158,78 @@ struct Monomial {
         return result;
     }
     
-    void evaluateGrid(const std::vector<std::vector<double> >& _grid, std::vector<double>& _results) {
-        //Create the grid for only the dimensions we are using.
-        std::vector<const std::vector<double>*> usedGrid;
-        std::vector<size_t> usedSpots;
+    void evaluateGrid(const std::vector<std::vector<double> >& _grid, std::vector<double>& _results, PolynomialScratch& _scratch) const {
+        assert(m_numUsedDimensions != 0);
+        assert(_grid[0].size() != 0);
+        const size_t gridSize = _grid[0].size();
+        std::vector<double>& axisValues = _scratch.m_axisValues;
+        if(axisValues.size() < gridSize) {
+            axisValues.resize(gridSize);
+        }
+
+        //The result is the outer product of the powers on each grid axis, so each power is only computed once per axis.
+        size_t blockSize = 0;
         for(size_t dim = 0; dim < _grid.size(); dim++) {
-            if(m_hasDimension[dim]) {
-                usedGrid.push_back(&_grid[dim]);
-                usedSpots.push_back(spot[dim]);
+            if(!m_hasDimension[dim]) {
+                continue;
             }
+            const std::vector<double>& axis = _grid[dim];
+            if(blockSize == 0) {
+                //The first used dimension fills in the first block
+                for(size_t i = 0; i < gridSize; i++) {
+                    _results[i] = coeff * power(axis[i], spot[dim]);
+                }
+                blockSize = gridSize;
+                continue;
+            }
+            for(size_t i = 0; i < gridSize; i++) {
+                axisValues[i] = power(axis[i], spot[dim]);
+            }
+            //Go backwards so block 0 is overwritten last, as it's the one being copied.
+            for(size_t block = gridSize - 1; block < gridSize; block--) {
+                const double multiplier = axisValues[block];
+                double* blockResults = _results.data() + block * blockSize;
+                for(size_t j = 0; j < blockSize; j++) {
+                    blockResults[j] = _results[j] * multiplier;
+                }
+            }
+            blockSize *= gridSize;
         }
-        assert(usedGrid.size() != 0);
-        assert(usedGrid[0]->size() != 0);
-        
-        //For convenience, create a reference to where the result will always be
-        const size_t lastDim = m_numUsedDimensions - 1;
-        double& resultValue = m_evaluationInfo[0];
-        size_t resultSpot = 0;
-
-        //Track the spot we are currently evaluating.
-        std::vector<size_t> evalSpot(m_numUsedDimensions,0);
+    }
 
-        //Evaluate the first point in the grid.
-        m_evaluationInfo[lastDim] = power((*usedGrid[lastDim])[0], usedSpots[lastDim]) * coeff;
-        for(size_t dim = lastDim-1; dim < m_numUsedDimensions; dim--) {
-            m_evaluationInfo[dim] = power((*usedGrid[dim])[0], usedSpots[dim]) * m_evaluationInfo[dim+1];
-        }
-        _results[resultSpot++] = resultValue;
-        
-        //Iterate through all the combinations
-        size_t spotToInc = 0;
-        while (spotToInc < m_numUsedDimensions) {
-            while(++evalSpot[spotToInc] < _grid[0].size()) {
-                //Update the evaluations of the higher dimensions if needed
-                while(spotToInc > 0) {
-                    m_evaluationInfo[spotToInc] = power((*usedGrid[spotToInc])[evalSpot[spotToInc]], usedSpots[spotToInc]) * (spotToInc == lastDim ? coeff : m_evaluationInfo[spotToInc+1]);
-                    spotToInc--;
-                }
-                //Evaluate the final dimension and get the result
-                m_evaluationInfo[0] = power((*usedGrid[0])[evalSpot[0]], usedSpots[0]) * (0 == lastDim ? coeff : m_evaluationInfo[1]);
-                _results[resultSpot++] = resultValue;
+    //The largest absolute value of the monomial where each |x_i| <= _maxAbsValues[i].
+    //If _chebyshevBasis the spot is the degree of a Chebyshev polynomial, which is at most 1 in absolute value on [-1,1].
+    double getMagnitudeBound(const std::vector<double>& _maxAbsValues, bool _chebyshevBasis = false) const {
+        double result = std::abs(coeff);
+        for(size_t i = 0; i < spot.size(); i++) {
+            if(spot[i] == 0) {
+                continue;
+            }
+            if(!_chebyshevBasis) {
+                result *= power(_maxAbsValues[i], spot[i]);
+            }
+            else if(_maxAbsValues[i] > 1) {
+                //Chebyshev polynomials increase outside of [-1,1]
+                result *= chebPower(_maxAbsValues[i], spot[i]);
             }
-            evalSpot[spotToInc] = 0;
-            spotToInc++;
         }
+        return result;
     }
-    
+
+    size_t getDegree() const {
+        size_t degree = 0;
+        for(size_t i = 0; i < spot.size(); i++) {
+            degree += spot[i];
+        }
+        return degree;
+    }
+
+    //Bounds the rounding error of evaluateGrid anywhere on a grid where each |x_i| <= _maxAbsValues[i].
+    //Each power takes at most spot[i] multiplications, and each one has a relative error of machineEpsilon.
+    double getEvaluationErrorBound(const std::vector<double>& _maxAbsValues) const {
+        return (getDegree() + 1) * machineEpsilon * getMagnitudeBound(_maxAbsValues);
+    }
+
     void prepEvaluation() {
         m_readyToEval = true;
         //Get the dimension info
@@ -95,9 +240,6 @@ struct Monomial {
             m_hasDimension[i] = spot[i] != 0;
             m_numUsedDimensions += spot[i] != 0;
         }
-
-        //Get the evaluate grid info
-        m_evaluationInfo.resize(m_numUsedDimensions, 0.0);
     }
     
     //Overwrite multiplication by a monomial
@@ -124,7 +266,6 @@ private:
     bool                m_readyToEval;
     std::vector<bool>   m_hasDimension;
     size_t              m_numUsedDimensions;
-    std::vector<double> m_evaluationInfo;
 };
 
 //Custom struct for sorting monomials. Sorts it [0,0],[0,1],[1,0],[1,1]
@@ -145,6 +286,7 @@ struct CustomMonomialLess {
 
 struct PolynomialDimensionEvalInfo {
     PolynomialDimensionEvalInfo():
+    m_numResults(0),
     m_lastP0(-1),
     m_lastP1(-1),
     m_rowStart(0)
@@ -154,9 +296,9 @@ struct PolynomialDimensionEvalInfo {
     //Then multiplied by value^powerMultiplier[i] and stored in results[i]
     //For example, x^5+3x^4-2x^3 would be stored as three points in the incoming vector, with a power multipler of 3.
     //The power multiplier allows quicker evaluations for sparse things like x^100 as opposed to looping over 100 0's.
-    template<typename ReturnType, typename InputType>
-    void evaluate(const std::vector<InputType>& _coeffs, const double _value) {
-        for(size_t evalStep = 0; evalStep < m_results.size(); evalStep++) {
+    template<typename ReturnType, typename InputType, typename ValueType>
+    void evaluate(const std::vector<InputType>& _coeffs, const ValueType& _value, std::vector<ReturnType>& _results) const {
+        for(size_t evalStep = 0; evalStep < m_numResults; evalStep++) {
             int spot = m_breakPoints[evalStep+1];
             int end = m_breakPoints[evalStep];
             if(spot != end) {
@@ -167,16 +309,16 @@ struct PolynomialDimensionEvalInfo {
                 if(m_powerMultiplier[evalStep] != 0) {
                     result *= power(_value, m_powerMultiplier[evalStep]);
                 }
-                getResults<ReturnType>()[evalStep] = result;
+                _results[evalStep] = result;
             }
-            //else m_results[evalStep] = 0, but this will be initialized to 0 so always be that already.
+            //else _results[evalStep] = 0, but this will be initialized to 0 so always be that already.
         }
     }
         
     void addPoint(bool newPrev, int p0, int p1) {
         //p1 is the index in this dimension, p0, is the previous dimension, and newPrev is in anything is updated before that.
         //If newPrev is true or p0 increases, I'm on a new row
-        //  For every number p0 jumps when newPrev is false, duplicate the last number in m_breakPoints, and add 0 to m_powerMultiplier and m_results
+        //  For every number p0 jumps when newPrev is false, duplicate the last number in m_breakPoints, and add 0 to m_powerMultiplier and another result
         //If newPrev is false and p0 stays the same, wait until we hit the max p1 value, then add it to breakpoints
         if(newPrev) { //This should be true on the first call
             if(m_breakPoints.size() == 0) {
@@ -187,8 +329,7 @@ struct PolynomialDimensionEvalInfo {
                 m_breakPoints.push_back(bInc + m_breakPoints.back());
             }
             m_powerMultiplier.push_back(p1);
-            m_results.push_back(0);
-            m_resultsErrorTracker.push_back(0);
+            m_numResults++;
             m_rowStart = p1;
         }
         else if(p0 != m_lastP0){
@@ -197,12 +338,10 @@ struct PolynomialDimensionEvalInfo {
             for(int i = m_lastP0 + 1; i < p0; i++) { //The 0s we are skipping over
                 m_breakPoints.push_back(m_breakPoints.back());
                 m_powerMultiplier.push_back(0);
-                m_results.push_back(0);
-                m_resultsErrorTracker.push_back(0);
+                m_numResults++;
             }
             m_powerMultiplier.push_back(p1);
-            m_results.push_back(0);
-            m_resultsErrorTracker.push_back(0);
+            m_numResults++;
             m_rowStart = p1;
         }
         m_lastP0 = p0;
@@ -214,27 +353,10 @@ struct PolynomialDimensionEvalInfo {
         m_breakPoints.push_back(bInc + m_breakPoints.back());
     }
     
-    template<typename ReturnType>
-    inline std::vector<ReturnType>& getResults() {
-        
-    }
-
-    template<>
-    inline std::vector<double>& getResults() {
-        return m_results;
-    }
-
-    template<>
-    inline std::vector<ErrorTracker>& getResults() {
-        return m_resultsErrorTracker;
-    }
-
-    //m_breakPoints starts with -1 and is exactly 1 bigger than the other two.
+    //m_breakPoints starts with -1 and is exactly 1 bigger than m_powerMultiplier and the number of results.
     std::vector<int>        m_breakPoints;
     std::vector<size_t>     m_powerMultiplier;
-    
-    std::vector<double>         m_results;
-    std::vector<ErrorTracker>   m_resultsErrorTracker;
+    size_t                  m_numResults;
 
     //For addPoints
     int                     m_lastP0;
@@ -247,7 +369,8 @@ class Polynomial {
 public:
     Polynomial (size_t _rank) :
     m_rank(_rank),
-    m_readyToEval(false)
+    m_readyToEval(false),
+    m_sparseEvaluation(false)
     {}
 
     double evaluateSlow(const std::vector<double>& _values) { //Only use for testing and verifying
@@ -258,14 +381,22 @@ public:
         return result;
     }
 
-    template<typename ReturnType>
-    ReturnType evaluate(const std::vector<double>& _values) {
+    //Doesn't change the polynomial once it's been prepped, everything written to is in _scratch.
+    template<typename ReturnType, typename ValueType = double>
+    ReturnType evaluate(const std::vector<ValueType>& _values, PolynomialScratch& _scratch) {
         if(unlikely(!m_readyToEval)) {
             prepEvaluation();
         }
         if(unlikely(m_numUsedDimensions == 0)) { //Check the case of an empty polynomial.
             return static_cast<ReturnType>(m_constantTerm);
         }
+        if(m_sparseEvaluation) {
+            return evaluateSparse<ReturnType>(_values, _scratch);
+        }
+        if(unlikely(_scratch.getResults<ReturnType>().size() != m_numUsedDimensions)) {
+            prepScratch<ReturnType>(_scratch);
+        }
+        std::vector<std::vector<ReturnType> >& results = _scratch.getResults<ReturnType>();
         //Get the dimension to run and match it to the right value dimension
         const size_t lastDim = m_evaluationInfo.size() - 1;
         size_t valueEvalSpot = _values.size() - 1;
@@ -273,16 +404,21 @@ public:
             valueEvalSpot--;
         }
         //Evaluate the first dimension
-        m_evaluationInfo[lastDim].evaluate<ReturnType>(m_coeffs, _values[valueEvalSpot]);
+        m_evaluationInfo[lastDim].evaluate<ReturnType>(m_coeffs, _values[valueEvalSpot], results[lastDim]);
         //Loop through the rest of the dimensions.
         for(size_t dim = lastDim-1; dim < m_evaluationInfo.size(); dim--) {
             while(!m_hasDimension[--valueEvalSpot]) {} //Get to the next value dimension
-            m_evaluationInfo[dim].evaluate<ReturnType>(m_evaluationInfo[dim+1].getResults<ReturnType>(), _values[valueEvalSpot]);
+            m_evaluationInfo[dim].evaluate<ReturnType>(results[dim+1], _values[valueEvalSpot], results[dim]);
         }
-        return m_evaluationInfo[0].getResults<ReturnType>()[0];
+        return results[0][0];
     }
     
-    void evaluateGrid(const std::vector<std::vector<double> >& _grid, std::vector<double>& _results) {
+    template<typename ReturnType, typename ValueType = double>
+    ReturnType evaluate(const std::vector<ValueType>& _values) {
+        return evaluate<ReturnType>(_values, m_scratch);
+    }
+    
+    void evaluateGrid(const std::vector<std::vector<double> >& _grid, std::vector<double>& _results, PolynomialScratch& _scratch) {
         if(unlikely(!m_readyToEval)) {
             prepEvaluation();
         }
@@ -290,6 +426,19 @@ public:
             std::fill(_results.begin(), _results.end(), m_constantTerm);
             return;
         }
+        if(useTensorEvaluation(_grid[0].size())) {
+            evaluateGridTensor(_grid, _results, _scratch);
+            return;
+        }
+        if(m_sparseEvaluation) {
+            evaluateGridSparse(_grid, _results, _scratch);
+            return;
+        }
+        if(unlikely(_scratch.m_results.size() != m_numUsedDimensions)) {
+            prepScratch<double>(_scratch);
+        }
+        std::vector<std::vector<double> >& results = _scratch.m_results;
+        
         //Create the grid for only the dimensions we are using.
         std::vector<const std::vector<double>*> usedGrid;
         for(size_t dim = 0; dim < _grid.size(); dim++) {
@@ -302,16 +451,16 @@ public:
         
         //For convenience, create a reference to where the result will always be
         const size_t lastDim = m_numUsedDimensions - 1;
-        double& resultValue = m_evaluationInfo[0].m_results[0];
+        double& resultValue = results[0][0];
         size_t resultSpot = 0;
 
         //Track the spot we are currently evaluating.
         std::vector<size_t> evalSpot(m_numUsedDimensions,0);
 
         //Evaluate the first point in the grid.
-        m_evaluationInfo[lastDim].evaluate<double>(m_coeffs, (*usedGrid[lastDim])[0]);
+        m_evaluationInfo[lastDim].evaluate<double>(m_coeffs, (*usedGrid[lastDim])[0], results[lastDim]);
         for(size_t dim = lastDim-1; dim < m_numUsedDimensions; dim--) {
-            m_evaluationInfo[dim].evaluate<double>(m_evaluationInfo[dim+1].m_results, (*usedGrid[dim])[0]);
+            m_evaluationInfo[dim].evaluate<double>(results[dim+1], (*usedGrid[dim])[0], results[dim]);
         }
         _results[resultSpot++] = resultValue;
         
@@ -321,11 +470,11 @@ public:
             while(++evalSpot[spotToInc] < _grid[0].size()) {
                 //Update the evaluations of the higher dimensions if needed
                 while(spotToInc > 0) {
-                    m_evaluationInfo[spotToInc].evaluate<double>(spotToInc == lastDim ? m_coeffs : m_evaluationInfo[spotToInc+1].m_results, (*usedGrid[spotToInc])[evalSpot[spotToInc]]);
+                    m_evaluationInfo[spotToInc].evaluate<double>(spotToInc == lastDim ? m_coeffs : results[spotToInc+1], (*usedGrid[spotToInc])[evalSpot[spotToInc]], results[spotToInc]);
                     spotToInc--;
                 }
                 //Evaluate the final dimension and get the result
-                m_evaluationInfo[0].evaluate<double>(0 == lastDim ? m_coeffs : m_evaluationInfo[1].m_results, (*usedGrid[0])[evalSpot[0]]);
+                m_evaluationInfo[0].evaluate<double>(0 == lastDim ? m_coeffs : results[1], (*usedGrid[0])[evalSpot[0]], results[0]);
                 _results[resultSpot++] = resultValue;
             }
             evalSpot[spotToInc] = 0;
@@ -333,6 +482,146 @@ public:
         }
     }
     
+    void evaluateGrid(const std::vector<std::vector<double> >& _grid, std::vector<double>& _results) {
+        evaluateGrid(_grid, _results, m_scratch);
+    }
+    
+    //Evaluates the grid as the dense coefficient tensor contracted with the powers on each grid axis.
+    void evaluateGridTensor(const std::vector<std::vector<double> >& _grid, std::vector<double>& _results, PolynomialScratch& _scratch) {
+        if(unlikely(!m_readyToEval)) {
+            prepEvaluation();
+        }
+        if(unlikely(m_denseCoeffs.size() == 0)) {
+            //Only when called directly. evaluateGrid only uses this if the dense coefficients were made in prepEvaluation.
+            prepTensorEvaluation();
+        }
+        const size_t gridSize = _grid[0].size();
+        _scratch.m_basisTables.resize(m_numUsedDimensions);
+        size_t usedDim = 0;
+        for(size_t dim = 0; dim < _grid.size(); dim++) {
+            if(m_hasDimension[dim]) {
+                powerBasisTable(_grid[dim], m_numCoeffs[usedDim] - 1, _scratch.m_basisTables[usedDim]);
+                usedDim++;
+            }
+        }
+        contractTensorGrid(m_denseCoeffs, m_numCoeffs, _scratch.m_basisTables, gridSize, _scratch.m_buffer1, _scratch.m_buffer2, _results);
+    }
+
+    void evaluateGridTensor(const std::vector<std::vector<double> >& _grid, std::vector<double>& _results) {
+        evaluateGridTensor(_grid, _results, m_scratch);
+    }
+
+    //Evaluates the polynomial term by term from a table of the powers of each variable.
+    template<typename ReturnType, typename ValueType = double>
+    ReturnType evaluateSparse(const std::vector<ValueType>& _values, PolynomialScratch& _scratch) {
+        if(unlikely(!m_readyToEval)) {
+            prepEvaluation();
+        }
+        if(unlikely(m_numUsedDimensions == 0)) { //Check the case of an empty polynomial.
+            return static_cast<ReturnType>(m_constantTerm);
+        }
+        if(unlikely(m_sparseCoeffs.size() == 0)) {
+            //Only when called directly. evaluate only uses this if the sparse terms were made in prepEvaluation.
+            prepSparseEvaluation();
+        }
+        //Fill in the power tables, each variable is only raised to each power once.
+        std::vector<ReturnType>& powers = _scratch.getSparsePowers<ReturnType>();
+        powers.resize(m_sparseTableSize);
+        size_t usedDim = 0;
+        for(size_t dim = 0; dim < _values.size(); dim++) {
+            if(m_hasDimension[dim]) {
+                const size_t tableStart = m_sparseTableStarts[usedDim];
+                powers[tableStart] = ReturnType(1);
+                for(size_t k = 1; k <= m_sparseMaxPowers[usedDim]; k++) {
+                    powers[tableStart + k] = powers[tableStart + k - 1] * _values[dim];
+                }
+                usedDim++;
+            }
+        }
+        //Sum the terms
+        ReturnType result(0);
+        for(size_t term = 0; term < m_sparseCoeffs.size(); term++) {
+            ReturnType termValue = m_sparseCoeffs[term];
+            for(size_t spot = m_sparseTermStarts[term]; spot < m_sparseTermStarts[term+1]; spot++) {
+                termValue *= powers[m_sparsePowerSpots[spot]];
+            }
+            result += termValue;
+        }
+        return result;
+    }
+
+    template<typename ReturnType, typename ValueType = double>
+    ReturnType evaluateSparse(const std::vector<ValueType>& _values) {
+        return evaluateSparse<ReturnType>(_values, m_scratch);
+    }
+
+    //Evaluates the grid from a table of powers on each grid axis, shared by all the terms.
+    //The terms are sorted, so the ones with the same powers in the first dimensions are next to each other. Each group of
+    //them is summed over the later grid dimensions once and then multiplied out over the earlier ones.
+    void evaluateGridSparse(const std::vector<std::vector<double> >& _grid, std::vector<double>& _results, PolynomialScratch& _scratch) {
+        if(unlikely(!m_readyToEval)) {
+            prepEvaluation();
+        }
+        if(unlikely(m_numUsedDimensions == 0)) { //Check the case of an empty polynomial.
+            std::fill(_results.begin(), _results.end(), m_constantTerm);
+            return;
+        }
+        if(unlikely(m_sparseCoeffs.size() == 0)) {
+            //Only when called directly. evaluateGrid only uses this if the sparse terms were made in prepEvaluation.
+            prepSparseEvaluation();
+        }
+        const size_t gridSize = _grid[0].size();
+        _scratch.m_basisTables.resize(m_numUsedDimensions);
+        size_t usedDim = 0;
+        for(size_t dim = 0; dim < _grid.size(); dim++) {
+            if(m_hasDimension[dim]) {
+                powerBasisTable(_grid[dim], m_sparseMaxPowers[usedDim], _scratch.m_basisTables[usedDim]);
+                usedDim++;
+            }
+        }
+        //The sum for dimension i covers the grid dimensions after it.
+        std::vector<std::vector<double> >& sums = _scratch.m_sparseGridSums;
+        sums.resize(m_numUsedDimensions);
+        size_t sumSize = 1;
+        for(size_t dim = m_numUsedDimensions - 1; dim < m_numUsedDimensions; dim--) {
+            if(sums[dim].size() < sumSize) {
+                sums[dim].resize(sumSize);
+            }
+            sumSize *= gridSize;
+        }
+        std::fill(_results.begin(), _results.begin() + sumSize, 0.0);
+        addSparseGridTerms(0, 0, m_sparseCoeffs.size(), gridSize, sumSize / gridSize, _scratch.m_basisTables, sums, _results.data());
+    }
+
+    void evaluateGridSparse(const std::vector<std::vector<double> >& _grid, std::vector<double>& _results) {
+        evaluateGridSparse(_grid, _results, m_scratch);
+    }
+
+    //Compares the cost of nested Horner, or the sparse evaluation if it's used, to the tensor contraction for a grid with
+    //_gridSize points on each axis. Horner in dimension i is run once for every grid point in the dimensions at and after
+    //it, over every coefficient that reaches it. The contraction of dimension i is a dense matrix multiply over the same
+    //grid points and the coefficients at and before it. Horner can skip zeros, so sparse polynomials keep using it.
+    bool useTensorEvaluation(size_t _gridSize) const {
+        if(m_denseCoeffs.size() == 0) {
+            return false;
+        }
+        double hornerCost = 0;
+        double sparseCost = 0;
+        double tensorCost = 0;
+        for(size_t dim = 0; dim < m_numUsedDimensions; dim++) {
+            const double gridPoints = power(static_cast<double>(_gridSize), m_numUsedDimensions - dim);
+            hornerCost += gridPoints * m_hornerInputSize[dim];
+            tensorCost += gridPoints * m_densePrefixSize[dim] + _gridSize * m_numCoeffs[dim];
+            if(m_sparseEvaluation) {
+                sparseCost += gridPoints * m_sparseNumGroups[dim];
+            }
+        }
+        if(m_sparseEvaluation) {
+            return tensorCost < sparseCost;
+        }
+        return tensorCost * s_tensorCostWeight < hornerCost;
+    }
+
     void prepEvaluation() {
         std::vector<Monomial> monomialVector;
         for(const Monomial& m : m_monomials) {
@@ -353,6 +642,17 @@ public:
         }
     }
     
+    void multiplyPolynomial(const Polynomial& _other) {
+        //Multiplies every pair of monomials and adds them up in a new polynomial.
+        Polynomial product(m_rank);
+        for(const Monomial& m : m_monomials) {
+            for(const Monomial& otherM : _other.getMonomials()) {
+                product.addMonomial(m * otherM);
+            }
+        }
+        m_monomials.swap(product.m_monomials);
+    }
+    
     void addMonomials(const std::vector<Monomial>& _newMonomials) {
         for(const Monomial& m : _newMonomials) {
             addMonomial(m);
@@ -382,6 +682,41 @@ public:
         return m_monomials;
     }
     
+    size_t getTotalDegree() const {
+        size_t degree = 0;
+        for(const Monomial& m : m_monomials) {
+            size_t monomialDegree = 0;
+            for(size_t i = 0; i < m.spot.size(); i++) {
+                monomialDegree += m.spot[i];
+            }
+            degree = std::max(degree, monomialDegree);
+        }
+        return degree;
+    }
+
+    //Bounds the rounding error of evaluating the sum of _monomials anywhere on a grid where each |x_i| <= _maxAbsValues[i].
+    //Horner's method does two operations per degree in each dimension, each with a relative error of machineEpsilon.
+    //The error of Clenshaw's method can grow with the square of the degree.
+    static double getEvaluationErrorBound(const std::set<Monomial, CustomMonomialLess>& _monomials, const std::vector<double>& _maxAbsValues, bool _chebyshevBasis) {
+        double magnitude = 0;
+        std::vector<size_t> maxDegrees(_maxAbsValues.size(), 0);
+        for(const Monomial& m : _monomials) {
+            magnitude += m.getMagnitudeBound(_maxAbsValues, _chebyshevBasis);
+            for(size_t i = 0; i < m.spot.size(); i++) {
+                maxDegrees[i] = std::max(maxDegrees[i], m.spot[i]);
+            }
+        }
+        size_t numOperations = 1 + _monomials.size();
+        for(size_t i = 0; i < maxDegrees.size(); i++) {
+            numOperations += _chebyshevBasis ? 2 * power(maxDegrees[i] + 1, 2) : 2 * maxDegrees[i];
+        }
+        return numOperations * machineEpsilon * magnitude;
+    }
+
+    double getEvaluationErrorBound(const std::vector<double>& _maxAbsValues) const {
+        return getEvaluationErrorBound(m_monomials, _maxAbsValues, false);
+    }
+
     const std::vector<bool>& getHasDimension() const {
         return m_hasDimension;
     }
@@ -389,19 +724,139 @@ public:
     size_t getNumUsedDimensions() const {
         return m_numUsedDimensions;
     }
+
+    bool usesSparseEvaluation() const {
+        return m_sparseEvaluation;
+    }
     
     void clear() {
         m_coeffs.clear();
+        m_denseCoeffs.clear();
         m_evaluationInfo.clear();
         m_hasDimension.clear();
         m_numUsedDimensions = 0;
         m_constantTerm = 0;
         m_monomials.clear();
+        m_sparseEvaluation = false;
+        m_sparseCoeffs.clear();
     }
     
 private:
+    //Adds the terms in [_begin, _end), which all have the same powers before _dim, to _output over the grid dimensions _dim and after.
+    //_sumSize is the number of grid points after _dim.
+    void addSparseGridTerms(size_t _dim, size_t _begin, size_t _end, size_t _gridSize, size_t _sumSize, const std::vector<std::vector<double> >& _tables, std::vector<std::vector<double> >& _sums, double* _output) const {
+        if(_dim + 1 == m_numUsedDimensions) {
+            for(size_t term = _begin; term < _end; term++) {
+                const double* column = _tables[_dim].data() + m_sparsePowers[term * m_numUsedDimensions + _dim] * _gridSize;
+                const double coeff = m_sparseCoeffs[term];
+                for(size_t i = 0; i < _gridSize; i++) {
+                    _output[i] += coeff * column[i];
+                }
+            }
+            return;
+        }
+        double* sum = _sums[_dim].data();
+        size_t groupBegin = _begin;
+        while(groupBegin < _end) {
+            //Find the terms with the same power in this dimension
+            const size_t groupPower = m_sparsePowers[groupBegin * m_numUsedDimensions + _dim];
+            size_t groupEnd = groupBegin + 1;
+            while(groupEnd < _end && m_sparsePowers[groupEnd * m_numUsedDimensions + _dim] == groupPower) {
+                groupEnd++;
+            }
+            //Sum them over the later dimensions, then multiply that out over this one.
+            std::fill(sum, sum + _sumSize, 0.0);
+            addSparseGridTerms(_dim + 1, groupBegin, groupEnd, _gridSize, _sumSize / _gridSize, _tables, _sums, sum);
+            const double* column = _tables[_dim].data() + groupPower * _gridSize;
+            for(size_t spot = 0; spot < _sumSize; spot++) {
+                double* outputRow = _output + spot * _gridSize;
+                const double sumValue = sum[spot];
+                for(size_t i = 0; i < _gridSize; i++) {
+                    outputRow[i] += sumValue * column[i];
+                }
+            }
+            groupBegin = groupEnd;
+        }
+    }
+    
+    template<typename ReturnType>
+    void prepScratch(PolynomialScratch& _scratch) const {
+        std::vector<std::vector<ReturnType> >& results = _scratch.getResults<ReturnType>();
+        results.resize(m_numUsedDimensions);
+        for(size_t i = 0; i < m_numUsedDimensions; i++) {
+            results[i].assign(m_evaluationInfo[i].m_numResults, ReturnType(0));
+        }
+    }
+
+    void prepTensorEvaluation() {
+        m_denseCoeffs.assign(m_denseSize, 0.0);
+        for(const Monomial& m : m_monomials) {
+            size_t spot = 0;
+            size_t multiplier = 1;
+            size_t usedDim = 0;
+            for(size_t dim = 0; dim < m_rank; dim++) {
+                if(m_hasDimension[dim]) {
+                    spot += multiplier * m.spot[dim];
+                    multiplier *= m_numCoeffs[usedDim++];
+                }
+            }
+            m_denseCoeffs[spot] += m.coeff;
+        }
+    }
+
+    //Builds the sparse terms, sorted the same as the monomials. Each term has its coefficient, the spots of its powers in
+    //the table of powers of all the used variables, and its power in every used dimension for the grid evaluation.
+    void prepSparseEvaluation() {
+        m_sparseMaxPowers.assign(m_numUsedDimensions, 0);
+        for(const Monomial& m : m_monomials) {
+            size_t usedDim = 0;
+            for(size_t dim = 0; dim < m_rank; dim++) {
+                if(m_hasDimension[dim]) {
+                    m_sparseMaxPowers[usedDim] = std::max(m_sparseMaxPowers[usedDim], m.spot[dim]);
+                    usedDim++;
+                }
+            }
+        }
+        m_sparseTableStarts.resize(m_numUsedDimensions);
+        m_sparseTableSize = 0;
+        for(size_t usedDim = 0; usedDim < m_numUsedDimensions; usedDim++) {
+            m_sparseTableStarts[usedDim] = m_sparseTableSize;
+            m_sparseTableSize += m_sparseMaxPowers[usedDim] + 1;
+        }
+        
+        m_sparseCoeffs.clear();
+        m_sparsePowers.clear();
+        m_sparsePowerSpots.clear();
+        m_sparseTermStarts.assign(1, 0);
+        m_sparseNumGroups.assign(m_numUsedDimensions, 0);
+        const Monomial* prevMonomial = nullptr;
+        for(const Monomial& m : m_monomials) {
+            m_sparseCoeffs.push_back(m.coeff);
+            size_t usedDim = 0;
+            bool newGroup = prevMonomial == nullptr;
+            for(size_t dim = 0; dim < m_rank; dim++) {
+                if(m_hasDimension[dim]) {
+                    m_sparsePowers.push_back(m.spot[dim]);
+                    if(m.spot[dim] > 0) {
+                        m_sparsePowerSpots.push_back(m_sparseTableStarts[usedDim] + m.spot[dim]);
+                    }
+                    //Count the groups of terms with the same powers up to this dimension
+                    newGroup = newGroup || m.spot[dim] != prevMonomial->spot[dim];
+                    m_sparseNumGroups[usedDim] += newGroup;
+                    usedDim++;
+                }
+            }
+            m_sparseTermStarts.push_back(m_sparsePowerSpots.size());
+            prevMonomial = &m;
+        }
+    }
+    
     void prepEvaluation(std::vector<Monomial>& _monomials) { //Monomials gets destroyed here
         m_readyToEval = true;
+        m_scratch = PolynomialScratch();
+        m_denseCoeffs.clear();
+        m_sparseEvaluation = false;
+        m_sparseCoeffs.clear();
         if(unlikely(_monomials.size() == 0)) { //Check the case of an empty polynomial.
             m_numUsedDimensions = 0;
             m_constantTerm = 0.0;
@@ -488,6 +943,45 @@ private:
             m_evaluationInfo[i].endInit();
         }
         
+        //Get the info for the tensor evaluation cost model.
+        m_numCoeffs.assign(m_numUsedDimensions, 1);
+        for(size_t i = 0; i < _monomials.size(); i++) {
+            for(size_t j = 0; j < m_numUsedDimensions; j++) {
+                m_numCoeffs[j] = std::max(m_numCoeffs[j], _monomials[i].spot[j] + 1);
+            }
+        }
+        m_densePrefixSize.resize(m_numUsedDimensions);
+        m_hornerInputSize.resize(m_numUsedDimensions);
+        m_denseSize = 1;
+        for(size_t i = 0; i < m_numUsedDimensions; i++) {
+            m_denseSize *= m_numCoeffs[i];
+            m_densePrefixSize[i] = m_denseSize;
+            m_hornerInputSize[i] = i == lastDimension ? m_coeffs.size() : m_evaluationInfo[i+1].m_numResults;
+        }
+        //The dense coefficients are made here so evaluating never changes the polynomial. Skip them if they would be
+        //much bigger than the sparse ones, the cost model would never pick the tensor evaluation anyway.
+        if(m_denseSize <= s_maxDenseSize && (m_denseSize <= s_minDenseSize || m_denseSize <= s_maxDenseRatio * m_coeffs.size())) {
+            prepTensorEvaluation();
+        }
+        
+        //For sparse polynomials in many variables most of the Horner rows hold a single term, and each of them is padded
+        //with zeros and needs a power. The sparse terms only multiply the powers they use.
+        if(m_numUsedDimensions >= s_minSparseDimensions) {
+            prepSparseEvaluation();
+            double hornerCost = 0;
+            for(size_t i = 0; i < m_numUsedDimensions; i++) {
+                hornerCost += m_hornerInputSize[i] + m_evaluationInfo[i].m_numResults;
+                for(size_t multiplier : m_evaluationInfo[i].m_powerMultiplier) {
+                    hornerCost += multiplier > 1 ? s_powerCost : 0;
+                }
+            }
+            const double sparseCost = m_sparseTableSize + m_sparsePowerSpots.size() + m_sparseCoeffs.size();
+            m_sparseEvaluation = sparseCost < hornerCost;
+            if(!m_sparseEvaluation) {
+                m_sparseCoeffs.clear();
+            }
+        }
+        
         //TODO: Think about: Another option to maybe simplify things is if we have a bunch of zeros between things (x^8+x^2)
         //Store how many zeros are in between each loop, and then have a switch statement that multiplies by the power, just breaks if it's zero?
         //This might be good for not very dense things, but if it's dense it's a waste having the switch every time.
@@ -513,7 +1007,42 @@ private:
     //The monomials the make up the polynomial
     std::set<Monomial, CustomMonomialLess>      m_monomials;
     
+    //For the tensor evaluation. The dense coefficients over the used dimensions, first dimension changing fastest.
+    std::vector<double>                         m_denseCoeffs;
+    std::vector<size_t>                         m_numCoeffs;
+    size_t                                      m_denseSize;
+    //For the cost model. The dense coefficients in each dimension and before, and the size of each Horner input.
+    std::vector<size_t>                         m_densePrefixSize;
+    std::vector<size_t>                         m_hornerInputSize;
+    
+    //For the sparse evaluation. The terms in sorted order, with m_sparseTermStarts[i] the start of term i in m_sparsePowerSpots,
+    //the spots of its non-zero powers in a table of x^0...x^m_sparseMaxPowers[dim] for every used dimension.
+    bool                                        m_sparseEvaluation;
+    std::vector<double>                         m_sparseCoeffs;
+    std::vector<size_t>                         m_sparseTermStarts;
+    std::vector<size_t>                         m_sparsePowerSpots;
+    std::vector<size_t>                         m_sparseMaxPowers;
+    std::vector<size_t>                         m_sparseTableStarts;
+    size_t                                      m_sparseTableSize;
+    //The power of every term in every used dimension, and the number of groups of terms with the same powers up to each dimension.
+    std::vector<size_t>                         m_sparsePowers;
+    std::vector<size_t>                         m_sparseNumGroups;
+    
+    //Used by the evaluations that aren't given a scratch.
+    PolynomialScratch                           m_scratch;
+
     bool                                        m_readyToEval;
+    
+    //Horner does a dependent multiply add per coefficient with branching between rows, a matrix multiply flop is much cheaper.
+    static constexpr double                     s_tensorCostWeight = 0.25;
+    static constexpr size_t                     s_maxDenseSize = 1 << 20;
+    //Dense coefficients are always made below s_minDenseSize, and above it only if they are at most s_maxDenseRatio times the sparse ones.
+    static constexpr size_t                     s_minDenseSize = 4096;
+    static constexpr size_t                     s_maxDenseRatio = 16;
+    //The sparse evaluation is only considered for polynomials in this many variables, the ones solved with a runtime rank.
+    static constexpr size_t                     s_minSparseDimensions = 4;
+    //What a power in a Horner row costs compared to a multiply add.
+    static constexpr double                     s_powerCost = 4;
 };
 
 #endif /* Polynomial_h */
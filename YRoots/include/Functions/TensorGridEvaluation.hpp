@@ -0,0 +1,77 @@
+//
+//  TensorGridEvaluation.h
+//  YRoots
+//
+//  Created by Erik Hales Parkinson on 10/18/26.
+//  Copyright © 2026 Erik Hales Parkinson. All rights reserved.
+//
+
+#ifndef TensorGridEvaluation_h
+#define TensorGridEvaluation_h
+
+#include <vector>
+#include "Eigen/Dense"
+#include "Utilities/utilities.hpp"
+
+//Evaluates a dense coefficient tensor on a grid by contracting one dimension at a time against a table of basis
+//functions evaluated on that grid axis. Each step is a matrix multiply, so the basis functions on an axis are only
+//computed once instead of once per grid point. The last dimension is contracted first, the same order the nested
+//Horner and Clenshaw evaluations use, so the rounding matches the point evaluations as closely as possible.
+//  _coeffs is laid out with the first dimension changing fastest, with _numCoeffs[dim] entries in dimension dim.
+//  _bases[dim] is a column major (gridSize x _numCoeffs[dim]) table. Column k is basis function k on grid axis dim.
+//  _results is laid out the same way as evaluateGrid, with the first grid dimension changing fastest.
+//_buffer1 and _buffer2 are scratch space, they are resized as needed.
+void contractTensorGrid(const std::vector<double>& _coeffs, const std::vector<size_t>& _numCoeffs, const std::vector<std::vector<double> >& _bases, size_t _gridSize, std::vector<double>& _buffer1, std::vector<double>& _buffer2, std::vector<double>& _results) {
+    typedef Eigen::Map<const Eigen::MatrixXd> ConstMatrixMap;
+    typedef Eigen::Map<Eigen::MatrixXd> MatrixMap;
+
+    const size_t numDims = _numCoeffs.size();
+    assert(numDims > 0 && _bases.size() == numDims);
+
+    //The number of coefficients in the dimensions before the one being contracted
+    size_t prefixCoeffs = 1;
+    for(size_t dim = 0; dim < numDims; dim++) {
+        prefixCoeffs *= _numCoeffs[dim];
+    }
+
+    const double* input = _coeffs.data();
+    size_t numGridPoints = 1; //The number of grid points in the already contracted dimensions
+    for(size_t dim = numDims - 1; dim < numDims; dim--) {
+        const size_t numCoeffs = _numCoeffs[dim];
+        prefixCoeffs /= numCoeffs;
+
+        //Pick where to write to, ping-ponging between the buffers until the last contraction.
+        double* output;
+        const size_t outputSize = prefixCoeffs * _gridSize * numGridPoints;
+        if(dim == 0) {
+            output = _results.data();
+        }
+        else {
+            std::vector<double>& buffer = (dim % 2 == 0) ? _buffer1 : _buffer2;
+            if(buffer.size() < outputSize) {
+                buffer.resize(outputSize);
+            }
+            output = buffer.data();
+        }
+
+        ConstMatrixMap basis(_bases[dim].data(), _gridSize, numCoeffs);
+        if(dim == 0) {
+            //All the contracted grid points can be done in one multiply.
+            ConstMatrixMap inputMatrix(input, numCoeffs, numGridPoints);
+            MatrixMap outputMatrix(output, _gridSize, numGridPoints);
+            outputMatrix.noalias() = basis * inputMatrix;
+        }
+        else {
+            //Each contracted grid point has a (prefixCoeffs x numCoeffs) matrix that becomes a (prefixCoeffs x _gridSize) matrix.
+            for(size_t slice = 0; slice < numGridPoints; slice++) {
+                ConstMatrixMap inputMatrix(input + slice * prefixCoeffs * numCoeffs, prefixCoeffs, numCoeffs);
+                MatrixMap outputMatrix(output + slice * prefixCoeffs * _gridSize, prefixCoeffs, _gridSize);
+                outputMatrix.noalias() = inputMatrix * basis.transpose();
+            }
+        }
+        input = output;
+        numGridPoints *= _gridSize;
+    }
+}
+
+#endif /* TensorGridEvaluation_h */
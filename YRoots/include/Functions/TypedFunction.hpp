@@ -0,0 +1,175 @@
+//
+//  TypedFunction.hpp
+//  YRoots
+//
+//  Created by Erik Hales Parkinson on 10/19/26.
+//  Copyright © 2026 Erik Hales Parkinson. All rights reserved.
+//
+
+#ifndef TypedFunction_h
+#define TypedFunction_h
+
+#include <array>
+#include <memory>
+#include <type_traits>
+#include "Utilities/utilities.hpp"
+#include "Utilities/ErrorTracker.hpp"
+
+//For unpacking the coordinates of a point into the arguments of a callable.
+template<size_t... Indexes>
+struct ArgumentIndexes {};
+
+template<size_t N, size_t... Indexes>
+struct MakeArgumentIndexes : MakeArgumentIndexes<N - 1, N - 1, Indexes...> {};
+
+template<size_t... Indexes>
+struct MakeArgumentIndexes<0, Indexes...> {
+    typedef ArgumentIndexes<Indexes...> type;
+};
+
+template<size_t Index, typename T>
+struct RepeatArgument {
+    typedef T type;
+};
+
+//True if the callable can be called with one ArgumentType for each index.
+template<typename Callable, typename ArgumentType, typename Indexes, typename = void>
+struct IsCallableWith : std::false_type {};
+
+template<typename Callable, typename ArgumentType, size_t... Indexes>
+struct IsCallableWith<Callable, ArgumentType, ArgumentIndexes<Indexes...>, decltype(void(std::declval<const Callable&>()(std::declval<typename RepeatArgument<Indexes, ArgumentType>::type>()...)))> : std::true_type {};
+
+//True if the callable has it's own evaluateGrid(const std::vector<std::vector<double> >&, std::vector<double>&).
+template<typename Callable, typename = void>
+struct HasGridEvaluation : std::false_type {};
+
+template<typename Callable>
+struct HasGridEvaluation<Callable, decltype(void(std::declval<const Callable&>().evaluateGrid(std::declval<const std::vector<std::vector<double> >&>(), std::declval<std::vector<double>&>())))> : std::true_type {};
+
+//A function given as a C++ callable instead of a string, so nothing is parsed and the compiler can inline the
+//evaluation into the sampling loops. It can be used with the ChebyshevApproximator and IntervalApproximator
+//anywhere a Function can, as a TypedFunction<Rank, Callable>::SharedFunctionPtr.
+//The callable takes Rank arguments, one for each variable, like [](double x, double y) {return sin(x) - y;}.
+//If it's a functor with a templated call operator it's also evaluated with ErrorTrackers to bound the evaluation error,
+//otherwise only the rounding of the result is counted. If it has an evaluateGrid method that's used to evaluate grids,
+//so it can be vectorized. The grid results are in the same order as Function::evaluateGrid.
+template<int Rank, typename Callable>
+class TypedFunction {
+    static_assert(Rank > 0, "A TypedFunction needs a fixed number of variables!");
+    typedef typename MakeArgumentIndexes<Rank>::type Indexes;
+
+public:
+    typedef std::shared_ptr<TypedFunction<Rank, Callable> > SharedFunctionPtr;
+
+    TypedFunction(const Callable& _callable) : m_callable(_callable) {}
+
+    //The thread numbers are only to match Function, nothing is written to while evaluating.
+    template<typename ReturnType, typename InputType = double>
+    ReturnType evaluate(const std::vector<InputType>& _inputPoints, size_t _threadNum = 0) const {
+        assert(_inputPoints.size() == Rank);
+        return evaluatePoint<ReturnType>(_inputPoints.data(), IsCallableWith<Callable, ReturnType, Indexes>());
+    }
+
+    void evaluateGrid(const std::vector<std::vector<double> >& _grid, std::vector<double>& _results, size_t _threadNum = 0) const {
+        evaluateGrid(_grid, _results, HasGridEvaluation<Callable>());
+    }
+
+    //Matches Function::evaluateGridWithErrors.
+    void evaluateGridWithErrors(const std::vector<std::vector<double> >& _grid, std::vector<double>& _results, std::vector<double>& _errors, size_t _threadNum = 0) const {
+        const size_t gridSize = _grid[0].size();
+        const size_t numPoints = power(gridSize, Rank);
+        if(_errors.size() < numPoints) {
+            _errors.resize(numPoints);
+        }
+        std::array<double, Rank> point;
+        for(size_t dim = 0; dim < Rank; dim++) {
+            point[dim] = _grid[dim][0];
+        }
+        for(size_t line = 0; line < numPoints; line += gridSize) {
+            for(size_t i = 0; i < gridSize; i++) {
+                point[0] = _grid[0][i];
+                const ErrorTracker result = evaluatePoint<ErrorTracker>(point.data(), IsCallableWith<Callable, ErrorTracker, Indexes>());
+                _results[line + i] = result.value;
+                _errors[line + i] = result.error;
+            }
+            nextGridLine(_grid, line / gridSize + 1, point);
+        }
+    }
+
+    //Matches Function::evaluateBatch, _points[dim][i] is coordinate dim of point i.
+    template<typename ReturnType>
+    void evaluateBatch(const std::vector<std::vector<double> >& _points, std::vector<ReturnType>& _results, size_t _threadNum = 0) const {
+        const size_t numPoints = _points[0].size();
+        if(_results.size() < numPoints) {
+            _results.resize(numPoints);
+        }
+        std::array<double, Rank> point;
+        for(size_t i = 0; i < numPoints; i++) {
+            for(size_t dim = 0; dim < Rank; dim++) {
+                point[dim] = _points[dim][i];
+            }
+            _results[i] = evaluatePoint<ReturnType>(point.data(), IsCallableWith<Callable, ReturnType, Indexes>());
+        }
+    }
+
+    const Callable& getCallable() const {
+        return m_callable;
+    }
+
+private:
+    template<typename ReturnType, typename InputType, size_t... ArgumentNumbers>
+    ReturnType callWith(const InputType* _point, ArgumentIndexes<ArgumentNumbers...>) const {
+        return static_cast<ReturnType>(m_callable(static_cast<ReturnType>(_point[ArgumentNumbers])...));
+    }
+
+    template<typename ReturnType, typename InputType>
+    ReturnType evaluatePoint(const InputType* _point, std::true_type) const {
+        return callWith<ReturnType>(_point, Indexes());
+    }
+
+    //The callable only takes doubles, so the error is just from rounding the result.
+    template<typename ReturnType, typename InputType>
+    ReturnType evaluatePoint(const InputType* _point, std::false_type) const {
+        return static_cast<ReturnType>(callWith<double>(_point, Indexes()));
+    }
+
+    void evaluateGrid(const std::vector<std::vector<double> >& _grid, std::vector<double>& _results, std::true_type) const {
+        m_callable.evaluateGrid(_grid, _results);
+    }
+
+    void evaluateGrid(const std::vector<std::vector<double> >& _grid, std::vector<double>& _results, std::false_type) const {
+        //The first dimension changes fastest, so the inner loop runs along a line of the grid.
+        const size_t gridSize = _grid[0].size();
+        const size_t numPoints = power(gridSize, Rank);
+        std::array<double, Rank> point;
+        for(size_t dim = 0; dim < Rank; dim++) {
+            point[dim] = _grid[dim][0];
+        }
+        for(size_t line = 0; line < numPoints; line += gridSize) {
+            for(size_t i = 0; i < gridSize; i++) {
+                point[0] = _grid[0][i];
+                _results[line + i] = callWith<double>(point.data(), Indexes());
+            }
+            nextGridLine(_grid, line / gridSize + 1, point);
+        }
+    }
+
+    //Sets the coordinates past the first dimension for line number _lineNumber of the grid.
+    static void nextGridLine(const std::vector<std::vector<double> >& _grid, size_t _lineNumber, std::array<double, Rank>& _point) {
+        const size_t gridSize = _grid[0].size();
+        for(size_t dim = 1; dim < Rank; dim++) {
+            _point[dim] = _grid[dim][_lineNumber % gridSize];
+            _lineNumber /= gridSize;
+        }
+    }
+
+private:
+    Callable    m_callable;
+};
+
+template<int Rank, typename Callable>
+typename TypedFunction<Rank, Callable>::SharedFunctionPtr makeTypedFunction(const Callable& _callable) {
+    return std::make_shared<TypedFunction<Rank, Callable> >(_callable);
+}
+
+#endif /* TypedFunction_h */
@@ -25,25 +25,44 @@ public:
     m_filename(_filename)
     {
         m_timer.registerTimer(m_timerInputParserIndex, "Input Parser");
+        m_timer.registerTimer(m_timerFunctionParserIndex, "Function Parser");
     }
     
     void parse() {
         m_timer.startTimer(m_timerInputParserIndex);
 
-        //Read the whole file into a string
+        //Read the whole file into a string in one read
         std::ifstream inputFile;
-        std::string line;
-        std::string inputString;
-        inputFile.open(m_filename);
-        while(std::getline(inputFile, line)) {
-            if(line.length() > 0 && line[0] != '#') {
-                inputString += line;
-            }
+        std::string fileString;
+        inputFile.open(m_filename, std::ios::binary);
+        inputFile.seekg(0, std::ios::end);
+        const std::streamoff fileSize = inputFile.tellg();
+        if(fileSize > 0) {
+            fileString.resize(static_cast<size_t>(fileSize));
+            inputFile.seekg(0, std::ios::beg);
+            inputFile.read(&fileString[0], fileSize);
         }
         inputFile.close();
         
-        //Remove whitespace
-        inputString.erase(remove_if(inputString.begin(), inputString.end(), isspace), inputString.end());
+        //Copy it over in one pass, skipping comment lines and whitespace
+        std::string inputString;
+        inputString.reserve(fileString.length());
+        bool lineStart = true;
+        bool isComment = false;
+        for(const char c : fileString) {
+            if(c == '\n') {
+                lineStart = true;
+                isComment = false;
+                continue;
+            }
+            if(lineStart) {
+                isComment = c == '#';
+                lineStart = false;
+            }
+            if(!isComment && !isspace(static_cast<unsigned char>(c))) {
+                inputString += c;
+            }
+        }
         
         //Split by colons, remove everything after the last colon
         std::vector<std::string> lines = split(inputString, ";");
@@ -86,6 +105,8 @@ public:
         }
         
         m_timer.stopTimer(m_timerInputParserIndex);
+        m_timer.recordMemory("Input File", fileString.length());
+        m_timer.recordMemory("Peak Memory After Parsing", getPeakMemoryUsage());
     }
     
     //Getters
@@ -205,6 +226,9 @@ private:
                     printAndThrowRuntimeError("Parameter Error! minGoodZerosTol must be >= 0!");
                 }
             }
+            else if(parameterString[0] == "useChebyshevModels") {
+                m_subdivisionParameters.useChebyshevModels = parseBool(parameterString[1]);
+            }
             else if(parameterString[0] == "trackIntervals") {
                 m_generalParameters.trackIntervals = parseBool(parameterString[1]);
             }
@@ -299,6 +323,7 @@ private:
         //Get the individual functions
         bool foundEnd = false;
         m_functions.resize(m_generalParameters.numThreads);
+        m_timer.startTimer(m_timerFunctionParserIndex);
         while(parseSpot < lines.size()) {
             if(lines[parseSpot] == "FUNCTIONS_END") {
                 parseSpot++;
@@ -312,12 +337,13 @@ private:
             Function::addFunction(functionData[0], functionData[1], variableNames);
             parseSpot++;
         }
+        m_timer.stopTimer(m_timerFunctionParserIndex);
         
         if(!foundEnd) {
             printAndThrowRuntimeError("Parser Error! No FUNCTIONS_END Found!");
         }
         
-        //Duplicate the functions for all the threads
+        //Give every function scratch space for all the threads
         Function::addThreadFunctions(m_generalParameters.numThreads);
         
         //Make sure we found definitions for all the functions
@@ -338,9 +364,11 @@ private:
     GeneralParameters     m_generalParameters;
     
     static size_t           m_timerInputParserIndex;
+    static size_t           m_timerFunctionParserIndex;
     Timer&                  m_timer = Timer::getInstance();
 };
 
 size_t InputFileParser::m_timerInputParserIndex = -1;
+size_t InputFileParser::m_timerFunctionParserIndex = -1;
 
 #endif /* InputFileParser_h */
@@ -127,34 +127,37 @@ double inline chebValCubic(double d, double c, double b, double a, double value)
     return d + (c * value) + (b * (temp - 1)) + (a * (2 * temp * value - 3 * value));
 }
 
-double optimizeLine3(const Eigen::VectorXd& poly, double low, double high) {
-    if(unlikely(poly(3) == 0.0)) {
-        return optimizeLine2(poly, low, high);
-    }
-
-    double d = poly(0);
-    double c = poly(1);
-    double b = poly(2);
-    double a = poly(3);
-    double error = 0.0;
-    for(int i = 4; i < poly.size(); i++) {
-        error += std::abs(poly(i));
-    }
+//Finds the min and max of d + c*T1(x) + b*T2(x) + a*T3(x) for x in [low, high].
+void getChebCubicRange(double d, double c, double b, double a, double low, double high, double& minValue, double& maxValue) {
     double v1 = chebValCubic(d, c, b, a, low);
     double v2 = chebValCubic(d, c, b, a, high);
-    double minValue = std::min(v1, v2);
-    double maxValue = std::max(v1, v2);
+    minValue = std::min(v1, v2);
+    maxValue = std::max(v1, v2);
     
-    if(unlikely(b == 0.0)) { //Solving 12ax^2-3a+c = 0
+    if(a == 0.0) {
+        if(b != 0.0) { //Solving 4bx + c = 0
+            double der0point = -c/(4*b);
+            if (der0point > low && der0point < high) {
+                double v = chebValQuad(d, c, b, der0point);
+                minValue = std::min(minValue, v);
+                maxValue = std::max(maxValue, v);
+            }
+        }
+    }
+    else if(unlikely(b == 0.0)) { //Solving 12ax^2-3a+c = 0
         double value = 0.25 - c/(12*a);
         if(value > 0) {
             double der0Point = sqrt(value);
-            double v = chebValCubic(d, c, b, a, der0Point);
-            minValue = std::min(minValue, v);
-            maxValue = std::max(maxValue, v);
-            v = chebValCubic(d, c, b, a, -der0Point);
-            minValue = std::min(minValue, v);
-            maxValue = std::max(maxValue, v);
+            if(der0Point > low && der0Point < high) {
+                double v = chebValCubic(d, c, b, a, der0Point);
+                minValue = std::min(minValue, v);
+                maxValue = std::max(maxValue, v);
+            }
+            if(-der0Point > low && -der0Point < high) {
+                double v = chebValCubic(d, c, b, a, -der0Point);
+                minValue = std::min(minValue, v);
+                maxValue = std::max(maxValue, v);
+            }
         }
     }
     else { //Solving 12ax^2 + 4bx -3a+c = 0
@@ -179,10 +182,29 @@ double optimizeLine3(const Eigen::VectorXd& poly, double low, double high) {
             }
         }
     }
-    
+}
+
+double optimizeLine3(const Eigen::VectorXd& poly, double low, double high) {
+    if(unlikely(poly(3) == 0.0)) {
+        return optimizeLine2(poly, low, high);
+    }
+
+    double error = 0.0;
+    for(int i = 4; i < poly.size(); i++) {
+        error += std::abs(poly(i));
+    }
+    double minValue, maxValue;
+    getChebCubicRange(poly(0), poly(1), poly(2), poly(3), low, high, minValue, maxValue);
     return getOptimizeLineReturnValue(minValue, maxValue, error);
 }
 
+//Finds the min and max of T2(x) = 2x^2-1 for x in [low, high].
+void getChebQuadRange(double low, double high, double& minValue, double& maxValue) {
+    const double lowValue = 2*low*low - 1;
+    const double highValue = 2*high*high - 1;
+    minValue = (low < 0 && high > 0) ? -1.0 : std::min(lowValue, highValue);
+    maxValue = std::max(lowValue, highValue);
+}
 
 
 
@@ -0,0 +1,77 @@
+//
+//  ClusterChecker.hpp
+//  YRoots
+//
+//  Created by Erik Hales Parkinson on 10/19/26.
+//  Copyright © 2026 Erik Hales Parkinson. All rights reserved.
+//
+
+#ifndef ClusterChecker_h
+#define ClusterChecker_h
+
+#include <complex>
+#include "Eigen/Core"
+#include "Eigen/Dense"
+#include "Eigen/SVD"
+
+#include "Approximation/ChebyshevApproximation.hpp"
+#include "Utilities/utilities.hpp"
+#include "Utilities/Timer.hpp"
+#include "SolutionTracking/IntervalTracker.hpp"
+#include "SolutionTracking/RootTracker.hpp"
+
+//Finds intervals around a multiple root or a tight cluster of roots. The approximations never become linear near one of
+//those, so the interval would be subdivided until it's too deep. Halving an interval around a simple root halves the
+//linear terms of the approximations but quarters the quadratic ones, so the linear terms soon dominate. Around a cluster
+//the linear terms stay close to singular compared to the rest of the approximations however small the interval gets.
+//Once that has happened for s_minClusterLevels levels in a row and the interval is small, it's stored as a cluster with
+//an estimate of the number of roots in it, counted with multiplicity.
+template <int Rank>
+class ClusterChecker {
+public:
+    ClusterChecker(size_t _threadNum, size_t _rank, IntervalTracker& _intervalTracker, RootTracker& _rootTracker);
+
+    //Updates the cluster levels of the parameters. Returns true if the interval was stored as a cluster, so it doesn't need to be subdivided.
+    bool runClusterCheck(std::vector<ChebyshevApproximation<Rank> >& _chebyshevApproximations, SolveParameters* _parameters, size_t _numGoodApproximations);
+
+    //The estimated number of roots in the last cluster found.
+    size_t getMultiplicity() const {
+        return m_multiplicity;
+    }
+
+private:
+    size_t getCorank(std::vector<ChebyshevApproximation<Rank> >& _chebyshevApproximations);
+    size_t estimateMultiplicity(std::vector<ChebyshevApproximation<Rank> >& _chebyshevApproximations, size_t _corank);
+    bool isSmall(const Interval& _interval);
+
+private:
+    size_t                              m_threadNum;
+    size_t                              m_rank;
+    IntervalTracker&                    m_intervalTracker;
+    RootTracker&                        m_rootTracker;
+
+    size_t                              m_multiplicity;
+    std::vector<double>                 m_center;
+    //The linear terms of the approximations and the sum of the absolute values of the rest, each scaled by their sum.
+    typename EigenTypes<Rank>::Matrix   m_linearTerms;
+    typename EigenTypes<Rank>::Vector   m_rests;
+
+    //The linear terms are close to singular in a direction if it's singular value is at most this times the rest.
+    static constexpr double s_singularFactor = 4.0;
+    static constexpr size_t s_minClusterLevels = 8;
+    //Intervals this wide relative to the size of their bounds are small enough to be a cluster.
+    static constexpr double s_maxClusterWidth = 1e-6;
+    //Samples per degree of the approximation when counting it's zeros with the argument principle.
+    static constexpr size_t s_windingSamplesPerDegree = 8;
+
+    static size_t           m_timerClusterCheckIndex;
+    Timer&                  m_timer = Timer::getInstance();
+};
+
+template<int Rank>
+size_t ClusterChecker<Rank>::m_timerClusterCheckIndex = -1;
+
+#include "ClusterChecker1D.ipp"
+#include "ClusterCheckerND.ipp"
+
+#endif /* ClusterChecker_h */
@@ -0,0 +1,50 @@
+//
+//  ClusterChecker1D.ipp
+//  YRoots
+//
+//  Created by Erik Hales Parkinson on 10/19/26.
+//  Copyright © 2026 Erik Hales Parkinson. All rights reserved.
+//
+
+#ifndef ClusterChecker1D_ipp
+#define ClusterChecker1D_ipp
+
+template <>
+size_t ClusterChecker<1>::estimateMultiplicity(std::vector<ChebyshevApproximation<1> >& _chebyshevApproximations, size_t _corank)
+{
+    //Counts the zeros of the approximation in the unit disk, which contains the interval, with the argument principle.
+    //The winding number of p(e^it) around 0 is the number of zeros inside, including the complex ones of the cluster.
+    ChebyshevApproximation<1>& approximation = _chebyshevApproximations[0];
+    const double* coeffs = approximation.getArray();
+    const size_t degree = approximation.getPartialSideLength() - 1;
+    approximation.sumAbsValues();
+    const double minValue = 1e3 * std::numeric_limits<double>::epsilon() * approximation.getSumAbsVal();
+
+    const size_t numSamples = s_windingSamplesPerDegree * (degree + 1);
+    double totalAngle = 0.0;
+    std::complex<double> lastValue;
+    for(size_t sample = 0; sample <= numSamples; sample++) {
+        //Clenshaw's algorithm at z = e^it
+        const std::complex<double> z = std::polar(1.0, 2 * M_PI * sample / numSamples);
+        std::complex<double> oneAhead = 0.0;
+        std::complex<double> twoAhead = 0.0;
+        for(size_t k = degree; k > 0; k--) {
+            const std::complex<double> value = coeffs[k] + 2.0 * z * oneAhead - twoAhead;
+            twoAhead = oneAhead;
+            oneAhead = value;
+        }
+        const std::complex<double> value = coeffs[0] + z * oneAhead - twoAhead;
+        if(std::abs(value) < minValue) {
+            //A zero is too close to the circle to count it
+            return _corank + 1;
+        }
+        if(sample > 0) {
+            totalAngle += std::arg(value / lastValue);
+        }
+        lastValue = value;
+    }
+    const long numZeros = std::lround(totalAngle / (2 * M_PI));
+    return std::max(numZeros, static_cast<long>(_corank + 1));
+}
+
+#endif /* ClusterChecker1D_ipp */
@@ -0,0 +1,110 @@
+//
+//  ClusterCheckerND.ipp
+//  YRoots
+//
+//  Created by Erik Hales Parkinson on 10/19/26.
+//  Copyright © 2026 Erik Hales Parkinson. All rights reserved.
+//
+
+#ifndef ClusterCheckerND_ipp
+#define ClusterCheckerND_ipp
+
+template <int Rank>
+ClusterChecker<Rank>::ClusterChecker(size_t _threadNum, size_t _rank, IntervalTracker& _intervalTracker, RootTracker& _rootTracker) :
+m_threadNum(_threadNum),
+m_rank(_rank),
+m_intervalTracker(_intervalTracker),
+m_rootTracker(_rootTracker),
+m_multiplicity(0),
+m_center(_rank),
+m_linearTerms(_rank, _rank),
+m_rests(_rank)
+{
+    m_timer.registerTimer(m_timerClusterCheckIndex, "Cluster Check");
+}
+
+template <int Rank>
+bool ClusterChecker<Rank>::runClusterCheck(std::vector<ChebyshevApproximation<Rank> >& _chebyshevApproximations, SolveParameters* _parameters, size_t _numGoodApproximations)
+{
+    if(_numGoodApproximations < m_rank) {
+        _parameters->clusterLevels = 0;
+        return false;
+    }
+    m_timer.startTimer(m_timerClusterCheckIndex);
+    const size_t corank = getCorank(_chebyshevApproximations);
+    _parameters->clusterLevels = corank > 0 ? _parameters->clusterLevels + 1 : 0;
+    if(_parameters->clusterLevels < s_minClusterLevels || !isSmall(_parameters->interval)) {
+        m_timer.stopTimer(m_timerClusterCheckIndex);
+        return false;
+    }
+
+    //Store the middle of the interval as the cluster
+    Interval& interval = _parameters->interval;
+    for(size_t i = 0; i < m_rank; i++) {
+        m_center[i] = (interval.lowerBounds[i] + interval.upperBounds[i]) / 2;
+    }
+    m_multiplicity = estimateMultiplicity(_chebyshevApproximations, corank);
+    m_rootTracker.storeCluster(m_threadNum, m_center, interval, m_multiplicity);
+    m_intervalTracker.storeResult(m_threadNum, interval, SolveMethod::ClusterCheck, true);
+    m_timer.stopTimer(m_timerClusterCheckIndex);
+    return true;
+}
+
+template <int Rank>
+size_t ClusterChecker<Rank>::getCorank(std::vector<ChebyshevApproximation<Rank> >& _chebyshevApproximations)
+{
+    //Returns the number of singular values of the linear terms that are small compared to the rest of the approximations.
+    //Each singular value is compared to the rest of the combination of the approximations given by it's left singular vector.
+    for(size_t funcNum = 0; funcNum < m_rank; funcNum++) {
+        ChebyshevApproximation<Rank>& approximation = _chebyshevApproximations[funcNum];
+        const double* array = approximation.getArray();
+        const size_t sideLength = approximation.getSideLength();
+        const bool hasLinearTerms = approximation.getPartialSideLength() > 1;
+        double linearSum = 0.0;
+        size_t spot = 1;
+        for(size_t dim = 0; dim < m_rank; dim++) {
+            m_linearTerms(funcNum, dim) = hasLinearTerms ? array[spot] : 0.0;
+            linearSum += std::abs(m_linearTerms(funcNum, dim));
+            spot *= sideLength;
+        }
+        approximation.sumAbsValues();
+        const double rest = approximation.getSumAbsVal() - std::abs(array[0]) - linearSum + approximation.getApproximationError();
+        const double scale = linearSum + rest;
+        if(scale <= 0) {
+            //The approximation is constant, and not 0 everywhere or it would have been thrown out.
+            return 0;
+        }
+        m_linearTerms.row(funcNum) /= scale;
+        m_rests(funcNum) = std::max(0.0, rest) / scale;
+    }
+
+    Eigen::JacobiSVD<typename EigenTypes<Rank>::Matrix> svd(m_linearTerms, Eigen::ComputeFullU);
+    const typename EigenTypes<Rank>::Vector& singularValues = svd.singularValues();
+    size_t corank = 0;
+    for(size_t i = 0; i < m_rank; i++) {
+        const double rest = svd.matrixU().col(i).cwiseAbs().dot(m_rests);
+        corank += singularValues(i) <= s_singularFactor * rest;
+    }
+    return corank;
+}
+
+template <int Rank>
+size_t ClusterChecker<Rank>::estimateMultiplicity(std::vector<ChebyshevApproximation<Rank> >& _chebyshevApproximations, size_t _corank)
+{
+    //Each direction the linear terms vanish in adds at least one to the multiplicity of a root, so this is a lower bound.
+    return _corank + 1;
+}
+
+template <int Rank>
+bool ClusterChecker<Rank>::isSmall(const Interval& _interval)
+{
+    for(size_t i = 0; i < m_rank; i++) {
+        const double magnitude = std::max(1.0, std::max(std::abs(_interval.lowerBounds[i]), std::abs(_interval.upperBounds[i])));
+        if(_interval.upperBounds[i] - _interval.lowerBounds[i] > s_maxClusterWidth * magnitude) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#endif /* ClusterCheckerND_ipp */
@@ -32,12 +32,34 @@ public:
     
     bool runIntervalChecks(ChebyshevApproximation<Rank>& _approximation, Interval& _currentInterval);
     void runSubintervalChecks(std::vector<ChebyshevApproximation<Rank> >& _chebyshevApproximations, SolveParameters* _currentParameters, size_t _numGoodApproximations);
+    //Returns true if the derivatives show the approximations have at most one common zero in the interval.
+    bool runMonotonicityCheck(std::vector<ChebyshevApproximation<Rank> >& _chebyshevApproximations);
     
 protected:
     bool runConstantTermCheck(ChebyshevApproximation<Rank>& _approximation);
     void runQuadraticCheck(ChebyshevApproximation<Rank>& _approximation);
     void pushIntervalToSolve(SolveParameters* _currentParameters, const Interval& _newInterval);
     
+    //For the quadratic check in 3 or more dimensions
+    double getQuadraticPart(ChebyshevApproximation<Rank>& _approximation);
+    double evaluateQuadratic(const std::vector<double>& _point) const;
+    bool quadraticHasSign(const Interval& _subinterval, double _error);
+    bool findFaceStationaryPoint(size_t _numFreeDims, const Interval& _subinterval);
+    
+    //The cubic check, for subintervals the quadratic check couldn't throw out
+    void runCubicCheck(ChebyshevApproximation<Rank>& _approximation);
+    double getCubicPart(ChebyshevApproximation<Rank>& _approximation, double& _cubicCoeffSum);
+    bool cubicHasSign(const Interval& _subinterval, double _error);
+    
+    //The restricted series check, the constant term check on the approximation restricted to each subinterval
+    void runRestrictedSeriesCheck(ChebyshevApproximation<Rank>& _approximation);
+    void setRestrictionMatrices(size_t _partialSideLength);
+    void restrictDimension(const std::vector<double>& _input, std::vector<double>& _output, size_t _dim, size_t _side);
+    void restrictAndCheck(size_t _dim, size_t _subintervalPrefix);
+    
+    //The monotonicity check, bounds every partial derivative of an approximation on the interval
+    bool setDerivativeBounds(ChebyshevApproximation<Rank>& _approximation);
+    
     inline EvalSign getEvalSign(double _eval, double _error) {
         if(_eval > _error) {
             return EvalSign::Positive;
@@ -59,6 +81,55 @@ protected:
     std::vector<bool>       m_throwOutMask;
     Interval                m_tempInterval;
     std::vector<bool>       m_allowedToReduceDimension;
+    
+    //The quadratic part of the approximation in the power basis, m_quadraticConstant + b^T x + x^T A x.
+    double                  m_quadraticConstant;
+    std::vector<double>     m_quadraticLinear;
+    std::vector<double>     m_quadraticMatrix;
+    //For finding the stationary point of the quadratic on a face of a subinterval
+    std::vector<size_t>     m_faceFreeDims;
+    std::vector<double>     m_faceSystem;
+    std::vector<double>     m_facePoint;
+    //Every subinterval has 3^rank faces, so the check is too slow in high dimensions.
+    static constexpr size_t s_maxQuadraticCheckRank = 6;
+    
+    //A term of the cubic part with more than one variable, coefficient*T_degrees[0](x_dims[0])*...
+    struct CubicCrossTerm {
+        double  coefficient;
+        size_t  numFactors;
+        size_t  dims[3];
+        size_t  degrees[3];
+    };
+    //The cubic part of the approximation. The terms in one variable are bounded exactly on each subinterval
+    //and the cross terms with interval arithmetic.
+    double                      m_cubicConstant;
+    std::vector<double>         m_cubicSingleTerms; //The T1, T2, T3 coefficients of each dimension
+    std::vector<CubicCrossTerm> m_cubicCrossTerms;
+    //The cubic check only runs if it takes at least this fraction off the quadratic check's error.
+    static constexpr double     s_minCubicErrorReduction = 0.25;
+    //The max number of cubic terms times subintervals to bound in one check.
+    static constexpr size_t     s_maxCubicCheckWork = 4096;
+    
+    //The approximation restricted to the lower or upper part of the first dimensions, for each number of dimensions restricted.
+    std::vector<std::vector<double> >   m_restrictedCoeffs;
+    //Maps the coefficients of a 1D series to the coefficients on the lower or upper part of [-1,1]. Upper triangular.
+    std::vector<double>                 m_restrictionMatrices[2];
+    size_t                              m_restrictionSideLength;
+    double                              m_restrictionGrowth;
+    double                              m_restrictionError;
+    //The max number of multiplies for the restricted series check.
+    static constexpr size_t             s_maxRestrictionWork = 1 << 22;
+    
+    //The dense coefficients of an approximation, and bounds on the absolute value of each of it's partial derivatives.
+    std::vector<double>                 m_derivativeCoeffs;
+    std::vector<double>                 m_derivativeLowers;
+    std::vector<double>                 m_derivativeUppers;
+    //The variables a function has already been shown to be monotone in.
+    std::vector<bool>                   m_monotoneDims;
+    //The max number of coefficients times derivatives for the monotonicity check.
+    static constexpr size_t             s_maxMonotonicityWork = 1 << 20;
+    //The zeros of the functions can be this far apart on [-1,1]^n and still be counted as one.
+    static constexpr double             s_maxZeroSpread = 1e-8;
 
     //Multithreading objects
     size_t                              m_threadNum;
@@ -71,6 +142,9 @@ protected:
     //For Timing
     static size_t           m_timerBoundingIntervalIndex;
     static size_t           m_timerQuadraticCheckIndex;
+    static size_t           m_timerCubicCheckIndex;
+    static size_t           m_timerRestrictedSeriesCheckIndex;
+    static size_t           m_timerMonotonicityCheckIndex;
     Timer&                  m_timer = Timer::getInstance();
 };
 
@@ -78,6 +152,12 @@ template<int Rank>
 size_t IntervalChecker<Rank>::m_timerBoundingIntervalIndex = -1;
 template<int Rank>
 size_t IntervalChecker<Rank>::m_timerQuadraticCheckIndex = -1;
+template<int Rank>
+size_t IntervalChecker<Rank>::m_timerCubicCheckIndex = -1;
+template<int Rank>
+size_t IntervalChecker<Rank>::m_timerRestrictedSeriesCheckIndex = -1;
+template<int Rank>
+size_t IntervalChecker<Rank>::m_timerMonotonicityCheckIndex = -1;
 
 #include "BoundingIntervalUtilities.hpp"
 #include "IntervalChecker1D.ipp"
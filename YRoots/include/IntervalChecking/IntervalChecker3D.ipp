@@ -9,5 +9,76 @@
 #ifndef IntervalChecker3D_ipp
 #define IntervalChecker3D_ipp
 
+template <>
+bool IntervalChecker<3>::findFaceStationaryPoint(size_t _numFreeDims, const Interval& _subinterval)
+{
+    //Same as the general version, but the systems are at most 3x3 so they are solved directly with Cramer's rule.
+    double system[3][3];
+    double rhs[3];
+    double solution[3];
+    for(size_t row = 0; row < _numFreeDims; row++) {
+        const size_t rowDim = m_faceFreeDims[row];
+        rhs[row] = -m_quadraticLinear[rowDim];
+        for(size_t dim = 0; dim < 3; dim++) {
+            rhs[row] -= 2 * m_quadraticMatrix[rowDim*3 + dim] * m_facePoint[dim];
+        }
+        for(size_t col = 0; col < _numFreeDims; col++) {
+            const size_t colDim = m_faceFreeDims[col];
+            system[row][col] = 2 * m_quadraticMatrix[rowDim*3 + colDim];
+            rhs[row] += system[row][col] * m_facePoint[colDim];
+        }
+    }
+    
+    switch(_numFreeDims) {
+        case 1: {
+            if(system[0][0] == 0.0) {
+                return false;
+            }
+            solution[0] = rhs[0] / system[0][0];
+            break;
+        }
+        case 2: {
+            const double det = system[0][0]*system[1][1] - system[0][1]*system[1][0];
+            if(det == 0.0) {
+                return false;
+            }
+            solution[0] = (rhs[0]*system[1][1] - system[0][1]*rhs[1]) / det;
+            solution[1] = (system[0][0]*rhs[1] - rhs[0]*system[1][0]) / det;
+            break;
+        }
+        default: {
+            //The cofactors, the inverse is their transpose over the determinant.
+            const double c00 = system[1][1]*system[2][2] - system[1][2]*system[2][1];
+            const double c01 = system[1][2]*system[2][0] - system[1][0]*system[2][2];
+            const double c02 = system[1][0]*system[2][1] - system[1][1]*system[2][0];
+            const double c10 = system[0][2]*system[2][1] - system[0][1]*system[2][2];
+            const double c11 = system[0][0]*system[2][2] - system[0][2]*system[2][0];
+            const double c12 = system[0][1]*system[2][0] - system[0][0]*system[2][1];
+            const double c20 = system[0][1]*system[1][2] - system[0][2]*system[1][1];
+            const double c21 = system[0][2]*system[1][0] - system[0][0]*system[1][2];
+            const double c22 = system[0][0]*system[1][1] - system[0][1]*system[1][0];
+            const double det = system[0][0]*c00 + system[0][1]*c01 + system[0][2]*c02;
+            if(det == 0.0) {
+                return false;
+            }
+            solution[0] = (c00*rhs[0] + c10*rhs[1] + c20*rhs[2]) / det;
+            solution[1] = (c01*rhs[0] + c11*rhs[1] + c21*rhs[2]) / det;
+            solution[2] = (c02*rhs[0] + c12*rhs[1] + c22*rhs[2]) / det;
+            break;
+        }
+    }
+    
+    for(size_t row = 0; row < _numFreeDims; row++) {
+        const size_t dim = m_faceFreeDims[row];
+        //This is false for NaNs as well
+        if(!(solution[row] >= _subinterval.lowerBounds[dim] && solution[row] <= _subinterval.upperBounds[dim])) {
+            return false;
+        }
+    }
+    for(size_t row = 0; row < _numFreeDims; row++) {
+        m_facePoint[m_faceFreeDims[row]] = solution[row];
+    }
+    return true;
+}
 
 #endif /* IntervalChecker3D_ipp */
@@ -50,8 +50,34 @@ m_intervalBounder(m_rank)
         m_tempInterval.upperBounds.push_back(0.0);
     }
     
+    //Initialize the quadratic check
+    m_quadraticConstant = 0;
+    m_quadraticLinear.resize(m_rank);
+    m_quadraticMatrix.resize(m_rank * m_rank);
+    m_faceFreeDims.resize(m_rank);
+    m_faceSystem.resize(m_rank * (m_rank + 1));
+    m_facePoint.resize(m_rank);
+    
+    //Initialize the cubic check
+    m_cubicConstant = 0;
+    m_cubicSingleTerms.resize(3 * m_rank);
+    
+    //Initialize the restricted series check
+    m_restrictedCoeffs.resize(m_rank + 1);
+    m_restrictionSideLength = 0;
+    m_restrictionGrowth = 1.0;
+    m_restrictionError = 0.0;
+    
+    //Initialize the monotonicity check
+    m_derivativeLowers.resize(m_rank);
+    m_derivativeUppers.resize(m_rank);
+    m_monotoneDims.resize(m_rank);
+    
     m_timer.registerTimer(m_timerBoundingIntervalIndex, "Bounding Interval");
     m_timer.registerTimer(m_timerQuadraticCheckIndex, "Quadratic Check");
+    m_timer.registerTimer(m_timerCubicCheckIndex, "Cubic Check");
+    m_timer.registerTimer(m_timerRestrictedSeriesCheckIndex, "Restricted Series Check");
+    m_timer.registerTimer(m_timerMonotonicityCheckIndex, "Monotonicity Check");
 }
 
 template <int Rank>
@@ -109,6 +135,16 @@ void IntervalChecker<Rank>::runSubintervalChecks(std::vector<ChebyshevApproximat
         m_timer.startTimer(m_timerQuadraticCheckIndex);
         runQuadraticCheck(_chebyshevApproximations[i]);
         m_timer.stopTimer(m_timerQuadraticCheckIndex);
+        m_timer.startTimer(m_timerCubicCheckIndex);
+        runCubicCheck(_chebyshevApproximations[i]);
+        m_timer.stopTimer(m_timerCubicCheckIndex);
+    }
+    
+    //Run the restricted series checks
+    for(size_t i = 0; i < _numGoodApproximations; i++) {
+        m_timer.startTimer(m_timerRestrictedSeriesCheckIndex);
+        runRestrictedSeriesCheck(_chebyshevApproximations[i]);
+        m_timer.stopTimer(m_timerRestrictedSeriesCheckIndex);
     }
     
     //Check how many intervals we are running
@@ -140,6 +176,105 @@ void IntervalChecker<Rank>::runSubintervalChecks(std::vector<ChebyshevApproximat
     }
 }
 
+template <int Rank>
+bool IntervalChecker<Rank>::runMonotonicityCheck(std::vector<ChebyshevApproximation<Rank> >& _chebyshevApproximations)
+{
+    //If each function is monotone in a different variable, and that partial derivative is bigger than the sum of it's other
+    //partials everywhere by a margin, the Jacobian is strictly diagonally dominant on the whole interval. By the mean value
+    //theorem |p_i(x) - p_i(y)| >= margin_i*|x - y| for some i, so the approximations have at most one zero. In 1D this is
+    //just p being monotone. The functions are within the approximation errors of them, so any two zeros of the functions
+    //are within 2*error_i/margin_i of each other, which has to be small enough to call them the same zero.
+    m_timer.startTimer(m_timerMonotonicityCheckIndex);
+    std::fill(m_monotoneDims.begin(), m_monotoneDims.end(), false);
+    bool unique = true;
+    for(size_t funcNum = 0; funcNum < m_rank && unique; funcNum++) {
+        if(!setDerivativeBounds(_chebyshevApproximations[funcNum])) {
+            unique = false;
+            break;
+        }
+        double upperSum = 0.0;
+        for(size_t dim = 0; dim < m_rank; dim++) {
+            upperSum += m_derivativeUppers[dim];
+        }
+        //At most one variable can dominate the others
+        size_t monotoneDim = m_rank;
+        for(size_t dim = 0; dim < m_rank; dim++) {
+            if(m_derivativeLowers[dim] > upperSum - m_derivativeUppers[dim]) {
+                monotoneDim = dim;
+            }
+        }
+        if(monotoneDim == m_rank || m_monotoneDims[monotoneDim]) {
+            unique = false;
+            break;
+        }
+        m_monotoneDims[monotoneDim] = true;
+        const double margin = m_derivativeLowers[monotoneDim] - (upperSum - m_derivativeUppers[monotoneDim]);
+        unique = 2 * _chebyshevApproximations[funcNum].getApproximationError() <= s_maxZeroSpread * margin;
+    }
+    m_timer.stopTimer(m_timerMonotonicityCheckIndex);
+    return unique;
+}
+
+template <int Rank>
+bool IntervalChecker<Rank>::setDerivativeBounds(ChebyshevApproximation<Rank>& _approximation)
+{
+    //Sets the bounds on |df/dx_k| for each k from the Chebyshev coefficients of the derivative. Each one is the T_0 term
+    //plus the rest, which is at most the sum of the absolute values of the rest. Returns false if it's too big to be worth it.
+    const size_t partialSideLength = _approximation.getPartialSideLength();
+    const size_t numCoeffs = power(partialSideLength, m_rank);
+    if(partialSideLength < 2 || numCoeffs * m_rank > s_maxMonotonicityWork) {
+        return false;
+    }
+    
+    //Copy the good coefficients into a dense array
+    double* array = _approximation.getArray();
+    const size_t sideLength = _approximation.getSideLength();
+    m_derivativeCoeffs.resize(numCoeffs);
+    for(size_t spot = 0; spot < numCoeffs; spot++) {
+        size_t index = spot;
+        size_t arraySpot = 0;
+        size_t multiplier = 1;
+        for(size_t dim = 0; dim < m_rank; dim++) {
+            arraySpot += (index % partialSideLength) * multiplier;
+            index /= partialSideLength;
+            multiplier *= sideLength;
+        }
+        m_derivativeCoeffs[spot] = array[arraySpot];
+    }
+    
+    //The derivative in each dimension, from b_k = b_k+2 + 2(k+1)a_k+1 with b_0 halved
+    for(size_t dim = 0; dim < m_rank; dim++) {
+        const size_t stride = power(partialSideLength, dim);
+        const size_t blockSize = stride * partialSideLength;
+        double constantTerm = 0.0;
+        double sumAbsVal = 0.0;
+        for(size_t block = 0; block < numCoeffs; block += blockSize) {
+            for(size_t inner = 0; inner < stride; inner++) {
+                const size_t base = block + inner;
+                double twoAhead = 0.0;
+                double oneAhead = 0.0;
+                for(size_t k = partialSideLength-1; k-- > 0;) {
+                    double value = twoAhead + 2*(k+1)*m_derivativeCoeffs[base + (k+1)*stride];
+                    twoAhead = oneAhead;
+                    oneAhead = value;
+                    if(k == 0) {
+                        value /= 2;
+                        if(base == 0) {
+                            constantTerm = value;
+                        }
+                    }
+                    sumAbsVal += std::abs(value);
+                }
+            }
+        }
+        //Each derivative coefficient is a sum of up to partialSideLength terms
+        const double roundingError = 2 * partialSideLength * std::numeric_limits<double>::epsilon() * sumAbsVal;
+        m_derivativeLowers[dim] = 2*std::abs(constantTerm) - sumAbsVal - roundingError;
+        m_derivativeUppers[dim] = sumAbsVal + roundingError;
+    }
+    return true;
+}
+
 template <int Rank>
 bool IntervalChecker<Rank>::runConstantTermCheck(ChebyshevApproximation<Rank>& _approximation)
 {
@@ -151,7 +286,441 @@ bool IntervalChecker<Rank>::runConstantTermCheck(ChebyshevApproximation<Rank>& _
 template <int Rank>
 void IntervalChecker<Rank>::runQuadraticCheck(ChebyshevApproximation<Rank>& _approximation)
 {
-    //TODO: Updates m_intervalMask to false for each interval we should remove
+    //Sets m_intervalMask to true for each subinterval where the quadratic part has one sign and is bigger than the rest of the approximation.
+    if(m_rank > s_maxQuadraticCheckRank) {
+        return;
+    }
+    
+    //If it has all been thrown out we are done.
+    if(std::find(m_intervalMask.begin(), m_intervalMask.end(), false) == m_intervalMask.end()) {
+        return;
+    }
+    
+    const double error = getQuadraticPart(_approximation);
+    for(size_t i = 0; i < m_scaledSubIntervals.size(); i++) {
+        if(!m_intervalMask[i] && quadraticHasSign(m_scaledSubIntervals[i], error)) {
+            m_intervalMask[i] = true;
+        }
+    }
+}
+
+template <int Rank>
+double IntervalChecker<Rank>::getQuadraticPart(ChebyshevApproximation<Rank>& _approximation)
+{
+    //Gets the quadratic part in the power basis. T2(x) = 2x^2-1, so c*T2(x_i) adds 2c to A_ii and takes c from the constant.
+    //Returns the sum of the absolute values of everything else in the approximation, which bounds the rest of it.
+    double* array = _approximation.getArray();
+    _approximation.sumAbsValues();
+    double error = _approximation.getSumAbsVal() + _approximation.getApproximationError();
+    size_t partialSideLength = _approximation.getPartialSideLength();
+    size_t sideLength = _approximation.getSideLength();
+    
+    std::fill(m_quadraticLinear.begin(), m_quadraticLinear.end(), 0.0);
+    std::fill(m_quadraticMatrix.begin(), m_quadraticMatrix.end(), 0.0);
+    m_quadraticConstant = array[0];
+    error -= std::abs(array[0]);
+    size_t spotI = 1;
+    for(size_t i = 0; i < m_rank; i++) {
+        if(partialSideLength > 2) {
+            const double squareCoeff = array[2*spotI];
+            error -= std::abs(squareCoeff);
+            m_quadraticMatrix[i*m_rank + i] = 2*squareCoeff;
+            m_quadraticConstant -= squareCoeff;
+        }
+        if(partialSideLength > 1) {
+            m_quadraticLinear[i] = array[spotI];
+            error -= std::abs(array[spotI]);
+            //The x_i*x_j terms are split between A_ij and A_ji
+            size_t spotJ = spotI * sideLength;
+            for(size_t j = i+1; j < m_rank; j++) {
+                const double crossCoeff = array[spotI + spotJ];
+                error -= std::abs(crossCoeff);
+                m_quadraticMatrix[i*m_rank + j] = crossCoeff / 2;
+                m_quadraticMatrix[j*m_rank + i] = crossCoeff / 2;
+                spotJ *= sideLength;
+            }
+        }
+        spotI *= sideLength;
+    }
+    return error < 0.0 ? 0.0 : error; //Can be slightly negative from rounding
+}
+
+template <int Rank>
+double IntervalChecker<Rank>::evaluateQuadratic(const std::vector<double>& _point) const
+{
+    double value = m_quadraticConstant;
+    for(size_t i = 0; i < m_rank; i++) {
+        double rowSum = m_quadraticLinear[i];
+        for(size_t j = 0; j < m_rank; j++) {
+            rowSum += m_quadraticMatrix[i*m_rank + j] * _point[j];
+        }
+        value += rowSum * _point[i];
+    }
+    return value;
+}
+
+template <int Rank>
+bool IntervalChecker<Rank>::quadraticHasSign(const Interval& _subinterval, double _error)
+{
+    //The min and max of a quadratic on a box are at a stationary point of it on one of the faces of the box, including the
+    //box itself and the corners. Each face has every dimension at it's lower bound, at it's upper bound, or free.
+    //If a face has no stationary point, or a whole line of them, the extremes are on a smaller face.
+    const size_t numFaces = power(static_cast<size_t>(3), m_rank);
+    EvalSign subintervalSign = EvalSign::Zero;
+    for(size_t face = 0; face < numFaces; face++) {
+        size_t faceCode = face;
+        size_t numFreeDims = 0;
+        for(size_t dim = 0; dim < m_rank; dim++) {
+            switch(faceCode % 3) {
+                case 0:
+                    m_facePoint[dim] = _subinterval.lowerBounds[dim];
+                    break;
+                case 1:
+                    m_facePoint[dim] = _subinterval.upperBounds[dim];
+                    break;
+                default:
+                    m_faceFreeDims[numFreeDims++] = dim;
+                    break;
+            }
+            faceCode /= 3;
+        }
+        if(numFreeDims > 0 && !findFaceStationaryPoint(numFreeDims, _subinterval)) {
+            continue;
+        }
+        
+        //Face 0 is a corner, so it always sets the sign
+        const EvalSign faceSign = getEvalSign(evaluateQuadratic(m_facePoint), _error);
+        if(face == 0) {
+            subintervalSign = faceSign;
+        }
+        if(faceSign == EvalSign::Zero || faceSign != subintervalSign) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <int Rank>
+void IntervalChecker<Rank>::runCubicCheck(ChebyshevApproximation<Rank>& _approximation)
+{
+    //Sets m_intervalMask to true for each subinterval where the cubic part has one sign and is bigger than the rest of the approximation.
+    if(_approximation.getPartialSideLength() < 4) {
+        return;
+    }
+    size_t subintervalsLeft = 0;
+    for(size_t i = 0; i < m_intervalMask.size(); i++) {
+        subintervalsLeft += !m_intervalMask[i];
+    }
+    if(subintervalsLeft == 0) {
+        return;
+    }
+    
+    //The cost model. It's only worth bounding the cubic part if the cubic terms are a big part of the quadratic check's
+    //error, and if there aren't too many terms and subintervals to bound.
+    double cubicCoeffSum;
+    const double error = getCubicPart(_approximation, cubicCoeffSum);
+    if(cubicCoeffSum < s_minCubicErrorReduction * (error + cubicCoeffSum)) {
+        return;
+    }
+    if(subintervalsLeft * (m_cubicSingleTerms.size() + m_cubicCrossTerms.size()) > s_maxCubicCheckWork) {
+        return;
+    }
+    
+    for(size_t i = 0; i < m_scaledSubIntervals.size(); i++) {
+        if(!m_intervalMask[i] && cubicHasSign(m_scaledSubIntervals[i], error)) {
+            m_intervalMask[i] = true;
+        }
+    }
+}
+
+template <int Rank>
+double IntervalChecker<Rank>::getCubicPart(ChebyshevApproximation<Rank>& _approximation, double& _cubicCoeffSum)
+{
+    //Gets every term of degree 3 or less. Returns the sum of the absolute values of everything else in the approximation,
+    //and sets _cubicCoeffSum to the sum of the absolute values of the terms of degree 3.
+    double* array = _approximation.getArray();
+    _approximation.sumAbsValues();
+    double error = _approximation.getSumAbsVal() + _approximation.getApproximationError();
+    size_t sideLength = _approximation.getSideLength();
+    
+    m_cubicConstant = array[0];
+    error -= std::abs(array[0]);
+    _cubicCoeffSum = 0.0;
+    m_cubicCrossTerms.clear();
+    size_t spotI = 1;
+    for(size_t i = 0; i < m_rank; i++) {
+        for(size_t degree = 1; degree <= 3; degree++) {
+            m_cubicSingleTerms[3*i + degree - 1] = array[degree*spotI];
+            error -= std::abs(array[degree*spotI]);
+        }
+        _cubicCoeffSum += std::abs(array[3*spotI]);
+        
+        size_t spotJ = spotI * sideLength;
+        for(size_t j = i+1; j < m_rank; j++) {
+            //T1(x_i)T1(x_j), T2(x_i)T1(x_j) and T1(x_i)T2(x_j)
+            const CubicCrossTerm pairTerms[3] = {
+                {array[spotI + spotJ], 2, {i, j, 0}, {1, 1, 0}},
+                {array[2*spotI + spotJ], 2, {i, j, 0}, {2, 1, 0}},
+                {array[spotI + 2*spotJ], 2, {i, j, 0}, {1, 2, 0}}
+            };
+            for(size_t term = 0; term < 3; term++) {
+                if(pairTerms[term].coefficient != 0.0) {
+                    m_cubicCrossTerms.push_back(pairTerms[term]);
+                    error -= std::abs(pairTerms[term].coefficient);
+                    _cubicCoeffSum += term > 0 ? std::abs(pairTerms[term].coefficient) : 0.0;
+                }
+            }
+            //T1(x_i)T1(x_j)T1(x_k)
+            size_t spotK = spotJ * sideLength;
+            for(size_t k = j+1; k < m_rank; k++) {
+                const double coefficient = array[spotI + spotJ + spotK];
+                if(coefficient != 0.0) {
+                    m_cubicCrossTerms.push_back({coefficient, 3, {i, j, k}, {1, 1, 1}});
+                    error -= std::abs(coefficient);
+                    _cubicCoeffSum += std::abs(coefficient);
+                }
+                spotK *= sideLength;
+            }
+            spotJ *= sideLength;
+        }
+        spotI *= sideLength;
+    }
+    return error < 0.0 ? 0.0 : error; //Can be slightly negative from rounding
+}
+
+template <int Rank>
+bool IntervalChecker<Rank>::cubicHasSign(const Interval& _subinterval, double _error)
+{
+    //Bounds the cubic part on the subinterval. The terms in one variable are added up for each dimension and bounded
+    //exactly, the cross terms are bounded with the ranges of T1 and T2 on the subinterval.
+    double minValue = m_cubicConstant;
+    double maxValue = m_cubicConstant;
+    for(size_t dim = 0; dim < m_rank; dim++) {
+        double termMin, termMax;
+        getChebCubicRange(0.0, m_cubicSingleTerms[3*dim], m_cubicSingleTerms[3*dim+1], m_cubicSingleTerms[3*dim+2], _subinterval.lowerBounds[dim], _subinterval.upperBounds[dim], termMin, termMax);
+        minValue += termMin;
+        maxValue += termMax;
+    }
+    for(const CubicCrossTerm& term : m_cubicCrossTerms) {
+        double termMin = term.coefficient;
+        double termMax = term.coefficient;
+        for(size_t factor = 0; factor < term.numFactors; factor++) {
+            const size_t dim = term.dims[factor];
+            double factorMin = _subinterval.lowerBounds[dim];
+            double factorMax = _subinterval.upperBounds[dim];
+            if(term.degrees[factor] == 2) {
+                getChebQuadRange(_subinterval.lowerBounds[dim], _subinterval.upperBounds[dim], factorMin, factorMax);
+            }
+            const double products[4] = {termMin*factorMin, termMin*factorMax, termMax*factorMin, termMax*factorMax};
+            termMin = *std::min_element(products, products + 4);
+            termMax = *std::max_element(products, products + 4);
+        }
+        minValue += termMin;
+        maxValue += termMax;
+        
+        //Stop once it can't have a sign
+        if(minValue <= _error && maxValue >= -_error) {
+            return false;
+        }
+    }
+    return getEvalSign(minValue, _error) & getEvalSign(maxValue, _error);
+}
+
+template <int Rank>
+void IntervalChecker<Rank>::runRestrictedSeriesCheck(ChebyshevApproximation<Rank>& _approximation)
+{
+    //Sets m_intervalMask to true for each subinterval where the approximation restricted to it fails the constant term check.
+    //The restriction is an exact change of basis, so no new samples are needed.
+    if(std::find(m_intervalMask.begin(), m_intervalMask.end(), false) == m_intervalMask.end()) {
+        return;
+    }
+    const size_t partialSideLength = _approximation.getPartialSideLength();
+    const size_t numCoeffs = power(partialSideLength, m_rank);
+    if(partialSideLength < 2 || numCoeffs * partialSideLength * (2 << m_rank) > s_maxRestrictionWork) {
+        return;
+    }
+    setRestrictionMatrices(partialSideLength);
+    
+    //Copy the good coefficients into a dense array
+    double* array = _approximation.getArray();
+    const size_t sideLength = _approximation.getSideLength();
+    std::vector<double>& coeffs = m_restrictedCoeffs[0];
+    coeffs.resize(numCoeffs);
+    for(size_t spot = 0; spot < numCoeffs; spot++) {
+        size_t index = spot;
+        size_t arraySpot = 0;
+        size_t multiplier = 1;
+        for(size_t dim = 0; dim < m_rank; dim++) {
+            arraySpot += (index % partialSideLength) * multiplier;
+            index /= partialSideLength;
+            multiplier *= sideLength;
+        }
+        coeffs[spot] = array[arraySpot];
+    }
+    
+    //Each coefficient is a sum of partialSideLength products and each restriction can grow the sum of the absolute values
+    //by up to m_restrictionGrowth, which bounds the rounding error.
+    _approximation.sumAbsValues();
+    const double roundingError = 2 * m_rank * partialSideLength * std::numeric_limits<double>::epsilon() * power(m_restrictionGrowth, m_rank);
+    m_restrictionError = _approximation.getApproximationError() + roundingError * _approximation.getSumAbsVal();
+    restrictAndCheck(0, 0);
+}
+
+template <int Rank>
+void IntervalChecker<Rank>::setRestrictionMatrices(size_t _partialSideLength)
+{
+    //Column k of each matrix is T_k(alpha*t + beta) in the Chebyshev basis in t, from T_k+1 = 2yT_k - T_k-1 and t*T_j = (T_j+1 + T_|j-1|)/2.
+    if(_partialSideLength == m_restrictionSideLength) {
+        return;
+    }
+    m_restrictionSideLength = _partialSideLength;
+    m_restrictionGrowth = 1.0;
+    
+    const size_t n = _partialSideLength;
+    const double midPoint = 2*m_randomIntervalDivider - 1;
+    for(size_t side = 0; side < 2; side++) {
+        //The lower part is [-1, midPoint] and the upper part is [midPoint, 1]
+        const double alpha = side == 0 ? (midPoint + 1) / 2 : (1 - midPoint) / 2;
+        const double beta = side == 0 ? (midPoint - 1) / 2 : (midPoint + 1) / 2;
+        std::vector<double>& matrix = m_restrictionMatrices[side];
+        matrix.assign(n * n, 0.0);
+        matrix[0] = 1.0;
+        matrix[1] = beta;
+        matrix[n + 1] = alpha;
+        for(size_t k = 1; k + 1 < n; k++) {
+            for(size_t j = 0; j <= k; j++) {
+                const double value = matrix[j*n + k];
+                matrix[(j+1)*n + k+1] += alpha * value;
+                matrix[(j > 0 ? j-1 : 1)*n + k+1] += alpha * value;
+                matrix[j*n + k+1] += 2 * beta * value;
+            }
+            for(size_t j = 0; j < k; j++) {
+                matrix[j*n + k+1] -= matrix[j*n + k-1];
+            }
+        }
+        for(size_t k = 0; k < n; k++) {
+            double columnSum = 0.0;
+            for(size_t j = 0; j <= k; j++) {
+                columnSum += std::abs(matrix[j*n + k]);
+            }
+            m_restrictionGrowth = std::max(m_restrictionGrowth, columnSum);
+        }
+    }
+}
+
+template <int Rank>
+void IntervalChecker<Rank>::restrictDimension(const std::vector<double>& _input, std::vector<double>& _output, size_t _dim, size_t _side)
+{
+    //Applies the restriction matrix along dimension _dim of the coefficients
+    const size_t n = m_restrictionSideLength;
+    const size_t stride = power(n, _dim);
+    const size_t blockSize = stride * n;
+    const std::vector<double>& matrix = m_restrictionMatrices[_side];
+    _output.resize(_input.size());
+    for(size_t block = 0; block < _input.size(); block += blockSize) {
+        for(size_t inner = 0; inner < stride; inner++) {
+            const size_t base = block + inner;
+            for(size_t j = 0; j < n; j++) {
+                double value = 0.0;
+                for(size_t k = j; k < n; k++) {
+                    value += matrix[j*n + k] * _input[base + k*stride];
+                }
+                _output[base + j*stride] = value;
+            }
+        }
+    }
+}
+
+template <int Rank>
+void IntervalChecker<Rank>::restrictAndCheck(size_t _dim, size_t _subintervalPrefix)
+{
+    //The subintervals left under this one are the ones with the first _dim dimensions set by _subintervalPrefix.
+    const size_t numSubintervals = static_cast<size_t>(1) << (m_rank - _dim);
+    const size_t firstSubinterval = _subintervalPrefix << (m_rank - _dim);
+    if(std::find(m_intervalMask.begin() + firstSubinterval, m_intervalMask.begin() + firstSubinterval + numSubintervals, false) == m_intervalMask.begin() + firstSubinterval + numSubintervals) {
+        return;
+    }
+    
+    //If the series restricted in the first _dim dimensions has no zeros, none of the subintervals under it do.
+    if(_dim > 0) {
+        const std::vector<double>& coeffs = m_restrictedCoeffs[_dim];
+        double sumAbsVal = 0.0;
+        for(size_t i = 1; i < coeffs.size(); i++) {
+            sumAbsVal += std::abs(coeffs[i]);
+        }
+        if(std::abs(coeffs[0]) > sumAbsVal + m_restrictionError) {
+            std::fill(m_intervalMask.begin() + firstSubinterval, m_intervalMask.begin() + firstSubinterval + numSubintervals, true);
+            return;
+        }
+    }
+    if(_dim == m_rank) {
+        return;
+    }
+    
+    for(size_t side = 0; side < 2; side++) {
+        restrictDimension(m_restrictedCoeffs[_dim], m_restrictedCoeffs[_dim+1], _dim, side);
+        restrictAndCheck(_dim+1, (_subintervalPrefix << 1) | side);
+    }
+}
+
+template <int Rank>
+bool IntervalChecker<Rank>::findFaceStationaryPoint(size_t _numFreeDims, const Interval& _subinterval)
+{
+    //The gradient in the free dimensions is 0 when 2*A_ff*x_f = -b_f - 2*A_fc*x_c, where c are the fixed dimensions.
+    //Solves it with Gaussian elimination and partial pivoting. Puts the solution in m_facePoint and returns true
+    //if it's unique and in the subinterval.
+    const size_t width = _numFreeDims + 1;
+    for(size_t row = 0; row < _numFreeDims; row++) {
+        const size_t rowDim = m_faceFreeDims[row];
+        double rhs = -m_quadraticLinear[rowDim];
+        for(size_t dim = 0; dim < m_rank; dim++) {
+            rhs -= 2 * m_quadraticMatrix[rowDim*m_rank + dim] * m_facePoint[dim];
+        }
+        for(size_t col = 0; col < _numFreeDims; col++) {
+            const size_t colDim = m_faceFreeDims[col];
+            m_faceSystem[row*width + col] = 2 * m_quadraticMatrix[rowDim*m_rank + colDim];
+            //The free dimensions in m_facePoint aren't set yet, take them out of the right hand side.
+            rhs += 2 * m_quadraticMatrix[rowDim*m_rank + colDim] * m_facePoint[colDim];
+        }
+        m_faceSystem[row*width + _numFreeDims] = rhs;
+    }
+    
+    for(size_t col = 0; col < _numFreeDims; col++) {
+        size_t pivotRow = col;
+        for(size_t row = col+1; row < _numFreeDims; row++) {
+            if(std::abs(m_faceSystem[row*width + col]) > std::abs(m_faceSystem[pivotRow*width + col])) {
+                pivotRow = row;
+            }
+        }
+        if(m_faceSystem[pivotRow*width + col] == 0.0) {
+            return false;
+        }
+        if(pivotRow != col) {
+            for(size_t k = col; k < width; k++) {
+                std::swap(m_faceSystem[col*width + k], m_faceSystem[pivotRow*width + k]);
+            }
+        }
+        for(size_t row = col+1; row < _numFreeDims; row++) {
+            const double factor = m_faceSystem[row*width + col] / m_faceSystem[col*width + col];
+            for(size_t k = col; k < width; k++) {
+                m_faceSystem[row*width + k] -= factor * m_faceSystem[col*width + k];
+            }
+        }
+    }
+    for(size_t row = _numFreeDims - 1; row < _numFreeDims; row--) {
+        double value = m_faceSystem[row*width + _numFreeDims];
+        for(size_t col = row+1; col < _numFreeDims; col++) {
+            value -= m_faceSystem[row*width + col] * m_facePoint[m_faceFreeDims[col]];
+        }
+        value /= m_faceSystem[row*width + row];
+        const size_t dim = m_faceFreeDims[row];
+        //This is false for NaNs as well
+        if(!(value >= _subinterval.lowerBounds[dim] && value <= _subinterval.upperBounds[dim])) {
+            return false;
+        }
+        m_facePoint[dim] = value;
+    }
+    return true;
 }
 
 template <int Rank>
@@ -163,6 +732,7 @@ void IntervalChecker<Rank>::pushIntervalToSolve(SolveParameters* _currentParamet
 
     //Populate the other details
     _nextParameters->currentLevel = _currentParameters->currentLevel+1;
+    _nextParameters->clusterLevels = _currentParameters->clusterLevels;
     for(size_t i = 0; i < _nextParameters->goodDegrees.size(); i++) {
         _nextParameters->goodDegrees[i] = _currentParameters->goodDegrees[i];
     }
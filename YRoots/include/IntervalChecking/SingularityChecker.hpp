@@ -0,0 +1,257 @@
+//
+//  SingularityChecker.hpp
+//  YRoots
+//
+//  Created by Erik Hales Parkinson on 10/19/26.
+//  Copyright © 2026 Erik Hales Parkinson. All rights reserved.
+//
+
+#ifndef SingularityChecker_h
+#define SingularityChecker_h
+
+#include <set>
+#include "Functions/Function.hpp"
+#include "SolutionTracking/IntervalTracker.hpp"
+#include "Utilities/MultiPool.hpp"
+#include "Utilities/ConcurrentStack.hpp"
+#include "Utilities/Timer.hpp"
+#include "Utilities/utilities.hpp"
+#include "Utilities/RoundedInterval.hpp"
+
+//Where the argument of a function has to be for the function to be defined.
+enum SingularDomain {
+    NonZeroArgument, //Divisors and negative integer powers
+    PositiveArgument, //log, log10, log2, and bases of non-integer negative powers
+    NonNegativeArgument, //sqrt and bases of non-integer positive powers
+    TanArgument //tan, not at pi/2 + k*pi
+};
+
+//Finds where the functions aren't defined. Sampling across a pole or outside the domain of a log or sqrt gives infs and NaNs,
+//so the approximation is never good and the interval subdivides until it's too deep.
+//The argument of every log, sqrt, tan, division and power in the functions is bounded on the interval with RoundedIntervals.
+//If a function isn't defined anywhere on the interval it's thrown out. If the argument only depends on one variable the
+//singularity is the hyperplane where that variable is a fixed value. It's found by bisection, and the interval is split
+//there with a thin slab around it thrown out.
+class SingularityChecker {
+    struct SingularArgument {
+        Function::SharedFunctionPtr argument;
+        SingularDomain              domain;
+    };
+
+public:
+    SingularityChecker(size_t _rank, const std::vector<Function::SharedFunctionPtr>& _functions, IntervalTracker& _intervalTracker, size_t _threadNum, ConcurrentStack<SolveParameters>& _intervalsToRun, ObjectPool<SolveParameters>& _solveParametersPool) :
+    m_rank(_rank),
+    m_intervalTracker(_intervalTracker),
+    m_threadNum(_threadNum),
+    m_intervalsToRun(_intervalsToRun),
+    m_solveParametersPool(_solveParametersPool),
+    m_box(_rank),
+    m_point(_rank)
+    {
+        std::set<const Function*> visited;
+        for(const Function::SharedFunctionPtr& function : _functions) {
+            findSingularArguments(function, visited);
+        }
+        m_timer.registerTimer(m_timerSingularityCheckIndex, "Singularity Check");
+    }
+
+    //Returns true if the interval was thrown out or split, so it doesn't need to be solved.
+    bool runSingularityCheck(SolveParameters* _parameters) {
+        if(m_singularArguments.size() == 0) {
+            return false;
+        }
+        m_timer.startTimer(m_timerSingularityCheckIndex);
+        const Interval& interval = _parameters->interval;
+        for(size_t dim = 0; dim < m_rank; dim++) {
+            m_box[dim] = RoundedInterval(interval.lowerBounds[dim], interval.upperBounds[dim]);
+        }
+
+        bool handled = false;
+        for(const SingularArgument& singularArgument : m_singularArguments) {
+            const RoundedInterval enclosure = singularArgument.argument->evaluate<RoundedInterval>(m_box, m_threadNum);
+            double singularValue = 0;
+            switch(singularArgument.domain) {
+                case SingularDomain::NonZeroArgument:
+                    if(!enclosure.containsZero()) {
+                        continue;
+                    }
+                    break;
+                case SingularDomain::PositiveArgument:
+                    if(enclosure.upper <= 0) {
+                        //Not defined anywhere on the interval
+                        m_intervalTracker.storeResult(m_threadNum, _parameters->interval, SolveMethod::SingularityCheck, false);
+                        handled = true;
+                    }
+                    else if(enclosure.lower > 0) {
+                        continue;
+                    }
+                    break;
+                case SingularDomain::NonNegativeArgument:
+                    if(enclosure.upper < 0) {
+                        //Not defined anywhere on the interval
+                        m_intervalTracker.storeResult(m_threadNum, _parameters->interval, SolveMethod::SingularityCheck, false);
+                        handled = true;
+                    }
+                    else if(enclosure.lower >= 0) {
+                        continue;
+                    }
+                    break;
+                case SingularDomain::TanArgument:
+                    if(enclosure.width() < M_PI && !containsPeriodicPoint(enclosure.lower, enclosure.upper, M_PI / 2, M_PI)) {
+                        continue;
+                    }
+                    //The first pole past the lower bound
+                    singularValue = M_PI / 2 + M_PI * std::ceil((enclosure.lower - M_PI / 2) / M_PI);
+                    break;
+            }
+            if(handled || splitAtSingularity(_parameters, singularArgument.argument, singularValue)) {
+                handled = true;
+                break;
+            }
+        }
+        m_timer.stopTimer(m_timerSingularityCheckIndex);
+        return handled;
+    }
+
+private:
+    void findSingularArguments(const Function::SharedFunctionPtr& _function, std::set<const Function*>& _visited) {
+        if(!_visited.insert(_function.get()).second) {
+            return;
+        }
+        const std::vector<Function::SharedFunctionPtr>& subfunctions = _function->getSubfunctions();
+        switch(_function->getFunctionType()) {
+            case FunctionType::LOG:
+            case FunctionType::LOG10:
+            case FunctionType::LOG2:
+                m_singularArguments.push_back({subfunctions[0], SingularDomain::PositiveArgument});
+                break;
+            case FunctionType::SQRT:
+                m_singularArguments.push_back({subfunctions[0], SingularDomain::NonNegativeArgument});
+                break;
+            case FunctionType::TAN:
+                m_singularArguments.push_back({subfunctions[0], SingularDomain::TanArgument});
+                break;
+            case FunctionType::PRODUCT:
+                for(size_t i = 0; i < subfunctions.size(); i++) {
+                    if(!_function->getOperatorSigns()[i]) {
+                        m_singularArguments.push_back({subfunctions[i], SingularDomain::NonZeroArgument});
+                    }
+                }
+                break;
+            case FunctionType::POWER:
+                if(subfunctions[1]->getFunctionType() == FunctionType::CONSTANT) {
+                    const double exponent = subfunctions[1]->getValue();
+                    if(exponent == std::floor(exponent)) {
+                        if(exponent < 0) {
+                            m_singularArguments.push_back({subfunctions[0], SingularDomain::NonZeroArgument});
+                        }
+                    }
+                    else {
+                        m_singularArguments.push_back({subfunctions[0], exponent > 0 ? SingularDomain::NonNegativeArgument : SingularDomain::PositiveArgument});
+                    }
+                }
+                else {
+                    m_singularArguments.push_back({subfunctions[0], SingularDomain::PositiveArgument});
+                }
+                break;
+            default:
+                break;
+        }
+        for(const Function::SharedFunctionPtr& subfunction : subfunctions) {
+            findSingularArguments(subfunction, _visited);
+        }
+    }
+
+    //If _argument only depends on one variable, find where it equals _singularValue by bisection and split the interval there.
+    bool splitAtSingularity(SolveParameters* _parameters, const Function::SharedFunctionPtr& _argument, double _singularValue) {
+        const std::vector<bool>& hasDimension = _argument->getHasDimension();
+        if(hasDimension.size() != m_rank || _argument->getNumUsedDimensions() != 1) {
+            return false;
+        }
+        const size_t dim = std::find(hasDimension.begin(), hasDimension.end(), true) - hasDimension.begin();
+
+        //The other coordinates don't change the argument
+        const Interval& interval = _parameters->interval;
+        for(size_t i = 0; i < m_rank; i++) {
+            m_point[i] = (interval.lowerBounds[i] + interval.upperBounds[i]) / 2;
+        }
+        double lower = interval.lowerBounds[dim];
+        double upper = interval.upperBounds[dim];
+        m_point[dim] = lower;
+        const double lowerEval = _argument->evaluate<double>(m_point, m_threadNum) - _singularValue;
+        m_point[dim] = upper;
+        const double upperEval = _argument->evaluate<double>(m_point, m_threadNum) - _singularValue;
+        if(std::isnan(lowerEval) || std::isnan(upperEval) || (lowerEval > 0) == (upperEval > 0)) {
+            //Can't find where it is. Everything is NaN or there are an even number of crossings.
+            return false;
+        }
+        const bool lowerPositive = lowerEval > 0;
+        for(size_t iteration = 0; iteration < s_maxBisections; iteration++) {
+            const double middle = (lower + upper) / 2;
+            if(middle <= lower || middle >= upper) {
+                break;
+            }
+            m_point[dim] = middle;
+            if((_argument->evaluate<double>(m_point, m_threadNum) - _singularValue > 0) == lowerPositive) {
+                lower = middle;
+            }
+            else {
+                upper = middle;
+            }
+        }
+
+        //Throw out the slab around the singularity and push the parts on each side.
+        const double singularity = (lower + upper) / 2;
+        const double gap = s_slabWidthFactor * (interval.upperBounds[dim] - interval.lowerBounds[dim]);
+        const double slabLower = std::max(interval.lowerBounds[dim], singularity - gap);
+        const double slabUpper = std::min(interval.upperBounds[dim], singularity + gap);
+        if(slabLower > interval.lowerBounds[dim]) {
+            pushSplitInterval(_parameters, dim, interval.lowerBounds[dim], slabLower);
+        }
+        if(slabUpper < interval.upperBounds[dim]) {
+            pushSplitInterval(_parameters, dim, slabUpper, interval.upperBounds[dim]);
+        }
+        m_slab = interval;
+        m_slab.clear();
+        m_slab.lowerBounds[dim] = slabLower;
+        m_slab.upperBounds[dim] = slabUpper;
+        m_intervalTracker.storeResult(m_threadNum, m_slab, SolveMethod::SingularityCheck, false);
+        return true;
+    }
+
+    void pushSplitInterval(SolveParameters* _currentParameters, size_t _dim, double _lower, double _upper) {
+        SolveParameters* nextParameters = m_solveParametersPool.pop();
+        nextParameters->clear();
+        nextParameters->interval.lowerBounds = _currentParameters->interval.lowerBounds;
+        nextParameters->interval.upperBounds = _currentParameters->interval.upperBounds;
+        nextParameters->interval.lowerBounds[_dim] = _lower;
+        nextParameters->interval.upperBounds[_dim] = _upper;
+        nextParameters->currentLevel = _currentParameters->currentLevel+1;
+        for(size_t i = 0; i < nextParameters->goodDegrees.size(); i++) {
+            nextParameters->goodDegrees[i] = _currentParameters->goodDegrees[i];
+        }
+        m_intervalsToRun.push(m_threadNum, nextParameters);
+    }
+
+private:
+    size_t                              m_rank;
+    IntervalTracker&                    m_intervalTracker;
+    size_t                              m_threadNum;
+    ConcurrentStack<SolveParameters>&   m_intervalsToRun;
+    ObjectPool<SolveParameters>&        m_solveParametersPool;
+    std::vector<SingularArgument>       m_singularArguments;
+    std::vector<RoundedInterval>        m_box;
+    std::vector<double>                 m_point;
+    Interval                            m_slab;
+
+    //The width of the slab thrown out around a singularity, relative to the width of the interval.
+    static constexpr double s_slabWidthFactor = 1e-10;
+    static constexpr size_t s_maxBisections = 100;
+
+    static size_t m_timerSingularityCheckIndex;
+    Timer& m_timer = Timer::getInstance();
+};
+
+size_t SingularityChecker::m_timerSingularityCheckIndex = -1;
+
+#endif /* SingularityChecker_h */
@@ -76,7 +76,7 @@ public:
     
     void printResults2() {
         std::vector<size_t> reasons;
-        for(size_t i = 0; i < 10; i++) {
+        for(size_t i = 0; i < 11; i++) {
             reasons.push_back(0);
         }
         
@@ -86,7 +86,7 @@ public:
             }
         }
         
-        for(size_t i = 0; i < 10; i++) {
+        for(size_t i = 0; i < 11; i++) {
             std::cout<<"Reason "<<i<<" count "<<reasons[i]<<"\n";
         }
     }
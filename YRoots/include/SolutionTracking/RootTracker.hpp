@@ -23,6 +23,7 @@ struct FoundRoot {
     SolveMethod         solveMethod;
     Interval            interval;
     double              conditionNumber;
+    size_t              multiplicity; //More than 1 for the middle of a cluster of roots
     
     bool operator < (const FoundRoot &otherRoot)
     {
@@ -72,6 +73,7 @@ public:
         m_foundRoots.resize(m_numThreads);
         m_outputFileRoots = "roots.csv";
         m_outputFileResiduals = "residuals.csv";
+        m_outputFileClusters = "clusters.csv";
     }
     
     bool storeRoot(size_t threadNum, std::vector<std::complex<double> >& _root, Interval& _interval, SolveMethod _howFound, double _conditionNumber, double _goodZerosTol) {
@@ -95,17 +97,13 @@ public:
         thisRoot.conditionNumber = _conditionNumber;
         thisRoot.interval = _interval;
         thisRoot.solveMethod = _howFound;
+        thisRoot.multiplicity = 1;
 
         //Transform the root
         thisRoot.root.resize(_root.size());
         for(size_t i = 0; i < _root.size(); i++) {
             thisRoot.root[i] = ((_interval.upperBounds[i] - _interval.lowerBounds[i]) * std::real(_root[i]) + (_interval.upperBounds[i] + _interval.lowerBounds[i])) /2.0;
         }
-        
-        //Compute the resisuals of the root
-        if(m_computeResiduals) {
-            evaluateResiduals(thisRoot, m_allFunctions[threadNum]);
-        }
 
         return true;
     }
@@ -122,24 +120,59 @@ public:
         thisRoot.conditionNumber = _conditionNumber;
         thisRoot.interval = _interval;
         thisRoot.solveMethod = _howFound;
+        thisRoot.multiplicity = 1;
 
         //Transform the root
         thisRoot.root.resize(_root.size());
         for(size_t i = 0; i < _root.size(); i++) {
             thisRoot.root[i] = _root[i];
         }
-        
-        //Compute the resisuals of the root
-        if(m_computeResiduals) {
-            evaluateResiduals(thisRoot, m_allFunctions[threadNum]);
-        }
+    }
+
+    void storeRoot(size_t threadNum, std::vector<double>& _root, Interval& _interval, SolveMethod _howFound, double _conditionNumber, const std::vector<double>& _residuals) {
+        //For a root that was refined on the functions themselves, so the residuals are already known.
+        storeRoot(threadNum, _root, _interval, _howFound, _conditionNumber);
+        m_foundRoots[threadNum].back().residuals = _residuals;
     }
     
-    void evaluateResiduals(FoundRoot& _currRoot, std::vector<Function::SharedFunctionPtr>& _functions) {
-        for(size_t i = 0; i < _functions.size(); i++) {
-            ErrorTracker result = _functions[i]->evaluate<ErrorTracker>(_currRoot.root);
-            _currRoot.residuals.push_back(result.value);
-            _currRoot.evalErrorsAtRoot.push_back(result.error);
+    void storeCluster(size_t threadNum, std::vector<double>& _center, Interval& _interval, size_t _multiplicity) {
+        //For the middle of an interval around a multiple root or cluster of roots, with the estimated number of roots in it.
+        storeRoot(threadNum, _center, _interval, SolveMethod::ClusterCheck, std::nan(""));
+        m_foundRoots[threadNum].back().multiplicity = _multiplicity;
+    }
+    
+    //Computes the residuals of every root once the solve is done, evaluating each function over all the roots at once.
+    void evaluateResiduals() {
+        std::vector<FoundRoot*> roots;
+        for(size_t threadNum = 0; threadNum < m_numThreads; threadNum++) {
+            for(size_t rootNum = 0; rootNum < m_foundRoots[threadNum].size(); rootNum++) {
+                roots.push_back(&m_foundRoots[threadNum][rootNum]);
+            }
+        }
+        if(roots.size() == 0) {
+            return;
+        }
+        
+        //Put the roots into a batch of points
+        const size_t rank = roots[0]->root.size();
+        std::vector<std::vector<double> > points(rank, std::vector<double>(roots.size()));
+        for(size_t rootNum = 0; rootNum < roots.size(); rootNum++) {
+            roots[rootNum]->residuals.clear();
+            roots[rootNum]->evalErrorsAtRoot.clear();
+            for(size_t i = 0; i < rank; i++) {
+                points[i][rootNum] = roots[rootNum]->root[i];
+            }
+        }
+        
+        //The solve is done, so the functions and scratch space of thread 0 are free to use.
+        std::vector<ErrorTracker> results;
+        const std::vector<Function::SharedFunctionPtr>& functions = m_allFunctions[0];
+        for(size_t funcNum = 0; funcNum < functions.size(); funcNum++) {
+            functions[funcNum]->evaluateBatch<ErrorTracker>(points, results);
+            for(size_t rootNum = 0; rootNum < roots.size(); rootNum++) {
+                roots[rootNum]->residuals.push_back(results[rootNum].value);
+                roots[rootNum]->evalErrorsAtRoot.push_back(results[rootNum].error);
+            }
         }
     }
 
@@ -178,8 +211,38 @@ public:
         file.close();
         
         if(m_computeResiduals) {
+            evaluateResiduals();
             logResiduals();
         }
+        logClusters();
+    }
+    
+    void logClusters() {
+        //Each line is the lower bounds, upper bounds, and estimated number of roots of an interval stored as a cluster.
+        //Only written if there were any.
+        std::ofstream file;
+        int precision = std::numeric_limits<double>::digits10 + 1;
+        for(size_t threadNum = 0; threadNum < m_numThreads; threadNum++) {
+            for(size_t rootNum = 0; rootNum < m_foundRoots[threadNum].size(); rootNum++) {
+                const FoundRoot& foundRoot = m_foundRoots[threadNum][rootNum];
+                if(foundRoot.solveMethod != SolveMethod::ClusterCheck) {
+                    continue;
+                }
+                if(!file.is_open()) {
+                    file.open(m_outputFileClusters);
+                }
+                for(size_t i = 0; i < foundRoot.interval.lowerBounds.size(); i++) {
+                    file<<std::setprecision(precision)<<foundRoot.interval.lowerBounds[i]<<",";
+                }
+                for(size_t i = 0; i < foundRoot.interval.upperBounds.size(); i++) {
+                    file<<std::setprecision(precision)<<foundRoot.interval.upperBounds[i]<<",";
+                }
+                file<<foundRoot.multiplicity<<"\n";
+            }
+        }
+        if(file.is_open()) {
+            file.close();
+        }
     }
 
     void logResiduals() {
@@ -225,6 +288,7 @@ private:
     std::vector<std::vector<FoundRoot> >    m_foundRoots;
     std::string                             m_outputFileRoots;
     std::string                             m_outputFileResiduals;
+    std::string                             m_outputFileClusters;
 };
 
 
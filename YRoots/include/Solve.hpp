@@ -45,12 +45,10 @@ void mainSolver(const std::string& inputFileName) {
     const SubdivisionParameters& subdivisionParameters = inputParser.getSubdivisionParameters();
 
     #ifdef USE_TIMING
+    //The timer is already enabled, enabling it again would clear the parser timing.
     if(!inputParser.getGeneralParameters().useTimer) {
         Timer::disable();
     }
-    else {
-        Timer::enable();
-    }
     #endif
     
     //Solve
@@ -0,0 +1,116 @@
+//
+//  KrawczykSolver.hpp
+//  YRoots
+//
+//  Created by Erik Hales Parkinson on 10/19/26.
+//  Copyright © 2026 Erik Hales Parkinson. All rights reserved.
+//
+
+#ifndef KrawczykSolver_h
+#define KrawczykSolver_h
+
+#include "Eigen/Core"
+#include "Eigen/Dense"
+
+#include "Approximation/ChebyshevApproximation.hpp"
+#include "Utilities/utilities.hpp"
+#include "Utilities/MultiPool.hpp"
+#include "Utilities/ConcurrentStack.hpp"
+#include "Utilities/Timer.hpp"
+#include "SolutionTracking/IntervalTracker.hpp"
+#include "SolutionTracking/RootTracker.hpp"
+#include "Solvers/NewtonSolver.hpp"
+
+enum KrawczykResult {
+    NoRoot, //The functions have no common zero in the box
+    MayHaveRoots,
+    UniqueRoot //The functions have a zero in the box, and it's the only zero of the approximations
+};
+
+//Contracts an interval with the Krawczyk operator on the Chebyshev approximations, in the [-1,1] coordinates of the interval.
+//For a box X with midpoint y, every zero of the functions in X is in
+//      K(X) = y - Y(p(y) + [-e,e]) + (I - Y*J(X))(X - y)
+//where p are the approximations, e their errors, J(X) bounds the Jacobian of p on X and Y is the inverse of the Jacobian at y.
+//So X is replaced by X ∩ K(X), and there are no zeros if that's empty. If K(X) is in the interior of X then x - Y*f(x) maps X
+//into itself, so the functions have a zero in X, and the approximations only have one.
+template <int Rank>
+class KrawczykSolver {
+public:
+    KrawczykSolver(size_t _threadNum, size_t _rank, IntervalTracker& _intervalTracker, RootTracker& _rootTracker, ConcurrentStack<SolveParameters>& _intervalsToRun, ObjectPool<SolveParameters>& _solveParametersPool, NewtonSolver<Rank>& _newtonSolver);
+
+    //Returns true if the interval was thrown out, had it's root found, or was contracted and pushed, so it doesn't need to be subdivided.
+    //A unique root is polished with Newton's method on the functions, starting from the middle of the box. If that fails
+    //the middle of the box is only stored if each approximation error is at most max(_minApproxTols[i], _targetTol), the
+    //same as for the linear solve. Otherwise the box around it is pushed to be solved again.
+    bool solve(std::vector<ChebyshevApproximation<Rank> >& _chebyshevApproximations, SolveParameters* _parameters, const std::vector<double>& _minApproxTols, double _targetTol);
+
+    //Contracts the box, starting from [-1,1]^rank. The approximations must all be good.
+    KrawczykResult contract(std::vector<ChebyshevApproximation<Rank> >& _chebyshevApproximations);
+
+    const Interval& getBox() const {
+        return m_box;
+    }
+
+private:
+    bool setCoefficients(std::vector<ChebyshevApproximation<Rank> >& _chebyshevApproximations);
+    void widenBox(const Interval& _interval);
+    void pushBox(SolveParameters* _parameters);
+    void setChebValues(const std::vector<double>& _point);
+    void setChebRanges();
+    double evaluateTensor(const double* _coeffs);
+    void boundTensor(const double* _coeffs, double& _lower, double& _upper);
+    bool krawczykStep(bool& _certified);
+    double getBoxArea();
+
+private:
+    size_t                              m_threadNum;
+    size_t                              m_rank;
+    IntervalTracker&                    m_intervalTracker;
+    RootTracker&                        m_rootTracker;
+    ConcurrentStack<SolveParameters>&   m_intervalsToRun;
+    ObjectPool<SolveParameters>&        m_solveParametersPool;
+    NewtonSolver<Rank>&                 m_newtonSolver;
+
+    //The approximations and their derivatives in dense arrays with m_sideLength coefficients in each dimension.
+    size_t                              m_sideLength;
+    size_t                              m_numCoeffs;
+    std::vector<double>                 m_coeffs;
+    std::vector<double>                 m_derivatives; //Function i in dimension d starts at (i*m_rank + d)*m_numCoeffs
+
+    //T_k at the midpoint, and the ranges of T_k on the box, for each dimension
+    std::vector<double>                 m_chebValues;
+    std::vector<double>                 m_chebLowers;
+    std::vector<double>                 m_chebUppers;
+
+    Interval                            m_box;
+    Interval                            m_projectedBox; //m_box in the coordinates of the interval
+    std::vector<double>                 m_midpoint;
+    std::vector<double>                 m_root;
+    typename EigenTypes<Rank>::Vector   m_errors;
+    typename EigenTypes<Rank>::Vector   m_values;
+    typename EigenTypes<Rank>::Vector   m_radii;
+    typename EigenTypes<Rank>::Matrix   m_jacobian;
+    typename EigenTypes<Rank>::Matrix   m_jacobianCenter;
+    typename EigenTypes<Rank>::Matrix   m_jacobianRadius;
+    typename EigenTypes<Rank>::Matrix   m_preconditioner;
+
+    static constexpr size_t s_maxIterations = 20;
+    //Stop iterating once the width of the box shrinks by less than this factor.
+    static constexpr double s_minContraction = 0.9;
+    //Push the contracted box instead of subdividing if it's at most this fraction of the interval.
+    static constexpr double s_maxPushArea = 0.1;
+    //The smallest width of a dimension of a pushed box, relative to the magnitude of it's bounds.
+    static constexpr double s_minRelativeWidth = 1e-10;
+    //The max number of coefficients times rank^3 to bound in each iteration.
+    static constexpr size_t s_maxWork = 1 << 20;
+
+    static size_t           m_timerKrawczykSolveIndex;
+    Timer&                  m_timer = Timer::getInstance();
+};
+
+template<int Rank>
+size_t KrawczykSolver<Rank>::m_timerKrawczykSolveIndex = -1;
+
+#include "KrawczykSolverND.ipp"
+
+#endif /* KrawczykSolver_h */
@@ -0,0 +1,401 @@
+//
+//  KrawczykSolverND.ipp
+//  YRoots
+//
+//  Created by Erik Hales Parkinson on 10/19/26.
+//  Copyright © 2026 Erik Hales Parkinson. All rights reserved.
+//
+
+#ifndef KrawczykSolverND_ipp
+#define KrawczykSolverND_ipp
+
+template <int Rank>
+KrawczykSolver<Rank>::KrawczykSolver(size_t _threadNum, size_t _rank, IntervalTracker& _intervalTracker, RootTracker& _rootTracker, ConcurrentStack<SolveParameters>& _intervalsToRun, ObjectPool<SolveParameters>& _solveParametersPool, NewtonSolver<Rank>& _newtonSolver) :
+m_threadNum(_threadNum),
+m_rank(_rank),
+m_intervalTracker(_intervalTracker),
+m_rootTracker(_rootTracker),
+m_intervalsToRun(_intervalsToRun),
+m_solveParametersPool(_solveParametersPool),
+m_newtonSolver(_newtonSolver),
+m_sideLength(0),
+m_numCoeffs(0),
+m_midpoint(_rank),
+m_root(_rank),
+m_errors(_rank),
+m_values(_rank),
+m_radii(_rank),
+m_jacobian(_rank, _rank),
+m_jacobianCenter(_rank, _rank),
+m_jacobianRadius(_rank, _rank),
+m_preconditioner(_rank, _rank)
+{
+    m_box.lowerBounds.resize(m_rank, -1.0);
+    m_box.upperBounds.resize(m_rank, 1.0);
+    m_projectedBox.lowerBounds.resize(m_rank);
+    m_projectedBox.upperBounds.resize(m_rank);
+
+    m_timer.registerTimer(m_timerKrawczykSolveIndex, "Krawczyk Solve");
+}
+
+template <int Rank>
+bool KrawczykSolver<Rank>::solve(std::vector<ChebyshevApproximation<Rank> >& _chebyshevApproximations, SolveParameters* _parameters, const std::vector<double>& _minApproxTols, double _targetTol)
+{
+    m_timer.startTimer(m_timerKrawczykSolveIndex);
+    const KrawczykResult result = contract(_chebyshevApproximations);
+    Interval& interval = _parameters->interval;
+    if(result == KrawczykResult::NoRoot) {
+        m_intervalTracker.storeResult(m_threadNum, interval, SolveMethod::KrawczykSolve, false);
+        m_timer.stopTimer(m_timerKrawczykSolveIndex);
+        return true;
+    }
+
+    if(result == KrawczykResult::UniqueRoot) {
+        projectInterval(m_projectedBox, interval, m_box);
+        if(m_newtonSolver.polish(m_projectedBox, interval)) {
+            m_timer.stopTimer(m_timerKrawczykSolveIndex);
+            return true;
+        }
+    }
+
+    bool accurate = result == KrawczykResult::UniqueRoot;
+    for(size_t i = 0; i < m_rank; i++) {
+        accurate &= _chebyshevApproximations[i].getApproximationError() <= std::max(_minApproxTols[i], _targetTol);
+    }
+    if(accurate) {
+        //The box has shrunk down to the size of the approximation errors around the root.
+        for(size_t i = 0; i < m_rank; i++) {
+            const double scaledRoot = (m_box.lowerBounds[i] + m_box.upperBounds[i]) / 2;
+            m_root[i] = ((interval.upperBounds[i] - interval.lowerBounds[i]) * scaledRoot + (interval.upperBounds[i] + interval.lowerBounds[i])) / 2.0;
+        }
+        m_rootTracker.storeRoot(m_threadNum, m_root, interval, SolveMethod::KrawczykSolve, std::nan(""));
+        m_intervalTracker.storeResult(m_threadNum, interval, SolveMethod::KrawczykSolve, true);
+        m_timer.stopTimer(m_timerKrawczykSolveIndex);
+        return true;
+    }
+
+    //Otherwise push the contracted box if it's small enough. A box around a unique root is always pushed, as the
+    //approximations are more accurate on it.
+    widenBox(interval);
+    const double maxArea = result == KrawczykResult::UniqueRoot ? 1.0 : s_maxPushArea;
+    const bool pushed = getBoxArea() < maxArea * power(2.0, m_rank);
+    if(pushed) {
+        pushBox(_parameters);
+    }
+    m_timer.stopTimer(m_timerKrawczykSolveIndex);
+    return pushed;
+}
+
+template <int Rank>
+void KrawczykSolver<Rank>::widenBox(const Interval& _interval)
+{
+    //Don't let a dimension get close to the rounding error of the interval's bounds, or a root on the edge of it
+    //could end up in two neighboring intervals.
+    for(size_t i = 0; i < m_rank; i++) {
+        const double width = _interval.upperBounds[i] - _interval.lowerBounds[i];
+        const double magnitude = std::max(std::abs(_interval.lowerBounds[i]), std::abs(_interval.upperBounds[i]));
+        const double minWidth = std::min(2.0, 2 * s_minRelativeWidth * magnitude / width);
+        if(m_box.upperBounds[i] - m_box.lowerBounds[i] < minWidth) {
+            const double center = (m_box.upperBounds[i] + m_box.lowerBounds[i]) / 2;
+            m_box.lowerBounds[i] = std::max(-1.0, std::min(center - minWidth / 2, 1.0 - minWidth));
+            m_box.upperBounds[i] = m_box.lowerBounds[i] + minWidth;
+        }
+    }
+}
+
+template <int Rank>
+void KrawczykSolver<Rank>::pushBox(SolveParameters* _parameters)
+{
+    //Stores the part of the interval that was thrown out and pushes the contracted box.
+    m_intervalTracker.storeResult(m_threadNum, _parameters->interval, SolveMethod::KrawczykSolve, false, getBoxArea());
+    SolveParameters* nextParameters = m_solveParametersPool.pop();
+    nextParameters->clear();
+    projectInterval(nextParameters->interval, _parameters->interval, m_box);
+    nextParameters->currentLevel = _parameters->currentLevel+1;
+    nextParameters->clusterLevels = _parameters->clusterLevels;
+    for(size_t i = 0; i < nextParameters->goodDegrees.size(); i++) {
+        nextParameters->goodDegrees[i] = _parameters->goodDegrees[i];
+    }
+    m_intervalsToRun.push(m_threadNum, nextParameters);
+}
+
+template <int Rank>
+KrawczykResult KrawczykSolver<Rank>::contract(std::vector<ChebyshevApproximation<Rank> >& _chebyshevApproximations)
+{
+    for(size_t i = 0; i < m_rank; i++) {
+        m_box.lowerBounds[i] = -1.0;
+        m_box.upperBounds[i] = 1.0;
+    }
+    if(!setCoefficients(_chebyshevApproximations)) {
+        return KrawczykResult::MayHaveRoots;
+    }
+
+    bool certified = false;
+    double width = 2.0;
+    for(size_t iteration = 0; iteration < s_maxIterations; iteration++) {
+        bool certifiedThisStep;
+        if(!krawczykStep(certifiedThisStep)) {
+            return KrawczykResult::NoRoot;
+        }
+        //Once it's certified every smaller box from the iteration still has the zero.
+        certified |= certifiedThisStep;
+
+        double newWidth = 0.0;
+        for(size_t i = 0; i < m_rank; i++) {
+            newWidth = std::max(newWidth, m_box.upperBounds[i] - m_box.lowerBounds[i]);
+        }
+        if(newWidth > s_minContraction * width) {
+            break;
+        }
+        width = newWidth;
+    }
+    return certified ? KrawczykResult::UniqueRoot : KrawczykResult::MayHaveRoots;
+}
+
+template <int Rank>
+bool KrawczykSolver<Rank>::setCoefficients(std::vector<ChebyshevApproximation<Rank> >& _chebyshevApproximations)
+{
+    //Copies the approximations into dense arrays and takes their derivatives. Returns false if it's too big to be worth it.
+    size_t sideLength = 0;
+    for(size_t i = 0; i < m_rank; i++) {
+        sideLength = std::max(sideLength, _chebyshevApproximations[i].getPartialSideLength());
+    }
+    const size_t numCoeffs = power(sideLength, m_rank);
+    if(sideLength < 2 || numCoeffs * m_rank * m_rank * m_rank > s_maxWork) {
+        return false;
+    }
+    m_sideLength = sideLength;
+    m_numCoeffs = numCoeffs;
+    m_coeffs.resize(m_rank * m_numCoeffs);
+    m_derivatives.resize(m_rank * m_rank * m_numCoeffs);
+    m_chebValues.resize(m_rank * m_sideLength);
+    m_chebLowers.resize(m_rank * m_sideLength);
+    m_chebUppers.resize(m_rank * m_sideLength);
+
+    for(size_t funcNum = 0; funcNum < m_rank; funcNum++) {
+        ChebyshevApproximation<Rank>& approximation = _chebyshevApproximations[funcNum];
+        const double* array = approximation.getArray();
+        const size_t approximationSideLength = approximation.getSideLength();
+        const size_t partialSideLength = approximation.getPartialSideLength();
+        double* coeffs = &m_coeffs[funcNum * m_numCoeffs];
+        double sumAbsVal = 0.0;
+        for(size_t spot = 0; spot < m_numCoeffs; spot++) {
+            size_t index = spot;
+            size_t arraySpot = 0;
+            size_t multiplier = 1;
+            bool validSpot = true;
+            for(size_t dim = 0; dim < m_rank; dim++) {
+                const size_t degree = index % m_sideLength;
+                validSpot &= degree < partialSideLength;
+                arraySpot += degree * multiplier;
+                index /= m_sideLength;
+                multiplier *= approximationSideLength;
+            }
+            coeffs[spot] = validSpot ? array[arraySpot] : 0.0;
+            sumAbsVal += std::abs(coeffs[spot]);
+        }
+        //Count the rounding in evaluating the approximations
+        m_errors(funcNum) = approximation.getApproximationError() + 10 * m_numCoeffs * std::numeric_limits<double>::epsilon() * sumAbsVal;
+
+        //The derivative in each dimension, from b_k = b_k+2 + 2(k+1)a_k+1 with b_0 halved
+        for(size_t dim = 0; dim < m_rank; dim++) {
+            double* derivative = &m_derivatives[(funcNum * m_rank + dim) * m_numCoeffs];
+            const size_t stride = power(m_sideLength, dim);
+            const size_t blockSize = stride * m_sideLength;
+            for(size_t block = 0; block < m_numCoeffs; block += blockSize) {
+                for(size_t inner = 0; inner < stride; inner++) {
+                    const size_t base = block + inner;
+                    derivative[base + (m_sideLength-1)*stride] = 0.0;
+                    double twoAhead = 0.0;
+                    double oneAhead = 0.0;
+                    for(size_t k = m_sideLength-1; k-- > 0;) {
+                        const double value = twoAhead + 2*(k+1)*coeffs[base + (k+1)*stride];
+                        derivative[base + k*stride] = value;
+                        twoAhead = oneAhead;
+                        oneAhead = value;
+                    }
+                    derivative[base] /= 2;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+template <int Rank>
+void KrawczykSolver<Rank>::setChebValues(const std::vector<double>& _point)
+{
+    for(size_t dim = 0; dim < m_rank; dim++) {
+        double* values = &m_chebValues[dim * m_sideLength];
+        values[0] = 1.0;
+        values[1] = _point[dim];
+        for(size_t k = 2; k < m_sideLength; k++) {
+            values[k] = 2 * _point[dim] * values[k-1] - values[k-2];
+        }
+    }
+}
+
+template <int Rank>
+void KrawczykSolver<Rank>::setChebRanges()
+{
+    //T_k is monotone between it's extrema at cos(j*pi/k), where it's (-1)^j. So it's range on [lower, upper] is between
+    //it's values at the ends unless an extrema is inside.
+    for(size_t dim = 0; dim < m_rank; dim++) {
+        const double lower = m_box.lowerBounds[dim];
+        const double upper = m_box.upperBounds[dim];
+        const double lowerAngle = std::acos(std::max(-1.0, std::min(1.0, lower)));
+        const double upperAngle = std::acos(std::max(-1.0, std::min(1.0, upper)));
+        double* lowers = &m_chebLowers[dim * m_sideLength];
+        double* uppers = &m_chebUppers[dim * m_sideLength];
+        double lowerPrev = 1.0, lowerCurr = lower;
+        double upperPrev = 1.0, upperCurr = upper;
+        lowers[0] = uppers[0] = 1.0;
+        for(size_t k = 1; k < m_sideLength; k++) {
+            if(k > 1) {
+                double temp = 2 * lower * lowerCurr - lowerPrev;
+                lowerPrev = lowerCurr;
+                lowerCurr = temp;
+                temp = 2 * upper * upperCurr - upperPrev;
+                upperPrev = upperCurr;
+                upperCurr = temp;
+            }
+            lowers[k] = std::min(lowerCurr, upperCurr);
+            uppers[k] = std::max(lowerCurr, upperCurr);
+            //The extrema inside are the j with upperAngle < j*pi/k < lowerAngle
+            const double firstExtrema = std::floor(k * upperAngle / M_PI) + 1;
+            const double lastExtrema = std::ceil(k * lowerAngle / M_PI) - 1;
+            if(firstExtrema < lastExtrema) {
+                lowers[k] = -1.0;
+                uppers[k] = 1.0;
+            }
+            else if(firstExtrema == lastExtrema) {
+                if(static_cast<size_t>(firstExtrema) % 2 == 0) {
+                    uppers[k] = 1.0;
+                }
+                else {
+                    lowers[k] = -1.0;
+                }
+            }
+        }
+    }
+}
+
+template <int Rank>
+double KrawczykSolver<Rank>::evaluateTensor(const double* _coeffs)
+{
+    double result = 0.0;
+    for(size_t spot = 0; spot < m_numCoeffs; spot++) {
+        if(_coeffs[spot] == 0.0) {
+            continue;
+        }
+        double term = _coeffs[spot];
+        size_t index = spot;
+        for(size_t dim = 0; dim < m_rank; dim++) {
+            term *= m_chebValues[dim * m_sideLength + index % m_sideLength];
+            index /= m_sideLength;
+        }
+        result += term;
+    }
+    return result;
+}
+
+template <int Rank>
+void KrawczykSolver<Rank>::boundTensor(const double* _coeffs, double& _lower, double& _upper)
+{
+    //Interval arithmetic on each term with the ranges of T_k on the box
+    _lower = 0.0;
+    _upper = 0.0;
+    for(size_t spot = 0; spot < m_numCoeffs; spot++) {
+        if(_coeffs[spot] == 0.0) {
+            continue;
+        }
+        double termLower = _coeffs[spot];
+        double termUpper = _coeffs[spot];
+        size_t index = spot;
+        for(size_t dim = 0; dim < m_rank; dim++) {
+            const size_t chebSpot = dim * m_sideLength + index % m_sideLength;
+            index /= m_sideLength;
+            const double products[4] = {termLower * m_chebLowers[chebSpot], termLower * m_chebUppers[chebSpot], termUpper * m_chebLowers[chebSpot], termUpper * m_chebUppers[chebSpot]};
+            termLower = *std::min_element(products, products + 4);
+            termUpper = *std::max_element(products, products + 4);
+        }
+        _lower += termLower;
+        _upper += termUpper;
+    }
+}
+
+template <int Rank>
+bool KrawczykSolver<Rank>::krawczykStep(bool& _certified)
+{
+    //Replaces m_box with it's intersection with K(m_box). Returns false if that's empty.
+    _certified = false;
+    for(size_t i = 0; i < m_rank; i++) {
+        m_midpoint[i] = (m_box.lowerBounds[i] + m_box.upperBounds[i]) / 2;
+        m_radii(i) = (m_box.upperBounds[i] - m_box.lowerBounds[i]) / 2;
+    }
+
+    //The values and Jacobian at the midpoint
+    setChebValues(m_midpoint);
+    for(size_t funcNum = 0; funcNum < m_rank; funcNum++) {
+        m_values(funcNum) = evaluateTensor(&m_coeffs[funcNum * m_numCoeffs]);
+        for(size_t dim = 0; dim < m_rank; dim++) {
+            m_jacobian(funcNum, dim) = evaluateTensor(&m_derivatives[(funcNum * m_rank + dim) * m_numCoeffs]);
+        }
+    }
+
+    //The bound on the Jacobian over the box
+    setChebRanges();
+    for(size_t funcNum = 0; funcNum < m_rank; funcNum++) {
+        for(size_t dim = 0; dim < m_rank; dim++) {
+            double lower, upper;
+            boundTensor(&m_derivatives[(funcNum * m_rank + dim) * m_numCoeffs], lower, upper);
+            m_jacobianCenter(funcNum, dim) = (lower + upper) / 2;
+            m_jacobianRadius(funcNum, dim) = (upper - lower) / 2;
+        }
+    }
+
+    Eigen::FullPivLU<typename EigenTypes<Rank>::Matrix> jacobianLU(m_jacobian);
+    if(!jacobianLU.isInvertible()) {
+        return true;
+    }
+    m_preconditioner = jacobianLU.inverse();
+
+    //K(X) = y - Y*p(y) +- (|Y|*e + (|I - Y*Jc| + |Y|*Jr)*r)
+    typename EigenTypes<Rank>::Matrix absPreconditioner = m_preconditioner.cwiseAbs();
+    typename EigenTypes<Rank>::Matrix contraction = -m_preconditioner * m_jacobianCenter;
+    contraction.diagonal().array() += 1.0;
+    typename EigenTypes<Rank>::Vector newtonStep = m_preconditioner * m_values;
+    typename EigenTypes<Rank>::Vector radius = absPreconditioner * m_errors + (contraction.cwiseAbs() + absPreconditioner * m_jacobianRadius) * m_radii;
+
+    if(!newtonStep.allFinite() || !radius.allFinite()) {
+        return true;
+    }
+    _certified = true;
+    for(size_t i = 0; i < m_rank; i++) {
+        const double center = m_midpoint[i] - newtonStep(i);
+        //Pad for the rounding in computing it
+        const double padding = radius(i) * 1e-10 + 4 * m_rank * std::numeric_limits<double>::epsilon() * (std::abs(center) + std::abs(newtonStep(i)) + 1);
+        const double lower = center - radius(i) - padding;
+        const double upper = center + radius(i) + padding;
+        _certified &= lower > m_box.lowerBounds[i] && upper < m_box.upperBounds[i];
+        if(lower > m_box.upperBounds[i] || upper < m_box.lowerBounds[i]) {
+            _certified = false;
+            return false;
+        }
+        m_box.lowerBounds[i] = std::max(m_box.lowerBounds[i], lower);
+        m_box.upperBounds[i] = std::min(m_box.upperBounds[i], upper);
+    }
+    return true;
+}
+
+template <int Rank>
+double KrawczykSolver<Rank>::getBoxArea()
+{
+    double area = 1.0;
+    for(size_t i = 0; i < m_rank; i++) {
+        area *= m_box.upperBounds[i] - m_box.lowerBounds[i];
+    }
+    return area;
+}
+
+#endif /* KrawczykSolverND_ipp */
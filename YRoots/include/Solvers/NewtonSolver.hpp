@@ -0,0 +1,72 @@
+//
+//  NewtonSolver.hpp
+//  YRoots
+//
+//  Created by Erik Hales Parkinson on 10/19/26.
+//  Copyright © 2026 Erik Hales Parkinson. All rights reserved.
+//
+
+#ifndef NewtonSolver_h
+#define NewtonSolver_h
+
+#include "Eigen/Core"
+#include "Eigen/Dense"
+
+#include "Functions/Function.hpp"
+#include "Utilities/utilities.hpp"
+#include "Utilities/DualNumber.hpp"
+#include "Utilities/Timer.hpp"
+#include "SolutionTracking/IntervalTracker.hpp"
+#include "SolutionTracking/RootTracker.hpp"
+
+//Refines a root with Newton's method on the functions themselves. The Jacobian is found with forward mode automatic
+//differentiation, evaluating the functions with DualNumbers once for each variable.
+template <int Rank>
+class NewtonSolver {
+public:
+    NewtonSolver(size_t _threadNum, size_t _rank, const std::vector<Function::SharedFunctionPtr>& _functions, IntervalTracker& _intervalTracker, RootTracker& _rootTracker);
+
+    //_box is known to contain exactly one root of the functions. Runs Newton's method from the middle of _box and stores
+    //the root it converges to with it's residuals, and _interval as solved. Returns false if it leaves the box or doesn't converge.
+    bool polish(const Interval& _box, Interval& _interval);
+
+    const std::vector<double>& getRoot() const {
+        return m_root;
+    }
+
+    const std::vector<double>& getResiduals() const {
+        return m_residuals;
+    }
+
+private:
+    bool evaluateJacobian();
+
+private:
+    size_t                                          m_threadNum;
+    size_t                                          m_rank;
+    const std::vector<Function::SharedFunctionPtr>& m_functions;
+    IntervalTracker&                                m_intervalTracker;
+    RootTracker&                                    m_rootTracker;
+
+    std::vector<double>                             m_root;
+    std::vector<double>                             m_residuals;
+    std::vector<DualNumber>                         m_dualPoint;
+    typename EigenTypes<Rank>::Vector               m_values;
+    typename EigenTypes<Rank>::Vector               m_step;
+    typename EigenTypes<Rank>::Matrix               m_jacobian;
+
+    static constexpr size_t s_maxIterations = 10;
+    //Converged once every step is at most this fraction of the width of the box, or is down at the rounding error.
+    static constexpr double s_stepTol = 1e-8;
+    static constexpr double s_roundingStepTol = 8 * std::numeric_limits<double>::epsilon();
+
+    static size_t           m_timerNewtonPolishIndex;
+    Timer&                  m_timer = Timer::getInstance();
+};
+
+template<int Rank>
+size_t NewtonSolver<Rank>::m_timerNewtonPolishIndex = -1;
+
+#include "NewtonSolverND.ipp"
+
+#endif /* NewtonSolver_h */
@@ -0,0 +1,89 @@
+//
+//  NewtonSolverND.ipp
+//  YRoots
+//
+//  Created by Erik Hales Parkinson on 10/19/26.
+//  Copyright © 2026 Erik Hales Parkinson. All rights reserved.
+//
+
+#ifndef NewtonSolverND_ipp
+#define NewtonSolverND_ipp
+
+template <int Rank>
+NewtonSolver<Rank>::NewtonSolver(size_t _threadNum, size_t _rank, const std::vector<Function::SharedFunctionPtr>& _functions, IntervalTracker& _intervalTracker, RootTracker& _rootTracker) :
+m_threadNum(_threadNum),
+m_rank(_rank),
+m_functions(_functions),
+m_intervalTracker(_intervalTracker),
+m_rootTracker(_rootTracker),
+m_root(_rank),
+m_residuals(_rank),
+m_dualPoint(_rank),
+m_values(_rank),
+m_step(_rank),
+m_jacobian(_rank, _rank)
+{
+    m_timer.registerTimer(m_timerNewtonPolishIndex, "Newton Polish");
+}
+
+template <int Rank>
+bool NewtonSolver<Rank>::polish(const Interval& _box, Interval& _interval)
+{
+    m_timer.startTimer(m_timerNewtonPolishIndex);
+    for(size_t i = 0; i < m_rank; i++) {
+        m_root[i] = (_box.lowerBounds[i] + _box.upperBounds[i]) / 2;
+    }
+
+    bool converged = false;
+    for(size_t iteration = 0; iteration < s_maxIterations && !converged; iteration++) {
+        if(!evaluateJacobian()) {
+            break;
+        }
+        m_step = m_jacobian.partialPivLu().solve(m_values);
+        converged = true;
+        bool inBox = true;
+        for(size_t i = 0; i < m_rank; i++) {
+            const double width = _box.upperBounds[i] - _box.lowerBounds[i];
+            const double tol = std::max(s_stepTol * width, s_roundingStepTol * std::abs(m_root[i]));
+            m_root[i] -= m_step[i];
+            //Also false if the step is NaN
+            converged &= std::abs(m_step[i]) <= tol;
+            inBox &= m_root[i] >= _box.lowerBounds[i] - tol && m_root[i] <= _box.upperBounds[i] + tol;
+        }
+        if(!inBox) {
+            converged = false;
+            break;
+        }
+    }
+
+    if(converged) {
+        for(size_t i = 0; i < m_rank; i++) {
+            m_residuals[i] = m_functions[i]->evaluate<double>(m_root, m_threadNum);
+        }
+        m_rootTracker.storeRoot(m_threadNum, m_root, _interval, SolveMethod::NewtonPolish, std::nan(""), m_residuals);
+        m_intervalTracker.storeResult(m_threadNum, _interval, SolveMethod::NewtonPolish, true);
+    }
+    m_timer.stopTimer(m_timerNewtonPolishIndex);
+    return converged;
+}
+
+template <int Rank>
+bool NewtonSolver<Rank>::evaluateJacobian()
+{
+    //Column j of the Jacobian is the derivative in the direction of variable j.
+    for(size_t i = 0; i < m_rank; i++) {
+        m_dualPoint[i] = DualNumber(m_root[i]);
+    }
+    for(size_t j = 0; j < m_rank; j++) {
+        m_dualPoint[j].derivative = 1;
+        for(size_t i = 0; i < m_rank; i++) {
+            const DualNumber result = m_functions[i]->evaluate<DualNumber>(m_dualPoint, m_threadNum);
+            m_values[i] = result.value;
+            m_jacobian(i, j) = result.derivative;
+        }
+        m_dualPoint[j].derivative = 0;
+    }
+    return m_values.allFinite() && m_jacobian.allFinite();
+}
+
+#endif /* NewtonSolverND_ipp */
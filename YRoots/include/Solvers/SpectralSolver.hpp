@@ -0,0 +1,122 @@
+//
+//  SpectralSolver.hpp
+//  YRoots
+//
+//  Created by Erik Hales Parkinson on 10/19/26.
+//  Copyright © 2026 Erik Hales Parkinson. All rights reserved.
+//
+
+#ifndef SpectralSolver_h
+#define SpectralSolver_h
+
+#include <complex>
+#include "Eigen/Core"
+#include "Eigen/Dense"
+#include "Eigen/SVD"
+#include "Eigen/Eigenvalues"
+
+#include "Approximation/ChebyshevApproximation.hpp"
+#include "Utilities/utilities.hpp"
+#include "Utilities/Timer.hpp"
+#include "SolutionTracking/IntervalTracker.hpp"
+#include "SolutionTracking/RootTracker.hpp"
+
+//Finds every common zero of low degree Chebyshev approximations at once with an eigenvalue problem.
+//The Chebyshev Macaulay matrix at degree D = sum(d_i - 1) + 1 has a row T_a*p_i for each |a| <= D - d_i, and a column
+//for each T_b with |b| <= D. Every common zero z gives a null vector [T_b(z)], and there are prod(d_i) of them counting
+//zeros at infinity. If N is a basis of the null space, A the rows of N with |b| <= D-1 and B the rows of x_k*N in that
+//basis, then A*w = [T_b(z)] for an eigenvector w of A^+ B, and z_k = T_{e_k}(z) / T_0(z).
+//In 1D the roots are the eigenvalues of the colleague matrix instead, which works for much higher degrees.
+template <int Rank>
+class SpectralSolver {
+public:
+    SpectralSolver(size_t _threadNum, size_t _rank, IntervalTracker& _intervalTracker, RootTracker& _rootTracker);
+
+    //Stores every root of the approximations in the interval and returns true. Returns false without storing anything
+    //if the problem is too big, is degenerate, or the eigenvalues don't give back zeros of the approximations.
+    bool solve(std::vector<ChebyshevApproximation<Rank> >& _chebyshevApproximations, Interval& _interval, double _goodZerosTol);
+
+    //The highest degree the approximations can be for solve to be used.
+    static size_t getMaxDegree() {
+        if(Rank == 1) {
+            return s_maxColleagueDegree;
+        }
+        return s_maxDegree;
+    }
+
+private:
+    void setTerms(std::vector<ChebyshevApproximation<Rank> >& _chebyshevApproximations);
+    void setMonomials(size_t _degree);
+    bool setNullSpace(size_t _degree);
+    bool findRoots(size_t _degree, double _goodZerosTol);
+    bool addRoot(double _goodZerosTol);
+    void storeRoots(Interval& _interval, double _goodZerosTol);
+    void balanceMatrix(Eigen::MatrixXd& _matrix);
+    bool isZero(const std::vector<std::complex<double> >& _point);
+    bool refineRoot(std::vector<double>& _point);
+    size_t getMonomialIndex(const size_t* _exponents);
+    template <typename T>
+    T evaluateTerms(size_t _funcNum, const std::vector<T>& _point, double& _scale);
+
+private:
+    size_t                  m_threadNum;
+    size_t                  m_rank;
+    IntervalTracker&        m_intervalTracker;
+    RootTracker&            m_rootTracker;
+
+    //The nonzero terms of each approximation. Term j of function i has coefficient m_coefficients[i][j] and exponents
+    //m_exponents[i][j*rank] through m_exponents[i][j*rank + rank-1].
+    std::vector<size_t>                 m_degrees;
+    std::vector<std::vector<double> >   m_coefficients;
+    std::vector<std::vector<size_t> >   m_exponents;
+    size_t                              m_maxTermDegree;
+
+    //The exponents of every monomial with degree at most m_monomialDegree, sorted by degree, the index of each
+    //monomial on the (m_monomialDegree+1)^rank grid, and the index of the first monomial of each degree.
+    size_t                  m_monomialDegree;
+    std::vector<size_t>     m_monomials;
+    std::vector<size_t>     m_monomialIndices;
+    std::vector<size_t>     m_degreeStarts;
+    std::vector<size_t>     m_exponentsHelper;
+
+    Eigen::MatrixXd         m_macaulay;
+    Eigen::MatrixXd         m_nullSpace;
+    Eigen::MatrixXd         m_multiplication;
+    std::vector<double>     m_combination;
+
+    std::vector<std::complex<double> >                  m_complexRoot;
+    std::vector<std::vector<double> >                   m_chebValues;
+    std::vector<std::vector<double> >                   m_chebDerivatives;
+    std::vector<std::vector<double> >                   m_roots;
+    typename EigenTypes<Rank>::Matrix                   m_jacobian;
+    typename EigenTypes<Rank>::Vector                   m_values;
+    typename EigenTypes<Rank>::Vector                   m_step;
+
+    static constexpr size_t s_maxDegree = 5;
+    static constexpr size_t s_maxColleagueDegree = 100;
+    //The Macaulay matrix is only built if it has at most this many columns.
+    static constexpr size_t s_maxColumns = 1000;
+    //Singular values of the Macaulay matrix below this times the largest are treated as 0.
+    static constexpr double s_rankTol = 1e-10;
+    //A zero in the box has |T_b(z)| <= 1 and T_0(z) = 1, so it's null vector isn't small in the degree D-1 rows.
+    //Directions of the null space that are this small there are zeros far outside the box or at infinity.
+    static constexpr double s_infinityTol = 1e-6;
+    //Every root found must be a zero of each approximation with this much relative backward error.
+    static constexpr double s_backwardErrorTol = 1e-8;
+    //Eigenvectors of the zeros far outside the box can come out as the zero in the box again. Roots this close are the
+    //same root, but roots closer than s_minRootDistance are likely a multiple root, which is left to subdivision.
+    static constexpr double s_sameRootDistance = 1e-10;
+    static constexpr double s_minRootDistance = 1e-5;
+    static constexpr size_t s_maxNewtonIterations = 5;
+
+    static size_t           m_timerSpectralSolveIndex;
+    Timer&                  m_timer = Timer::getInstance();
+};
+
+template<int Rank>
+size_t SpectralSolver<Rank>::m_timerSpectralSolveIndex = -1;
+
+#include "SpectralSolver1D.ipp"
+#include "SpectralSolverND.ipp"
+
+#endif /* SpectralSolver_h */
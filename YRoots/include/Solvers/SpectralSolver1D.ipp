@@ -0,0 +1,49 @@
+//
+//  SpectralSolver1D.ipp
+//  YRoots
+//
+//  Created by Erik Hales Parkinson on 10/19/26.
+//  Copyright © 2026 Erik Hales Parkinson. All rights reserved.
+//
+
+#ifndef SpectralSolver1D_ipp
+#define SpectralSolver1D_ipp
+
+template <>
+bool SpectralSolver<1>::solve(std::vector<ChebyshevApproximation<1> >& _chebyshevApproximations, Interval& _interval, double _goodZerosTol)
+{
+    m_timer.startTimer(m_timerSpectralSolveIndex);
+    setTerms(_chebyshevApproximations);
+    const size_t degree = m_degrees[0];
+    const double* coeffs = _chebyshevApproximations[0].getArray();
+
+    //The colleague matrix of p = sum c_k T_k. The vector [T_0(x), ..., T_{d-1}(x)] is an eigenvector with eigenvalue x
+    //when p(x) = 0, as x*T_0 = T_1, x*T_k = (T_{k-1} + T_{k+1})/2 and T_d = -sum_{k<d} c_k T_k / c_d.
+    m_multiplication.setZero(degree, degree);
+    m_multiplication(0, 1) = 1;
+    for(size_t k = 1; k < degree; k++) {
+        m_multiplication(k, k-1) = 0.5;
+        if(k + 1 < degree) {
+            m_multiplication(k, k+1) = 0.5;
+        }
+    }
+    for(size_t k = 0; k < degree; k++) {
+        m_multiplication(degree-1, k) -= coeffs[k] / (2 * coeffs[degree]);
+    }
+    balanceMatrix(m_multiplication);
+
+    Eigen::EigenSolver<Eigen::MatrixXd> eigenSolver(m_multiplication, false);
+    bool success = eigenSolver.info() == Eigen::Success;
+    m_roots.clear();
+    for(size_t rootNum = 0; rootNum < degree && success; rootNum++) {
+        m_complexRoot[0] = eigenSolver.eigenvalues()(rootNum);
+        success = addRoot(_goodZerosTol);
+    }
+    if(success) {
+        storeRoots(_interval, _goodZerosTol);
+    }
+    m_timer.stopTimer(m_timerSpectralSolveIndex);
+    return success;
+}
+
+#endif /* SpectralSolver1D_ipp */
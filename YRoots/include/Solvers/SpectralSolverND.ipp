@@ -0,0 +1,457 @@
+//
+//  SpectralSolverND.ipp
+//  YRoots
+//
+//  Created by Erik Hales Parkinson on 10/19/26.
+//  Copyright © 2026 Erik Hales Parkinson. All rights reserved.
+//
+
+#ifndef SpectralSolverND_ipp
+#define SpectralSolverND_ipp
+
+template <int Rank>
+SpectralSolver<Rank>::SpectralSolver(size_t _threadNum, size_t _rank, IntervalTracker& _intervalTracker, RootTracker& _rootTracker) :
+m_threadNum(_threadNum),
+m_rank(_rank),
+m_intervalTracker(_intervalTracker),
+m_rootTracker(_rootTracker),
+m_degrees(_rank),
+m_coefficients(_rank),
+m_exponents(_rank),
+m_monomialDegree(-1),
+m_exponentsHelper(_rank),
+m_combination(_rank),
+m_complexRoot(_rank),
+m_jacobian(_rank, _rank),
+m_values(_rank),
+m_step(_rank)
+{
+    m_timer.registerTimer(m_timerSpectralSolveIndex, "Spectral Solve");
+
+    //A fixed generic combination of the variables, so different roots have different eigenvalues.
+    for(size_t i = 0; i < m_rank; i++) {
+        m_combination[i] = std::sqrt(2.0 + i);
+    }
+}
+
+template <int Rank>
+bool SpectralSolver<Rank>::solve(std::vector<ChebyshevApproximation<Rank> >& _chebyshevApproximations, Interval& _interval, double _goodZerosTol)
+{
+    m_timer.startTimer(m_timerSpectralSolveIndex);
+    setTerms(_chebyshevApproximations);
+    size_t macaulayDegree = 1;
+    for(size_t funcNum = 0; funcNum < m_rank; funcNum++) {
+        macaulayDegree += m_degrees[funcNum] - 1;
+    }
+    setMonomials(macaulayDegree);
+    if(!setNullSpace(macaulayDegree) || !findRoots(macaulayDegree, _goodZerosTol)) {
+        m_timer.stopTimer(m_timerSpectralSolveIndex);
+        return false;
+    }
+    storeRoots(_interval, _goodZerosTol);
+    m_timer.stopTimer(m_timerSpectralSolveIndex);
+    return true;
+}
+
+template <int Rank>
+void SpectralSolver<Rank>::storeRoots(Interval& _interval, double _goodZerosTol)
+{
+    bool hasRoot = false;
+    for(size_t rootNum = 0; rootNum < m_roots.size(); rootNum++) {
+        for(size_t i = 0; i < m_rank; i++) {
+            m_complexRoot[i] = m_roots[rootNum][i];
+        }
+        hasRoot |= m_rootTracker.storeRoot(m_threadNum, m_complexRoot, _interval, SolveMethod::SpectralSolve, std::nan(""), _goodZerosTol);
+    }
+    m_intervalTracker.storeResult(m_threadNum, _interval, SolveMethod::SpectralSolve, hasRoot);
+}
+
+template <int Rank>
+void SpectralSolver<Rank>::setTerms(std::vector<ChebyshevApproximation<Rank> >& _chebyshevApproximations)
+{
+    m_maxTermDegree = 0;
+    for(size_t funcNum = 0; funcNum < m_rank; funcNum++) {
+        ChebyshevApproximation<Rank>& approximation = _chebyshevApproximations[funcNum];
+        const size_t degree = approximation.getDegree();
+        const size_t partialSideLength = approximation.getPartialSideLength();
+        const size_t sideLength = approximation.getSideLength();
+        double* array = approximation.getArray();
+        m_degrees[funcNum] = degree;
+        m_maxTermDegree = std::max(m_maxTermDegree, degree);
+        m_coefficients[funcNum].clear();
+        m_exponents[funcNum].clear();
+
+        //Iterate through every spot with each exponent less than partialSideLength
+        std::fill(m_exponentsHelper.begin(), m_exponentsHelper.end(), 0);
+        size_t spot = 0;
+        size_t exponentSum = 0;
+        while(true) {
+            if(exponentSum <= degree && array[spot] != 0) {
+                m_coefficients[funcNum].push_back(array[spot]);
+                m_exponents[funcNum].insert(m_exponents[funcNum].end(), m_exponentsHelper.begin(), m_exponentsHelper.end());
+            }
+            //Increment the exponents
+            size_t dim = 0;
+            size_t spotToAdd = 1;
+            while(dim < m_rank && m_exponentsHelper[dim] == partialSideLength - 1) {
+                spot -= m_exponentsHelper[dim] * spotToAdd;
+                exponentSum -= m_exponentsHelper[dim];
+                m_exponentsHelper[dim] = 0;
+                spotToAdd *= sideLength;
+                dim++;
+            }
+            if(dim == m_rank) {
+                break;
+            }
+            m_exponentsHelper[dim]++;
+            exponentSum++;
+            spot += spotToAdd;
+        }
+    }
+}
+
+template <int Rank>
+void SpectralSolver<Rank>::setMonomials(size_t _degree)
+{
+    if(_degree == m_monomialDegree) {
+        return;
+    }
+    m_monomialDegree = _degree;
+    const size_t gridSize = power(_degree + 1, m_rank);
+    m_monomialIndices.assign(gridSize, -1);
+    m_monomials.clear();
+    m_degreeStarts.assign(_degree + 2, 0);
+    size_t numMonomials = 0;
+    for(size_t degree = 0; degree <= _degree; degree++) {
+        m_degreeStarts[degree] = numMonomials;
+        for(size_t gridSpot = 0; gridSpot < gridSize; gridSpot++) {
+            size_t exponentSum = 0;
+            size_t temp = gridSpot;
+            for(size_t i = 0; i < m_rank; i++) {
+                m_exponentsHelper[i] = temp % (_degree + 1);
+                exponentSum += m_exponentsHelper[i];
+                temp /= (_degree + 1);
+            }
+            if(exponentSum == degree) {
+                m_monomialIndices[gridSpot] = numMonomials++;
+                m_monomials.insert(m_monomials.end(), m_exponentsHelper.begin(), m_exponentsHelper.end());
+            }
+        }
+    }
+    m_degreeStarts[_degree + 1] = numMonomials;
+}
+
+template <int Rank>
+size_t SpectralSolver<Rank>::getMonomialIndex(const size_t* _exponents)
+{
+    size_t gridSpot = 0;
+    size_t multiplier = 1;
+    for(size_t i = 0; i < m_rank; i++) {
+        gridSpot += _exponents[i] * multiplier;
+        multiplier *= m_monomialDegree + 1;
+    }
+    return m_monomialIndices[gridSpot];
+}
+
+template <int Rank>
+bool SpectralSolver<Rank>::setNullSpace(size_t _degree)
+{
+    const size_t numColumns = m_degreeStarts[_degree + 1];
+    if(numColumns > s_maxColumns) {
+        return false;
+    }
+    size_t numRows = 0;
+    size_t numRoots = 1;
+    for(size_t funcNum = 0; funcNum < m_rank; funcNum++) {
+        numRows += m_degreeStarts[_degree - m_degrees[funcNum] + 1];
+        numRoots *= m_degrees[funcNum];
+    }
+    const size_t matrixRank = numColumns - numRoots;
+    if(numRows < matrixRank) {
+        return false;
+    }
+
+    //T_a*T_b = (T_{a+b} + T_{|a-b|})/2 in each dimension.
+    m_macaulay.setZero(numRows, numColumns);
+    const double productWeight = 1.0 / power(2, m_rank);
+    const size_t numProductTerms = power(2, m_rank);
+    size_t row = 0;
+    for(size_t funcNum = 0; funcNum < m_rank; funcNum++) {
+        const size_t numShifts = m_degreeStarts[_degree - m_degrees[funcNum] + 1];
+        for(size_t shift = 0; shift < numShifts; shift++) {
+            const size_t* shiftExponents = &m_monomials[shift * m_rank];
+            for(size_t term = 0; term < m_coefficients[funcNum].size(); term++) {
+                const size_t* termExponents = &m_exponents[funcNum][term * m_rank];
+                const double value = m_coefficients[funcNum][term] * productWeight;
+                for(size_t productTerm = 0; productTerm < numProductTerms; productTerm++) {
+                    for(size_t i = 0; i < m_rank; i++) {
+                        if((productTerm >> i) & 1) {
+                            m_exponentsHelper[i] = shiftExponents[i] > termExponents[i] ? shiftExponents[i] - termExponents[i] : termExponents[i] - shiftExponents[i];
+                        }
+                        else {
+                            m_exponentsHelper[i] = shiftExponents[i] + termExponents[i];
+                        }
+                    }
+                    m_macaulay(row, getMonomialIndex(m_exponentsHelper.data())) += value;
+                }
+            }
+            //Scale the rows to be similar sizes
+            const double rowNorm = m_macaulay.row(row).cwiseAbs().maxCoeff();
+            if(rowNorm == 0) {
+                return false;
+            }
+            m_macaulay.row(row) /= rowNorm;
+            row++;
+        }
+    }
+
+    //The null space is the last numRoots right singular vectors. There must be a gap before them, otherwise there are
+    //more solutions than prod(d_i), so there is a curve of zeros or the approximations are too close to one.
+    Eigen::BDCSVD<Eigen::MatrixXd> svd(m_macaulay, Eigen::ComputeFullV);
+    const Eigen::VectorXd& singularValues = svd.singularValues();
+    if(matrixRank > 0 && !(singularValues(matrixRank - 1) > s_rankTol * singularValues(0))) {
+        return false;
+    }
+    m_nullSpace = svd.matrixV().rightCols(numRoots);
+    return true;
+}
+
+template <int Rank>
+bool SpectralSolver<Rank>::findRoots(size_t _degree, double _goodZerosTol)
+{
+    //Compress the null space to the part seen by the monomials of degree at most D-1.
+    const size_t numLower = m_degreeStarts[_degree];
+    if(numLower <= m_rank) {
+        return false;
+    }
+    Eigen::BDCSVD<Eigen::MatrixXd> svd(m_nullSpace.topRows(numLower), Eigen::ComputeThinV);
+    const Eigen::VectorXd& singularValues = svd.singularValues();
+    size_t numRoots = 0;
+    while(numRoots < static_cast<size_t>(singularValues.size()) && singularValues(numRoots) > s_infinityTol * singularValues(0)) {
+        numRoots++;
+    }
+    if(numRoots == 0) {
+        return false;
+    }
+    m_nullSpace = m_nullSpace * svd.matrixV().leftCols(numRoots);
+
+    //x_k*T_b = (T_{b+e_k} + T_{b-e_k})/2, or T_{b+e_k} if b_k = 0.
+    m_multiplication.setZero(numLower, numRoots);
+    for(size_t monomial = 0; monomial < numLower; monomial++) {
+        for(size_t k = 0; k < m_rank; k++) {
+            std::copy(m_monomials.begin() + monomial * m_rank, m_monomials.begin() + (monomial + 1) * m_rank, m_exponentsHelper.begin());
+            m_exponentsHelper[k]++;
+            const size_t upIndex = getMonomialIndex(m_exponentsHelper.data());
+            if(m_exponentsHelper[k] == 1) {
+                m_multiplication.row(monomial) += m_combination[k] * m_nullSpace.row(upIndex);
+            }
+            else {
+                m_exponentsHelper[k] -= 2;
+                const size_t downIndex = getMonomialIndex(m_exponentsHelper.data());
+                m_multiplication.row(monomial) += 0.5 * m_combination[k] * (m_nullSpace.row(upIndex) + m_nullSpace.row(downIndex));
+            }
+        }
+    }
+    const Eigen::MatrixXd lowerNullSpace = m_nullSpace.topRows(numLower);
+    const Eigen::MatrixXd multiplicationMatrix = lowerNullSpace.colPivHouseholderQr().solve(m_multiplication);
+    Eigen::EigenSolver<Eigen::MatrixXd> eigenSolver(multiplicationMatrix);
+    if(eigenSolver.info() != Eigen::Success) {
+        return false;
+    }
+    const Eigen::MatrixXcd evaluations = lowerNullSpace.cast<std::complex<double> >() * eigenSolver.eigenvectors();
+
+    //Read off the roots
+    m_roots.clear();
+    for(size_t rootNum = 0; rootNum < numRoots; rootNum++) {
+        const std::complex<double> constantTerm = evaluations(0, rootNum);
+        if(!(std::abs(constantTerm) > s_infinityTol * evaluations.col(rootNum).cwiseAbs().maxCoeff())) {
+            continue; //At infinity
+        }
+        for(size_t i = 0; i < m_rank; i++) {
+            //The monomials of degree 1 are x_0 through x_{rank-1} in order.
+            m_complexRoot[i] = evaluations(1 + i, rootNum) / constantTerm;
+        }
+        if(!addRoot(_goodZerosTol)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <int Rank>
+bool SpectralSolver<Rank>::addRoot(double _goodZerosTol)
+{
+    //Every eigenvalue has to be a zero of the approximations, otherwise they aren't accurate.
+    if(!isZero(m_complexRoot)) {
+        return false;
+    }
+    for(size_t i = 0; i < m_rank; i++) {
+        if(std::abs(std::real(m_complexRoot[i])) > 1 + _goodZerosTol || std::abs(std::imag(m_complexRoot[i])) > _goodZerosTol) {
+            return true;
+        }
+    }
+    m_roots.emplace_back(m_rank);
+    for(size_t i = 0; i < m_rank; i++) {
+        m_roots.back()[i] = std::real(m_complexRoot[i]);
+    }
+    refineRoot(m_roots.back());
+
+    //Close roots are probably a multiple root, where the eigenvalues aren't accurate.
+    for(size_t otherRoot = 0; otherRoot + 1 < m_roots.size(); otherRoot++) {
+        double distance = 0;
+        for(size_t i = 0; i < m_rank; i++) {
+            distance = std::max(distance, std::abs(m_roots.back()[i] - m_roots[otherRoot][i]));
+        }
+        if(distance < s_sameRootDistance) {
+            m_roots.pop_back();
+            break;
+        }
+        else if(distance < s_minRootDistance) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <int Rank>
+void SpectralSolver<Rank>::balanceMatrix(Eigen::MatrixXd& _matrix)
+{
+    //Scale the rows and columns by powers of 2 so each row has about the same norm as the matching column. This is a
+    //similarity transform, so the eigenvalues don't change, but they are computed more accurately.
+    const double radix = 2;
+    bool converged = false;
+    while(!converged) {
+        converged = true;
+        for(Eigen::Index i = 0; i < _matrix.rows(); i++) {
+            double columnNorm = _matrix.col(i).cwiseAbs().sum() - std::abs(_matrix(i, i));
+            const double rowNorm = _matrix.row(i).cwiseAbs().sum() - std::abs(_matrix(i, i));
+            if(columnNorm == 0 || rowNorm == 0) {
+                continue;
+            }
+            const double normSum = columnNorm + rowNorm;
+            double scale = 1;
+            while(columnNorm < rowNorm / radix) {
+                scale *= radix;
+                columnNorm *= radix * radix;
+            }
+            while(columnNorm >= rowNorm * radix) {
+                scale /= radix;
+                columnNorm /= radix * radix;
+            }
+            if((columnNorm + rowNorm) / scale < 0.95 * normSum) {
+                converged = false;
+                _matrix.row(i) /= scale;
+                _matrix.col(i) *= scale;
+            }
+        }
+    }
+}
+
+template <int Rank>
+template <typename T>
+T SpectralSolver<Rank>::evaluateTerms(size_t _funcNum, const std::vector<T>& _point, double& _scale)
+{
+    //The chebyshev polynomials of each variable up to the max degree.
+    const size_t sideLength = std::max<size_t>(m_maxTermDegree + 1, 2);
+    std::vector<T> chebValues(m_rank * sideLength);
+    for(size_t i = 0; i < m_rank; i++) {
+        chebValues[i * sideLength] = 1;
+        chebValues[i * sideLength + 1] = _point[i];
+        for(size_t j = 2; j < sideLength; j++) {
+            chebValues[i * sideLength + j] = 2.0 * _point[i] * chebValues[i * sideLength + j - 1] - chebValues[i * sideLength + j - 2];
+        }
+    }
+
+    //The scale is sum |c_a| prod max(1, |T_{a_i}(x_i)|), the size of the rounding errors in evaluating it.
+    T result = 0;
+    _scale = 0;
+    for(size_t term = 0; term < m_coefficients[_funcNum].size(); term++) {
+        T termValue = m_coefficients[_funcNum][term];
+        double termScale = std::abs(m_coefficients[_funcNum][term]);
+        for(size_t i = 0; i < m_rank; i++) {
+            const T& chebValue = chebValues[i * sideLength + m_exponents[_funcNum][term * m_rank + i]];
+            termValue *= chebValue;
+            termScale *= std::max(1.0, std::abs(chebValue));
+        }
+        result += termValue;
+        _scale += termScale;
+    }
+    return result;
+}
+
+template <int Rank>
+bool SpectralSolver<Rank>::isZero(const std::vector<std::complex<double> >& _point)
+{
+    for(size_t funcNum = 0; funcNum < m_rank; funcNum++) {
+        double scale;
+        const std::complex<double> value = evaluateTerms(funcNum, _point, scale);
+        if(!(std::abs(value) <= s_backwardErrorTol * scale)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <int Rank>
+bool SpectralSolver<Rank>::refineRoot(std::vector<double>& _point)
+{
+    //Newton's method on the approximations. The point is only changed if it converges.
+    const size_t sideLength = std::max<size_t>(m_maxTermDegree + 1, 2);
+    m_chebValues.resize(m_rank);
+    m_chebDerivatives.resize(m_rank);
+    for(size_t i = 0; i < m_rank; i++) {
+        m_chebValues[i].resize(sideLength);
+        m_chebDerivatives[i].resize(sideLength);
+    }
+    std::vector<double> point = _point;
+    for(size_t iteration = 0; iteration < s_maxNewtonIterations; iteration++) {
+        for(size_t i = 0; i < m_rank; i++) {
+            m_chebValues[i][0] = 1;
+            m_chebValues[i][1] = point[i];
+            m_chebDerivatives[i][0] = 0;
+            m_chebDerivatives[i][1] = 1;
+            for(size_t j = 2; j < sideLength; j++) {
+                m_chebValues[i][j] = 2 * point[i] * m_chebValues[i][j-1] - m_chebValues[i][j-2];
+                m_chebDerivatives[i][j] = 2 * m_chebValues[i][j-1] + 2 * point[i] * m_chebDerivatives[i][j-1] - m_chebDerivatives[i][j-2];
+            }
+        }
+        m_values.setZero();
+        m_jacobian.setZero();
+        for(size_t funcNum = 0; funcNum < m_rank; funcNum++) {
+            for(size_t term = 0; term < m_coefficients[funcNum].size(); term++) {
+                const size_t* termExponents = &m_exponents[funcNum][term * m_rank];
+                double termValue = m_coefficients[funcNum][term];
+                for(size_t i = 0; i < m_rank; i++) {
+                    termValue *= m_chebValues[i][termExponents[i]];
+                }
+                m_values(funcNum) += termValue;
+                for(size_t j = 0; j < m_rank; j++) {
+                    double derivative = m_coefficients[funcNum][term];
+                    for(size_t i = 0; i < m_rank; i++) {
+                        derivative *= i == j ? m_chebDerivatives[i][termExponents[i]] : m_chebValues[i][termExponents[i]];
+                    }
+                    m_jacobian(funcNum, j) += derivative;
+                }
+            }
+        }
+        m_step = m_jacobian.partialPivLu().solve(m_values);
+        if(!m_step.allFinite()) {
+            return false;
+        }
+        double stepSize = 0;
+        for(size_t i = 0; i < m_rank; i++) {
+            point[i] -= m_step(i);
+            stepSize = std::max(stepSize, std::abs(m_step(i)));
+            if(std::abs(point[i] - _point[i]) > s_minRootDistance) {
+                return false;
+            }
+        }
+        if(stepSize <= 8 * std::numeric_limits<double>::epsilon()) {
+            break;
+        }
+    }
+    _point = point;
+    return true;
+}
+
+#endif /* SpectralSolverND_ipp */
@@ -14,9 +14,15 @@
 #include "Utilities/utilities.hpp"
 #include "Utilities/MultiPool.hpp"
 #include "Utilities/ConcurrentStack.hpp"
+#include "Utilities/RoundedInterval.hpp"
 #include "IntervalChecking/IntervalChecker.hpp"
+#include "IntervalChecking/SingularityChecker.hpp"
+#include "IntervalChecking/ClusterChecker.hpp"
 #include "Approximation/ChebyshevApproximator.hpp"
 #include "Solvers/LinearSolver.hpp"
+#include "Solvers/NewtonSolver.hpp"
+#include "Solvers/KrawczykSolver.hpp"
+#include "Solvers/SpectralSolver.hpp"
 
 template <int Rank>
 class SubdivisionSolver
@@ -29,6 +35,8 @@ public:
     
 private:
     void subdivide(SolveParameters* _parameters, size_t _numGoodApproximations);
+    bool excludedByIntervalArithmetic(Interval& _interval);
+    bool spectralSolve(Interval& _interval);
         
 private:
     size_t                                                  m_threadNum;
@@ -42,11 +50,19 @@ private:
     std::vector<ChebyshevApproximation<Rank> >                 m_chebyshevApproximations;
     std::vector<std::unique_ptr<ChebyshevApproximator<Rank> > >m_chebyshevApproximators;
     IntervalChecker<Rank>                                      m_intervalChecker;
+    SingularityChecker                                         m_singularityChecker;
+    ClusterChecker<Rank>                                       m_clusterChecker;
     LinearSolver<Rank>                                         m_linearSolver;
+    NewtonSolver<Rank>                                         m_newtonSolver;
+    KrawczykSolver<Rank>                                       m_krawczykSolver;
+    SpectralSolver<Rank>                                       m_spectralSolver;
     std::vector<double>                                     m_minApproxTols;
+    std::vector<size_t>                                     m_trimmedDegrees;
+    std::vector<RoundedInterval>                            m_box;
     
     static size_t m_subdivisionSolverTimerIndex1;
     static size_t m_subdivisionSolverTimerIndex2;
+    static size_t m_timerIntervalArithmeticIndex;
     Timer& m_timer = Timer::getInstance();
 };
 
@@ -56,6 +72,9 @@ size_t SubdivisionSolver<Rank>::m_subdivisionSolverTimerIndex1 = -1;
 template<int Rank>
 size_t SubdivisionSolver<Rank>::m_subdivisionSolverTimerIndex2 = -1;
 
+template<int Rank>
+size_t SubdivisionSolver<Rank>::m_timerIntervalArithmeticIndex = -1;
+
 
 #include "SubdivisionSolverND.ipp"
 
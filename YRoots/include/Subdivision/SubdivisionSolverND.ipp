@@ -20,9 +20,18 @@ m_subdivisionParameters(_parameters),
 m_intervalTracker(_intervalTracker),
 m_rootTracker(_rootTracker),
 m_intervalChecker(m_rank, m_intervalTracker, m_threadNum, m_intervalsToRun, m_solveParametersPool),
+m_singularityChecker(m_rank, m_functions, m_intervalTracker, m_threadNum, m_intervalsToRun, m_solveParametersPool),
+m_clusterChecker(m_threadNum, m_rank, m_intervalTracker, m_rootTracker),
 m_linearSolver(m_threadNum, m_rank, m_intervalTracker, m_rootTracker),
-m_minApproxTols(m_functions.size(), 0.0)
+m_newtonSolver(m_threadNum, m_rank, m_functions, m_intervalTracker, m_rootTracker),
+m_krawczykSolver(m_threadNum, m_rank, m_intervalTracker, m_rootTracker, m_intervalsToRun, m_solveParametersPool, m_newtonSolver),
+m_spectralSolver(m_threadNum, m_rank, m_intervalTracker, m_rootTracker),
+m_minApproxTols(m_functions.size(), 0.0),
+m_trimmedDegrees(m_functions.size(), 0),
+m_box(m_rank)
 {
+    m_timer.registerTimer(m_timerIntervalArithmeticIndex, "Interval Arithmetic Check");
+
     for(size_t i = 0; i < m_functions.size(); i++) {
         //Create the Chebyshev Approximations
         m_chebyshevApproximations.emplace_back(m_rank);
@@ -30,7 +39,7 @@ m_minApproxTols(m_functions.size(), 0.0)
 
     for(size_t i = 0; i < m_functions.size(); i++) {
         //Create the Chebyshev Approximators
-        m_chebyshevApproximators.emplace_back(::make_unique<ChebyshevApproximator<Rank>>(m_rank, m_subdivisionParameters.approximationDegree, m_chebyshevApproximations[i]));
+        m_chebyshevApproximators.emplace_back(::make_unique<ChebyshevApproximator<Rank>>(m_rank, m_subdivisionParameters.approximationDegree, m_chebyshevApproximations[i], m_threadNum, m_subdivisionParameters.useChebyshevModels, m_subdivisionParameters.check_eval_error));
     }
 }
 
@@ -42,9 +51,65 @@ SubdivisionSolver<Rank>::~SubdivisionSolver(){
 template <int Rank>
 void SubdivisionSolver<Rank>::subdivide(SolveParameters* _parameters, size_t _numGoodApproximations)
 {
+    //Stop subdividing around a multiple root or a tight cluster of roots.
+    if(m_clusterChecker.runClusterCheck(m_chebyshevApproximations, _parameters, _numGoodApproximations)) {
+        return;
+    }
+    //If all the approximations are good, the Krawczyk operator may find the root or throw out the interval without subdividing.
+    if(_numGoodApproximations == m_rank && m_krawczykSolver.solve(m_chebyshevApproximations, _parameters, m_minApproxTols, m_subdivisionParameters.targetTol)) {
+        return;
+    }
+    //If the approximations can only have one common zero, look for it with Newton's method instead of subdividing.
+    if(_numGoodApproximations == m_rank && m_intervalChecker.runMonotonicityCheck(m_chebyshevApproximations) && m_newtonSolver.polish(_parameters->interval, _parameters->interval)) {
+        return;
+    }
     m_intervalChecker.runSubintervalChecks(m_chebyshevApproximations, _parameters, _numGoodApproximations);
 }
 
+template <int Rank>
+bool SubdivisionSolver<Rank>::excludedByIntervalArithmetic(Interval& _interval)
+{
+    //Evaluate each function on the whole box with interval arithmetic. If any of the enclosures doesn't contain 0
+    //that function has no zeros in the box, so it can be thrown out without approximating anything.
+    m_timer.startTimer(m_timerIntervalArithmeticIndex);
+    for(size_t dim = 0; dim < m_rank; dim++) {
+        m_box[dim] = RoundedInterval(_interval.lowerBounds[dim], _interval.upperBounds[dim]);
+    }
+    for(size_t funcNum = 0; funcNum < m_functions.size(); funcNum++) {
+        if(!m_functions[funcNum]->evaluate<RoundedInterval>(m_box, m_threadNum).containsZero()) {
+            m_timer.stopTimer(m_timerIntervalArithmeticIndex);
+            return true;
+        }
+    }
+    m_timer.stopTimer(m_timerIntervalArithmeticIndex);
+    return false;
+}
+
+template <int Rank>
+bool SubdivisionSolver<Rank>::spectralSolve(Interval& _interval)
+{
+    //Only used if every approximation is good at a low degree, but they aren't all linear. This only uses the relative
+    //tolerance, as an approximation that is only good because it is below the absolute tolerance doesn't say where it's
+    //zeros are, and a box this big isn't small enough to pin them down anyway.
+    size_t maxDegree = 0;
+    for(size_t funcNum = 0; funcNum < m_functions.size(); funcNum++) {
+        m_trimmedDegrees[funcNum] = m_chebyshevApproximations[funcNum].getTrimmedDegree(0, m_subdivisionParameters.relApproxTol);
+        maxDegree = std::max(maxDegree, m_trimmedDegrees[funcNum]);
+    }
+    if(maxDegree < 2 || maxDegree > SpectralSolver<Rank>::getMaxDegree()) {
+        return false;
+    }
+    
+    //Trim each approximation as far as it goes and get goodZerosTol
+    double goodZerosTol = 0;
+    for(size_t funcNum = 0; funcNum < m_functions.size(); funcNum++) {
+        m_chebyshevApproximations[funcNum].trimCoefficients(0, m_subdivisionParameters.relApproxTol, m_trimmedDegrees[funcNum]);
+        goodZerosTol += m_chebyshevApproximations[funcNum].getApproximationError();
+    }
+    goodZerosTol = std::max(m_subdivisionParameters.minGoodZerosTol, goodZerosTol*m_subdivisionParameters.goodZerosFactor);
+    return m_spectralSolver.solve(m_chebyshevApproximations, _interval, goodZerosTol);
+}
+
 template <int Rank>
 void SubdivisionSolver<Rank>::solve(SolveParameters* _parameters)
 {
@@ -66,16 +131,25 @@ void SubdivisionSolver<Rank>::solve(SolveParameters* _parameters)
         return;
     }
     
-    if(m_subdivisionParameters.check_eval_error) {
-        for(size_t funcNum = 0; funcNum < m_functions.size(); funcNum++) {
-            size_t numVals = power(_parameters->goodDegrees[funcNum]*2,2) - power(_parameters->goodDegrees[funcNum],2);
-            m_minApproxTols[funcNum] = numVals * m_chebyshevApproximators[funcNum]->getAbsApproxTol(m_functions[funcNum], _parameters->interval);
-        }
+    //Throw out the interval if a function can't be zero anywhere on it.
+    if(excludedByIntervalArithmetic(_parameters->interval)) {
+        m_intervalTracker.storeResult(m_threadNum, _parameters->interval, SolveMethod::IntervalArithmeticCheck, false);
+        return;
+    }
+    
+    //Throw out or split the interval if a function isn't defined everywhere on it.
+    if(m_singularityChecker.runSingularityCheck(_parameters)) {
+        return;
     }
     
     for(size_t funcNum = 0; funcNum < m_functions.size(); funcNum++) {
         //Get a chebyshev approximation
         m_chebyshevApproximators[funcNum]->approximate(m_functions[funcNum], _parameters->interval, _parameters->goodDegrees[funcNum]);
+        if(m_subdivisionParameters.check_eval_error) {
+            //The evaluation error is bounded on the grid the approximation was sampled on.
+            size_t numVals = power(_parameters->goodDegrees[funcNum]*2,2) - power(_parameters->goodDegrees[funcNum],2);
+            m_minApproxTols[funcNum] = numVals * m_chebyshevApproximators[funcNum]->getAbsApproxTol(m_functions[funcNum], _parameters->interval);
+        }
         const double absApproxTolToUse = std::max(1e5 * m_minApproxTols[funcNum], m_subdivisionParameters.absApproxTol);
         if(!m_chebyshevApproximations[funcNum].isGoodApproximation(absApproxTolToUse, m_subdivisionParameters.relApproxTol)) {
             //Increase the goodDegree by 1 up to the max.
@@ -93,6 +167,11 @@ void SubdivisionSolver<Rank>::solve(SolveParameters* _parameters)
         _parameters->goodDegrees[funcNum] = std::min(_parameters->goodDegrees[funcNum], m_chebyshevApproximations[funcNum].getGoodDegree() + 1);
     }
     
+    //Find all the roots at once if the approximations are low degree but not linear.
+    if(spectralSolve(_parameters->interval)) {
+        return;
+    }
+    
     //Trim the coeffs
     bool goodApproximations = true;
     for(size_t funcNum = 0; funcNum < m_functions.size(); funcNum++) {
@@ -122,7 +201,7 @@ void SubdivisionSolver<Rank>::solve(SolveParameters* _parameters)
         return m_linearSolver.solve(m_chebyshevApproximations, _parameters->interval, goodZerosTol);
     }
     else {
-        //TODO: Sove using spectral methods
+        //Too high degree for the spectral solver, or it failed
         return subdivide(_parameters, m_functions.size());
     }
 }
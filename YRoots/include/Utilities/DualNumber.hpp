@@ -0,0 +1,148 @@
+//
+//  DualNumber.hpp
+//  YRoots
+//
+//  Created by Erik Hales Parkinson on 10/19/26.
+//  Copyright © 2026 Erik Hales Parkinson. All rights reserved.
+//
+
+#ifndef DualNumber_h
+#define DualNumber_h
+
+#include <cmath>
+#include <iostream>
+
+//Forward mode automatic differentiation. A DualNumber is value + derivative*e with e^2 = 0, so evaluating a function
+//with DualNumbers as the input gives the function and it's directional derivative. Setting the derivative of variable
+//i to 1 and the others to 0 gives the derivative with respect to variable i.
+struct DualNumber {
+    DualNumber() : value(0), derivative(0) {}
+    DualNumber(double v) : value(v), derivative(0) {}
+    DualNumber(double v, double d) : value(v), derivative(d) {}
+
+    //For printing
+    friend std::ostream& operator<<(std::ostream& strm, const DualNumber& obj) {
+        strm << "Value: " << obj.value << ", Derivative: " << obj.derivative;
+        return strm;
+    }
+
+    //Override addition
+    DualNumber& operator+=(const DualNumber& rhs)
+    {
+        value += rhs.value;
+        derivative += rhs.derivative;
+        return *this;
+    }
+    friend DualNumber operator+(DualNumber lhs, const DualNumber& rhs)
+    {
+        lhs += rhs;
+        return lhs;
+    }
+
+    //Override subtraction
+    DualNumber& operator-=(const DualNumber& rhs)
+    {
+        value -= rhs.value;
+        derivative -= rhs.derivative;
+        return *this;
+    }
+    friend DualNumber operator-(DualNumber lhs, const DualNumber& rhs)
+    {
+        lhs -= rhs;
+        return lhs;
+    }
+    friend DualNumber operator-(const DualNumber& rhs)
+    {
+        return DualNumber(-rhs.value, -rhs.derivative);
+    }
+
+    //Override multiplication
+    DualNumber& operator*=(const DualNumber& rhs)
+    {
+        derivative = derivative * rhs.value + value * rhs.derivative;
+        value *= rhs.value;
+        return *this;
+    }
+    friend DualNumber operator*(DualNumber lhs, const DualNumber& rhs)
+    {
+        lhs *= rhs;
+        return lhs;
+    }
+
+    //Override Division
+    DualNumber& operator/=(const DualNumber& rhs)
+    {
+        value /= rhs.value;
+        derivative = (derivative - value * rhs.derivative) / rhs.value;
+        return *this;
+    }
+    friend DualNumber operator/(DualNumber lhs, const DualNumber& rhs)
+    {
+        lhs /= rhs;
+        return lhs;
+    }
+
+    double value;
+    double derivative;
+};
+
+//The chain rule, f(x + de) = f(x) + f'(x)de
+DualNumber sin(const DualNumber& x) {
+    return DualNumber(std::sin(x.value), std::cos(x.value) * x.derivative);
+}
+
+DualNumber cos(const DualNumber& x) {
+    return DualNumber(std::cos(x.value), -std::sin(x.value) * x.derivative);
+}
+
+DualNumber tan(const DualNumber& x) {
+    const double eval = std::tan(x.value);
+    return DualNumber(eval, (1 + eval * eval) * x.derivative);
+}
+
+DualNumber sinh(const DualNumber& x) {
+    return DualNumber(std::sinh(x.value), std::cosh(x.value) * x.derivative);
+}
+
+DualNumber cosh(const DualNumber& x) {
+    return DualNumber(std::cosh(x.value), std::sinh(x.value) * x.derivative);
+}
+
+DualNumber tanh(const DualNumber& x) {
+    const double eval = std::tanh(x.value);
+    return DualNumber(eval, (1 - eval * eval) * x.derivative);
+}
+
+DualNumber exp(const DualNumber& x) {
+    const double eval = std::exp(x.value);
+    return DualNumber(eval, eval * x.derivative);
+}
+
+DualNumber sqrt(const DualNumber& x) {
+    const double eval = std::sqrt(x.value);
+    return DualNumber(eval, x.derivative / (2 * eval));
+}
+
+DualNumber log(const DualNumber& x) {
+    return DualNumber(std::log(x.value), x.derivative / x.value);
+}
+
+DualNumber log2(const DualNumber& x) {
+    return DualNumber(std::log2(x.value), x.derivative / (x.value * M_LN2));
+}
+
+DualNumber log10(const DualNumber& x) {
+    return DualNumber(std::log10(x.value), x.derivative / (x.value * M_LN10));
+}
+
+DualNumber pow(const DualNumber& x, const DualNumber& y) {
+    const double eval = std::pow(x.value, y.value);
+    //Only use the log when the exponent changes, so negative bases work with constant exponents.
+    double derivative = x.derivative == 0 ? 0 : y.value * std::pow(x.value, y.value - 1) * x.derivative;
+    if(y.derivative != 0) {
+        derivative += eval * std::log(x.value) * y.derivative;
+    }
+    return DualNumber(eval, derivative);
+}
+
+#endif /* DualNumber_h */
@@ -0,0 +1,356 @@
+//
+//  RoundedInterval.hpp
+//  YRoots
+//
+//  Created by Erik Hales Parkinson on 10/19/26.
+//  Copyright © 2026 Erik Hales Parkinson. All rights reserved.
+//
+
+#ifndef RoundedInterval_h
+#define RoundedInterval_h
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <iostream>
+#include "Utilities/utilities.hpp"
+
+//Interval arithmetic with outward rounding. Evaluating a function with RoundedIntervals as the input gives an interval
+//that contains the value of the function at every point of the input box. Every operation rounds the lower bound down
+//and the upper bound up by one ulp, and the results of the math library are widened by s_libmUlps.
+//Anything that can't be bounded, like dividing by an interval containing 0, gives the entire real line.
+struct RoundedInterval {
+    RoundedInterval() : lower(0), upper(0) {}
+    RoundedInterval(double v) : lower(v), upper(v) {}
+    RoundedInterval(double l, double u) : lower(l), upper(u) {
+        //Anything that was NaN could be anything
+        if(std::isnan(lower) || std::isnan(upper)) {
+            *this = entire();
+        }
+    }
+
+    static RoundedInterval entire() {
+        return RoundedInterval(-std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity());
+    }
+
+    static double roundDown(double x) {
+        return std::isinf(x) ? x : std::nextafter(x, -std::numeric_limits<double>::infinity());
+    }
+
+    static double roundUp(double x) {
+        return std::isinf(x) ? x : std::nextafter(x, std::numeric_limits<double>::infinity());
+    }
+
+    //Widens the result of a math library call, which is within a few ulps of the true value.
+    static RoundedInterval fromLibm(double l, double u) {
+        for(size_t i = 0; i < s_libmUlps; i++) {
+            l = roundDown(l);
+            u = roundUp(u);
+        }
+        return RoundedInterval(l, u);
+    }
+
+    bool contains(double x) const {
+        return lower <= x && x <= upper;
+    }
+
+    bool containsZero() const {
+        return contains(0);
+    }
+
+    double width() const {
+        return upper - lower;
+    }
+
+    //For printing
+    friend std::ostream& operator<<(std::ostream& strm, const RoundedInterval& obj) {
+        strm << "[" << obj.lower << ", " << obj.upper << "]";
+        return strm;
+    }
+
+    //Override addition
+    RoundedInterval& operator+=(const RoundedInterval& rhs)
+    {
+        *this = RoundedInterval(roundDown(lower + rhs.lower), roundUp(upper + rhs.upper));
+        return *this;
+    }
+    friend RoundedInterval operator+(RoundedInterval lhs, const RoundedInterval& rhs)
+    {
+        lhs += rhs;
+        return lhs;
+    }
+
+    //Override subtraction
+    RoundedInterval& operator-=(const RoundedInterval& rhs)
+    {
+        *this = RoundedInterval(roundDown(lower - rhs.upper), roundUp(upper - rhs.lower));
+        return *this;
+    }
+    friend RoundedInterval operator-(RoundedInterval lhs, const RoundedInterval& rhs)
+    {
+        lhs -= rhs;
+        return lhs;
+    }
+    friend RoundedInterval operator-(const RoundedInterval& rhs)
+    {
+        return RoundedInterval(-rhs.upper, -rhs.lower);
+    }
+
+    //Override multiplication
+    RoundedInterval& operator*=(const RoundedInterval& rhs)
+    {
+        const double p1 = lower * rhs.lower;
+        const double p2 = lower * rhs.upper;
+        const double p3 = upper * rhs.lower;
+        const double p4 = upper * rhs.upper;
+        //0 * inf is NaN, and then the product could be anything.
+        if(std::isnan(p1) || std::isnan(p2) || std::isnan(p3) || std::isnan(p4)) {
+            *this = entire();
+        }
+        else {
+            *this = RoundedInterval(roundDown(std::min(std::min(p1, p2), std::min(p3, p4))), roundUp(std::max(std::max(p1, p2), std::max(p3, p4))));
+        }
+        return *this;
+    }
+    friend RoundedInterval operator*(RoundedInterval lhs, const RoundedInterval& rhs)
+    {
+        lhs *= rhs;
+        return lhs;
+    }
+
+    //Override Division
+    RoundedInterval& operator/=(const RoundedInterval& rhs)
+    {
+        if(rhs.containsZero()) {
+            *this = entire();
+            return *this;
+        }
+        const double q1 = lower / rhs.lower;
+        const double q2 = lower / rhs.upper;
+        const double q3 = upper / rhs.lower;
+        const double q4 = upper / rhs.upper;
+        if(std::isnan(q1) || std::isnan(q2) || std::isnan(q3) || std::isnan(q4)) {
+            *this = entire();
+        }
+        else {
+            *this = RoundedInterval(roundDown(std::min(std::min(q1, q2), std::min(q3, q4))), roundUp(std::max(std::max(q1, q2), std::max(q3, q4))));
+        }
+        return *this;
+    }
+    friend RoundedInterval operator/(RoundedInterval lhs, const RoundedInterval& rhs)
+    {
+        lhs /= rhs;
+        return lhs;
+    }
+
+    double lower;
+    double upper;
+
+    //How many ulps the results of the math library are widened by.
+    static constexpr size_t s_libmUlps = 2;
+    //Past this the periodic functions aren't accurate enough to find the extrema.
+    static constexpr double s_maxPeriodicInput = 1e15;
+};
+
+//True if _point + k*_period is in [_lower, _upper] for some integer k. Errs on the side of true when it's close.
+bool containsPeriodicPoint(double _lower, double _upper, double _point, double _period) {
+    const double slack = 4 * std::numeric_limits<double>::epsilon() * std::max(1.0, std::max(std::abs(_lower), std::abs(_upper)));
+    const double k = std::ceil((_lower - _point) / _period);
+    return _point + (k - 1) * _period >= _lower - slack || _point + k * _period <= _upper + slack;
+}
+
+//Evaluations of functions on intervals. Monotone functions are evaluated at the endpoints, and the others check if
+//the interval contains an extrema. Each is the tightest interval the math library allows.
+RoundedInterval sin(const RoundedInterval& x) {
+    if(x.width() >= 2 * M_PI || std::max(std::abs(x.lower), std::abs(x.upper)) > RoundedInterval::s_maxPeriodicInput) {
+        return RoundedInterval(-1, 1);
+    }
+    const double sinLower = std::sin(x.lower);
+    const double sinUpper = std::sin(x.upper);
+    RoundedInterval result = RoundedInterval::fromLibm(std::min(sinLower, sinUpper), std::max(sinLower, sinUpper));
+    if(containsPeriodicPoint(x.lower, x.upper, M_PI / 2, 2 * M_PI)) {
+        result.upper = 1;
+    }
+    if(containsPeriodicPoint(x.lower, x.upper, -M_PI / 2, 2 * M_PI)) {
+        result.lower = -1;
+    }
+    result.lower = std::max(result.lower, -1.0);
+    result.upper = std::min(result.upper, 1.0);
+    return result;
+}
+
+RoundedInterval cos(const RoundedInterval& x) {
+    if(x.width() >= 2 * M_PI || std::max(std::abs(x.lower), std::abs(x.upper)) > RoundedInterval::s_maxPeriodicInput) {
+        return RoundedInterval(-1, 1);
+    }
+    const double cosLower = std::cos(x.lower);
+    const double cosUpper = std::cos(x.upper);
+    RoundedInterval result = RoundedInterval::fromLibm(std::min(cosLower, cosUpper), std::max(cosLower, cosUpper));
+    if(containsPeriodicPoint(x.lower, x.upper, 0, 2 * M_PI)) {
+        result.upper = 1;
+    }
+    if(containsPeriodicPoint(x.lower, x.upper, M_PI, 2 * M_PI)) {
+        result.lower = -1;
+    }
+    result.lower = std::max(result.lower, -1.0);
+    result.upper = std::min(result.upper, 1.0);
+    return result;
+}
+
+RoundedInterval tan(const RoundedInterval& x) {
+    //Tan is increasing between the poles
+    if(x.width() >= M_PI || std::max(std::abs(x.lower), std::abs(x.upper)) > RoundedInterval::s_maxPeriodicInput || containsPeriodicPoint(x.lower, x.upper, M_PI / 2, M_PI)) {
+        return RoundedInterval::entire();
+    }
+    return RoundedInterval::fromLibm(std::tan(x.lower), std::tan(x.upper));
+}
+
+RoundedInterval sinh(const RoundedInterval& x) {
+    return RoundedInterval::fromLibm(std::sinh(x.lower), std::sinh(x.upper));
+}
+
+RoundedInterval cosh(const RoundedInterval& x) {
+    //Cosh has it's min of 1 at 0
+    if(x.containsZero()) {
+        RoundedInterval result = RoundedInterval::fromLibm(1, std::max(std::cosh(x.lower), std::cosh(x.upper)));
+        result.lower = 1;
+        return result;
+    }
+    const double coshLower = std::cosh(x.lower);
+    const double coshUpper = std::cosh(x.upper);
+    RoundedInterval result = RoundedInterval::fromLibm(std::min(coshLower, coshUpper), std::max(coshLower, coshUpper));
+    result.lower = std::max(result.lower, 1.0);
+    return result;
+}
+
+RoundedInterval tanh(const RoundedInterval& x) {
+    RoundedInterval result = RoundedInterval::fromLibm(std::tanh(x.lower), std::tanh(x.upper));
+    result.lower = std::max(result.lower, -1.0);
+    result.upper = std::min(result.upper, 1.0);
+    return result;
+}
+
+RoundedInterval exp(const RoundedInterval& x) {
+    RoundedInterval result = RoundedInterval::fromLibm(std::exp(x.lower), std::exp(x.upper));
+    result.lower = std::max(result.lower, 0.0);
+    return result;
+}
+
+//The logs and sqrt only bound the part of the interval in their domain. If none of it is the function can't be bounded.
+RoundedInterval sqrt(const RoundedInterval& x) {
+    if(x.upper < 0) {
+        return RoundedInterval::entire();
+    }
+    RoundedInterval result = RoundedInterval::fromLibm(std::sqrt(std::max(x.lower, 0.0)), std::sqrt(x.upper));
+    result.lower = std::max(result.lower, 0.0);
+    return result;
+}
+
+RoundedInterval log(const RoundedInterval& x) {
+    if(x.upper <= 0) {
+        return RoundedInterval::entire();
+    }
+    return RoundedInterval::fromLibm(x.lower <= 0 ? -std::numeric_limits<double>::infinity() : std::log(x.lower), std::log(x.upper));
+}
+
+RoundedInterval log2(const RoundedInterval& x) {
+    if(x.upper <= 0) {
+        return RoundedInterval::entire();
+    }
+    return RoundedInterval::fromLibm(x.lower <= 0 ? -std::numeric_limits<double>::infinity() : std::log2(x.lower), std::log2(x.upper));
+}
+
+RoundedInterval log10(const RoundedInterval& x) {
+    if(x.upper <= 0) {
+        return RoundedInterval::entire();
+    }
+    return RoundedInterval::fromLibm(x.lower <= 0 ? -std::numeric_limits<double>::infinity() : std::log10(x.lower), std::log10(x.upper));
+}
+
+//Integer powers. Odd powers are increasing, and even powers decrease then increase with a min of 0 at 0.
+RoundedInterval power(const RoundedInterval& base, size_t exponent) {
+    if(exponent == 0) {
+        return RoundedInterval(1);
+    }
+    if(exponent == 1) {
+        return base;
+    }
+    if((exponent&1) == 1) {
+        return RoundedInterval::fromLibm(std::pow(base.lower, exponent), std::pow(base.upper, exponent));
+    }
+    const double powLower = std::pow(base.lower, exponent);
+    const double powUpper = std::pow(base.upper, exponent);
+    RoundedInterval result = RoundedInterval::fromLibm(std::min(powLower, powUpper), std::max(powLower, powUpper));
+    if(base.containsZero()) {
+        result.lower = 0;
+    }
+    result.lower = std::max(result.lower, 0.0);
+    return result;
+}
+
+RoundedInterval pow(const RoundedInterval& x, const RoundedInterval& y) {
+    //Integer exponents can use any base
+    if(y.lower == y.upper && y.lower == std::floor(y.lower) && std::abs(y.lower) < 1e9) {
+        const RoundedInterval result = power(x, static_cast<size_t>(std::abs(y.lower)));
+        return y.lower < 0 ? RoundedInterval(1) / result : result;
+    }
+    //Other exponents need a positive base, x^y = exp(y*log(x)).
+    if(x.upper <= 0) {
+        return RoundedInterval::entire();
+    }
+    if(x.lower <= 0) {
+        //Only the positive part of x is in the domain. With a positive exponent 0^y = 0 is the min.
+        if(y.lower > 0) {
+            const RoundedInterval positivePart(std::numeric_limits<double>::min(), x.upper);
+            RoundedInterval result = exp(y * log(positivePart));
+            result.lower = 0;
+            return result;
+        }
+        return RoundedInterval::entire();
+    }
+    return exp(y * log(x));
+}
+
+//Chebyshev polynomials. T_n(cos(t)) = cos(nt) on [-1,1], and outside of it T_n is monotone.
+RoundedInterval chebPower(const RoundedInterval& base, size_t exponent) {
+    if(exponent == 0) {
+        return RoundedInterval(1);
+    }
+    if(exponent == 1) {
+        return base;
+    }
+    bool isEmpty = true;
+    RoundedInterval result;
+    auto addPart = [&](const RoundedInterval& part) {
+        if(isEmpty) {
+            result = part;
+            isEmpty = false;
+        }
+        else {
+            result.lower = std::min(result.lower, part.lower);
+            result.upper = std::max(result.upper, part.upper);
+        }
+    };
+    //The monotone parts, bounded by the endpoints. The recurrence is accurate to a few ulps per step.
+    auto monotonePart = [&](double a, double b) {
+        const double valA = chebPower(a, exponent);
+        const double valB = chebPower(b, exponent);
+        const double slack = 4 * (exponent + 1) * std::numeric_limits<double>::epsilon() * std::max(std::abs(valA), std::abs(valB));
+        return RoundedInterval(RoundedInterval::roundDown(std::min(valA, valB) - slack), RoundedInterval::roundUp(std::max(valA, valB) + slack));
+    };
+    if(base.lower < -1) {
+        addPart(monotonePart(base.lower, std::min(base.upper, -1.0)));
+    }
+    if(base.upper > 1) {
+        addPart(monotonePart(std::max(base.lower, 1.0), base.upper));
+    }
+    if(base.upper >= -1 && base.lower <= 1) {
+        //acos is decreasing, widen it to account for the rounding
+        const double thetaLower = RoundedInterval::roundDown(RoundedInterval::roundDown(std::acos(std::min(base.upper, 1.0))));
+        const double thetaUpper = RoundedInterval::roundUp(RoundedInterval::roundUp(std::acos(std::max(base.lower, -1.0))));
+        addPart(cos(RoundedInterval(static_cast<double>(exponent)) * RoundedInterval(std::max(thetaLower, 0.0), thetaUpper)));
+    }
+    return result;
+}
+
+#endif /* RoundedInterval_h */
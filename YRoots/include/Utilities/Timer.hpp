@@ -120,6 +120,16 @@ public:
 #endif
     }
     
+    //Memory use isn't timed, it's just a value to show with the timing results.
+    inline void recordMemory(const std::string& _name, size_t _bytes) {
+#ifdef USE_TIMING
+        if(!Timer::isEnabled()) {
+            return;
+        }
+        m_memoryDetails.push_back(std::make_pair(_name, _bytes));
+#endif
+    }
+    
     inline static void getTimingResultsAndClear() {
 #ifdef USE_TIMING
         //Only print the results if timing is enabled
@@ -167,17 +177,26 @@ private:
             stream<<m_timingDetails[i]<<"\n";
         }
         stream<<"\n";
+        if(m_memoryDetails.size() > 0) {
+            stream<<"MEMORY RESULTS\n";
+            for(size_t i = 0; i < m_memoryDetails.size(); i++) {
+                stream<<m_memoryDetails[i].first<<":\t"<<formatMemoryPretty(m_memoryDetails[i].second)<<"\n";
+            }
+            stream<<"\n";
+        }
     }
     
     void clearClaims() {
         for(size_t i = 0; i < m_timingDetails.size(); i++) {
             m_timingDetails[i].clearClaim();
         }
+        m_memoryDetails.clear();
     }
     
     static size_t                   m_index;
     static bool                     m_enabled;
     std::vector<TimingDetails>      m_timingDetails;
+    std::vector<std::pair<std::string, size_t> > m_memoryDetails;
 };
 bool Timer::m_enabled = false;
 size_t Timer::m_index = 0;
@@ -17,6 +17,7 @@
 #include <iostream>
 #include <cmath>
 #include <stddef.h>
+#include <sys/resource.h>
 #include "Eigen/Core"
 #include "Utilities/macros.hpp"
 
@@ -46,6 +47,38 @@ std::string formatTimePretty(double nanoseconds) {
     }
 }
 
+std::string formatMemoryPretty(size_t bytes) {
+    static constexpr double kilobyte = 1024;
+    static constexpr double megabyte = kilobyte*kilobyte;
+    static constexpr double gigabyte = megabyte*kilobyte;
+
+    if(bytes < kilobyte) {
+        return std::to_string(bytes) + "B";
+    }
+    else if(bytes < megabyte) {
+        return std::to_string(bytes/kilobyte) + "KB";
+    }
+    else if(bytes < gigabyte) {
+        return std::to_string(bytes/megabyte) + "MB";
+    }
+    else {
+        return std::to_string(bytes/gigabyte) + "GB";
+    }
+}
+
+//The most memory the process has used so far, in bytes.
+size_t getPeakMemoryUsage() {
+    struct rusage usage;
+    if(getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#ifdef __APPLE__
+    return static_cast<size_t>(usage.ru_maxrss); //Bytes on macOS
+#else
+    return static_cast<size_t>(usage.ru_maxrss) * 1024; //Kilobytes on Linux
+#endif
+}
+
 void printMatrix(const Eigen::MatrixXd& matrix) {
     for(size_t i = 0; i < static_cast<size_t>(matrix.rows()); i++) {
         for(size_t j = 0; j < static_cast<size_t>(matrix.cols()); j++) {
@@ -193,6 +226,93 @@ T chebPower(T base, size_t exponent) {
     }
 }
 
+//Computes _coeff * T_exponent(_bases[i]) for the first _numPoints points.
+//Same identities as chebPower, but the recurrence is run across a block of points at a time so the inner loops vectorize.
+void chebPowerGrid(const double* _bases, double* _results, size_t _numPoints, size_t _exponent, double _coeff) {
+    if(_exponent == 0) {
+        std::fill(_results, _results + _numPoints, _coeff);
+        return;
+    }
+    if(_exponent == 1) {
+        for(size_t i = 0; i < _numPoints; i++) {
+            _results[i] = _coeff * _bases[i];
+        }
+        return;
+    }
+
+    const bool isEven = (_exponent&1) == 0;
+    const size_t toCompute = isEven ? _exponent / 2 - 1 : _exponent / 2;
+
+    constexpr size_t blockSize = 64;
+    double temp0[blockSize];
+    double temp1[blockSize];
+    for(size_t blockStart = 0; blockStart < _numPoints; blockStart += blockSize) {
+        const size_t blockLength = std::min(blockSize, _numPoints - blockStart);
+        const double* base = _bases + blockStart;
+
+        //temp1 is T_(n+1) and temp0 is T_n
+        for(size_t i = 0; i < blockLength; i++) {
+            temp0[i] = 1;
+            temp1[i] = base[i];
+        }
+        for(size_t step = 0; step < toCompute; step++) {
+            for(size_t i = 0; i < blockLength; i++) {
+                const double temp = temp1[i];
+                temp1[i] = 2 * base[i] * temp1[i] - temp0[i];
+                temp0[i] = temp;
+            }
+        }
+
+        double* result = _results + blockStart;
+        if(isEven) {
+            for(size_t i = 0; i < blockLength; i++) {
+                result[i] = _coeff * (2 * temp1[i] * temp1[i] - 1);
+            }
+        }
+        else {
+            for(size_t i = 0; i < blockLength; i++) {
+                result[i] = _coeff * (2 * temp1[i] * temp0[i] - base[i]);
+            }
+        }
+    }
+}
+
+//Fills the column major (_numPoints x (_maxExponent + 1)) table whose column k is x^k at every point.
+void powerBasisTable(const std::vector<double>& _points, size_t _maxExponent, std::vector<double>& _table) {
+    const size_t numPoints = _points.size();
+    _table.resize(numPoints * (_maxExponent + 1));
+    double* prev = _table.data();
+    std::fill(prev, prev + numPoints, 1.0);
+    for(size_t k = 1; k <= _maxExponent; k++) {
+        double* curr = prev + numPoints;
+        for(size_t i = 0; i < numPoints; i++) {
+            curr[i] = _points[i] * prev[i];
+        }
+        prev = curr;
+    }
+}
+
+//Fills the column major (_numPoints x (_maxExponent + 1)) table whose column k is T_k at every point.
+void chebyshevBasisTable(const std::vector<double>& _points, size_t _maxExponent, std::vector<double>& _table) {
+    const size_t numPoints = _points.size();
+    _table.resize(numPoints * (_maxExponent + 1));
+    double* prev = _table.data();
+    std::fill(prev, prev + numPoints, 1.0);
+    if(_maxExponent == 0) {
+        return;
+    }
+    double* curr = prev + numPoints;
+    std::copy(_points.begin(), _points.end(), curr);
+    for(size_t k = 2; k <= _maxExponent; k++) {
+        double* next = curr + numPoints;
+        for(size_t i = 0; i < numPoints; i++) {
+            next[i] = 2 * _points[i] * curr[i] - prev[i];
+        }
+        prev = curr;
+        curr = next;
+    }
+}
+
 template <int B, int E>
 struct PowerStruct {
     enum { value = B * PowerStruct<B, E-1>::value };
@@ -225,7 +345,12 @@ enum SolveMethod {
     BoundingInterval = 2,
     LinearSolve = 3,
     SpectralSolve = 4,
-    TooDeep = 5
+    TooDeep = 5,
+    IntervalArithmeticCheck = 6,
+    SingularityCheck = 7,
+    KrawczykSolve = 8,
+    NewtonPolish = 9,
+    ClusterCheck = 10
 };
 
 struct Interval {
@@ -296,6 +421,8 @@ struct SubdivisionParameters {
     size_t approximationDegree = 10; //TODO: Set a default of this per dimension
     size_t targetDegree = 1;
     size_t maxLevel = 50;
+    //Build the approximations from the function trees with Chebyshev models instead of sampling, when possible.
+    bool useChebyshevModels = false;
 };
 
 struct GeneralParameters {
@@ -310,12 +437,14 @@ struct GeneralParameters {
 struct SolveParameters {
     Interval interval;
     size_t currentLevel;
+    size_t clusterLevels; //The number of levels in a row the interval has looked like it's around a cluster of roots.
     std::vector<size_t> goodDegrees;
     
-    SolveParameters() : currentLevel(0) {}
+    SolveParameters() : currentLevel(0), clusterLevels(0) {}
         
     inline void clear() {
         interval.clear();
+        clusterLevels = 0;
     }
 };
 